@@ -32,6 +32,7 @@ local options = {
     release = { on = false, description = "Release build type (on by default)." },
     debug = { on = false, description = "Debug build type (off by default)." },
     test = { on = false, description = "Build and run tests." },
+    bench = { on = false, description = "Build and run benchmarks with optimizations." },
     fmt = { on = false, description = "Format source files with clang-format before building." },
     clang = {
         on = false,
@@ -275,12 +276,14 @@ local compilers = {
 local yoneda = {
     src = make_path({ root_dir, "src", "yoneda_all.c" }),
     test_src = make_path({ root_dir, "tests", "test_all.c" }),
+    bench_src = make_path({ root_dir, "tests", "bench_all.c" }),
     include_dir = make_path({ root_dir, "include" }),
     dll_build_define = "YO_BUILD_DLL",
     debug_defines = { "YO_DEBUG" },
     test_defines = { "YO_DEBUG", "YO_ENABLE_ABORT_AT_MEMORY_ERROR" },
     lib = "yoneda",
     test_exe = "yoneda_tests",
+    bench_exe = "yoneda_benchmarks",
     std = "c11",
     out_dir = make_path({ ".", "build" }),
 }
@@ -416,6 +419,31 @@ local function build_yoneda_tests(tc)
     return test_exe_out
 end
 
+local function build_yoneda_benchmarks(tc)
+    log_info("Building the yoneda library benchmarks...")
+
+    local default_flags = tc.flags_common .. " " .. tc.flags_release
+    local custom_flags = concat(custom_compiler_flags)
+
+    local out_obj_flag = ""
+    if tc.cc == "cl" then
+        out_obj_flag = tc.opt_out_obj .. make_path({ yoneda.out_dir, yoneda.bench_exe .. os_ext.obj })
+    end
+
+    local bench_exe_out = make_path({ yoneda.out_dir, yoneda.bench_exe .. os_ext.exe })
+    exec(concat({
+        tc.cc,
+        tc.opt_std .. yoneda.std,
+        default_flags,
+        custom_flags,
+        tc.opt_include .. yoneda.include_dir,
+        out_obj_flag,
+        tc.opt_out_exe .. bench_exe_out,
+        yoneda.bench_src,
+    }))
+    return bench_exe_out
+end
+
 if options.fmt.on then
     format_source_files()
 end
@@ -428,5 +456,10 @@ if options.test.on then
     exec(test_exe)
 end
 
+if options.bench.on then
+    local bench_exe = build_yoneda_benchmarks(toolchain)
+    exec(bench_exe)
+end
+
 local end_time = os.time()
 log_info(string.format("Time elapsed: %.5f seconds", os.difftime(end_time, start_time)))
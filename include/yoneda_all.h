@@ -32,10 +32,25 @@
 #include <yoneda_time.h>
 #include <yoneda_vec.h>
 #include <yoneda_log.h>
+#include <yoneda_atomic.h>
 #include <yoneda_memory.h>
+#include <yoneda_pool.h>
+#include <yoneda_stack.h>
+#include <yoneda_tlsf.h>
+#include <yoneda_slab.h>
+#include <yoneda_concurrent_arena.h>
+#include <yoneda_thread.h>
+#include <yoneda_queue.h>
+#include <yoneda_map.h>
 #include <yoneda_string.h>
+#include <yoneda_hash.h>
+#include <yoneda_interner.h>
+#include <yoneda_sort.h>
+#include <yoneda_slot_map.h>
+#include <yoneda_soa.h>
 #include <yoneda_streams.h>
 #include <yoneda_bit.h>
+#include <yoneda_bitset.h>
 // clang-format on
 
 #endif  // YONEDA_ALL_H
@@ -0,0 +1,228 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Atomic operations and spin locks.
+/// File name: yoneda_atomic.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_ATOMIC_H
+#define YONEDA_ATOMIC_H
+
+#include <yoneda_core.h>
+
+#if defined(YO_COMPILER_MSVC)
+#    include <intrin.h>
+#elif defined(YO_ARCH_X64)
+#    include <immintrin.h>
+#endif
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Size of a cache line, used to keep data shared between threads from false sharing.
+#define YO_CACHE_LINE_SIZE 64
+
+// -----------------------------------------------------------------------------
+// Memory ordering.
+//
+// The values match the GCC and Clang atomic builtins, which accept the ordering directly. With
+// MSVC, all read-modify-write operations are sequentially consistent. Loads and stores are only
+// fenced from compiler reordering in x64 processors, which is sufficient there, while ARM64
+// processors use load-acquire and store-release instructions.
+// -----------------------------------------------------------------------------
+
+enum yo_MemoryOrder {
+    YO_MEMORY_ORDER_RELAXED = 0,
+    YO_MEMORY_ORDER_ACQUIRE = 2,
+    YO_MEMORY_ORDER_RELEASE = 3,
+    YO_MEMORY_ORDER_ACQ_REL = 4,
+    YO_MEMORY_ORDER_SEQ_CST = 5,
+};
+yo_type_alias(yo_MemoryOrder, enum yo_MemoryOrder);
+
+/// Hint to the processor that the thread is spinning on a value.
+yo_api yo_inline void yo_cpu_relax(void) {
+#if defined(YO_ARCH_X64)
+    _mm_pause();
+#elif defined(YO_ARCH_ARM) && defined(YO_COMPILER_MSVC)
+    __yield();
+#elif defined(YO_ARCH_ARM) && (defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+yo_api yo_inline void yo_atomic_thread_fence(yo_MemoryOrder order) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    __atomic_thread_fence(yo_cast(int, order));
+#elif defined(YO_COMPILER_MSVC)
+    yo_discard_value(order);
+    _ReadWriteBarrier();
+#    if defined(YO_ARCH_ARM)
+    __dmb(_ARM64_BARRIER_ISH);
+#    else
+    _mm_mfence();
+#    endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Atomic operations over integers and pointers.
+// -----------------------------------------------------------------------------
+
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+
+#    define yo_impl_atomic_define(Type, suffix)                                                                                             \
+        yo_api yo_inline Type yo_atomic_load_##suffix(Type const volatile* ptr, yo_MemoryOrder order) {                                     \
+            return __atomic_load_n(ptr, yo_cast(int, order));                                                                               \
+        }                                                                                                                                   \
+        yo_api yo_inline void yo_atomic_store_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                              \
+            __atomic_store_n(ptr, value, yo_cast(int, order));                                                                              \
+        }                                                                                                                                   \
+        yo_api yo_inline Type yo_atomic_exchange_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                           \
+            return __atomic_exchange_n(ptr, value, yo_cast(int, order));                                                                    \
+        }                                                                                                                                   \
+        yo_api yo_inline bool yo_atomic_compare_exchange_##suffix(Type volatile* ptr, Type* expected, Type desired, yo_MemoryOrder order) { \
+            return __atomic_compare_exchange_n(ptr, expected, desired, false, yo_cast(int, order), __ATOMIC_RELAXED);                       \
+        }
+
+#    define yo_impl_atomic_define_arithmetic(Type, suffix)                                                         \
+        yo_api yo_inline Type yo_atomic_fetch_add_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) { \
+            return __atomic_fetch_add(ptr, value, yo_cast(int, order));                                            \
+        }                                                                                                          \
+        yo_api yo_inline Type yo_atomic_fetch_sub_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) { \
+            return __atomic_fetch_sub(ptr, value, yo_cast(int, order));                                            \
+        }
+
+yo_impl_atomic_define(u32, u32)
+yo_impl_atomic_define(u64, u64)
+yo_impl_atomic_define(usize, usize)
+yo_impl_atomic_define(void*, ptr)
+yo_impl_atomic_define_arithmetic(u32, u32)
+yo_impl_atomic_define_arithmetic(u64, u64)
+yo_impl_atomic_define_arithmetic(usize, usize)
+
+#    undef yo_impl_atomic_define
+#    undef yo_impl_atomic_define_arithmetic
+
+#elif defined(YO_COMPILER_MSVC)
+
+#    if defined(YO_ARCH_X64)
+#        define yo_impl_atomic_load_acquire(Type, bits, ptr)          (*(ptr))
+#        define yo_impl_atomic_store_release(Type, bits, ptr, value)  (*(ptr) = (value))
+#    elif defined(YO_ARCH_ARM)
+#        define yo_impl_atomic_load_acquire(Type, bits, ptr)          yo_cast(Type, __ldar##bits(yo_cast(unsigned __int##bits volatile*, ptr)))
+#        define yo_impl_atomic_store_release(Type, bits, ptr, value)  __stlr##bits(yo_cast(unsigned __int##bits volatile*, ptr), yo_cast(unsigned __int##bits, value))
+#    else
+#        error "Atomic operations with MSVC are only implemented for x64 and ARM64 processors."
+#    endif
+
+#    define yo_impl_atomic_define(Type, suffix, bits, IntrinsicType, intrinsic_suffix)                                                          \
+        yo_api yo_inline Type yo_atomic_load_##suffix(Type const volatile* ptr, yo_MemoryOrder order) {                                         \
+            yo_discard_value(order);                                                                                                            \
+            Type value = yo_impl_atomic_load_acquire(Type, bits, ptr);                                                                          \
+            _ReadWriteBarrier();                                                                                                                \
+            return value;                                                                                                                       \
+        }                                                                                                                                       \
+        yo_api yo_inline void yo_atomic_store_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                                  \
+            if (order == YO_MEMORY_ORDER_SEQ_CST) {                                                                                             \
+                _InterlockedExchange##intrinsic_suffix(yo_cast(IntrinsicType volatile*, ptr), yo_cast(IntrinsicType, value));                   \
+            } else {                                                                                                                            \
+                _ReadWriteBarrier();                                                                                                            \
+                yo_impl_atomic_store_release(Type, bits, ptr, value);                                                                           \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        yo_api yo_inline Type yo_atomic_exchange_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                               \
+            yo_discard_value(order);                                                                                                            \
+            return yo_cast(Type, _InterlockedExchange##intrinsic_suffix(yo_cast(IntrinsicType volatile*, ptr), yo_cast(IntrinsicType, value))); \
+        }                                                                                                                                       \
+        yo_api yo_inline bool yo_atomic_compare_exchange_##suffix(Type volatile* ptr, Type* expected, Type desired, yo_MemoryOrder order) {     \
+            yo_discard_value(order);                                                                                                            \
+            Type previous = yo_cast(                                                                                                            \
+                Type,                                                                                                                           \
+                _InterlockedCompareExchange##intrinsic_suffix(                                                                                  \
+                    yo_cast(IntrinsicType volatile*, ptr),                                                                                      \
+                    yo_cast(IntrinsicType, desired),                                                                                            \
+                    yo_cast(IntrinsicType, *expected)));                                                                                        \
+            bool success = (previous == *expected);                                                                                             \
+            *expected    = previous;                                                                                                            \
+            return success;                                                                                                                     \
+        }
+
+#    define yo_impl_atomic_define_arithmetic(Type, suffix, IntrinsicType, intrinsic_suffix)                                                        \
+        yo_api yo_inline Type yo_atomic_fetch_add_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                                 \
+            yo_discard_value(order);                                                                                                               \
+            return yo_cast(Type, _InterlockedExchangeAdd##intrinsic_suffix(yo_cast(IntrinsicType volatile*, ptr), yo_cast(IntrinsicType, value))); \
+        }                                                                                                                                          \
+        yo_api yo_inline Type yo_atomic_fetch_sub_##suffix(Type volatile* ptr, Type value, yo_MemoryOrder order) {                                 \
+            return yo_atomic_fetch_add_##suffix(ptr, yo_cast(Type, 0) - value, order);                                                             \
+        }
+
+yo_impl_atomic_define(u32, u32, 32, long, )
+yo_impl_atomic_define(u64, u64, 64, __int64, 64)
+yo_impl_atomic_define(usize, usize, 64, __int64, 64)
+yo_impl_atomic_define(void*, ptr, 64, __int64, 64)
+yo_impl_atomic_define_arithmetic(u32, u32, long, )
+yo_impl_atomic_define_arithmetic(u64, u64, __int64, 64)
+yo_impl_atomic_define_arithmetic(usize, usize, __int64, 64)
+
+#    undef yo_impl_atomic_define
+#    undef yo_impl_atomic_define_arithmetic
+#    undef yo_impl_atomic_load_acquire
+#    undef yo_impl_atomic_store_release
+
+#endif
+
+// -----------------------------------------------------------------------------
+// Spin lock.
+//
+// Meant for critical sections that are only a handful of instructions long and are rarely
+// contended. Threads waiting on the lock spin instead of going to sleep.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_SpinLock {
+    u32 volatile locked;
+};
+yo_type_alias(yo_SpinLock, struct yo_SpinLock);
+
+yo_api yo_inline bool yo_spin_lock_try_acquire(yo_SpinLock* lock) {
+    return (yo_atomic_load_u32(&lock->locked, YO_MEMORY_ORDER_RELAXED) == 0) &&
+           (yo_atomic_exchange_u32(&lock->locked, 1, YO_MEMORY_ORDER_ACQUIRE) == 0);
+}
+
+yo_api yo_inline void yo_spin_lock_acquire(yo_SpinLock* lock) {
+    // Spin on a plain load so that the cache line isn't bounced between waiting threads.
+    while (!yo_spin_lock_try_acquire(lock)) {
+        while (yo_atomic_load_u32(&lock->locked, YO_MEMORY_ORDER_RELAXED) != 0) {
+            yo_cpu_relax();
+        }
+    }
+}
+
+yo_api yo_inline void yo_spin_lock_release(yo_SpinLock* lock) {
+    yo_atomic_store_u32(&lock->locked, 0, YO_MEMORY_ORDER_RELEASE);
+}
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_ATOMIC_H
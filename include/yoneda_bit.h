@@ -29,6 +29,10 @@
 #include <limits.h>
 #include <yoneda_core.h>
 
+#if defined(YO_COMPILER_MSVC)
+#    include <intrin.h>
+#endif
+
 #if defined(YO_LANG_CPP)
 extern "C" {
 #endif
@@ -157,6 +161,96 @@ yo_api yo_inline bool yo_i32_opposite_sign(i32 lhs, i32 rhs) {
 /// Rotate left by `n` digits.
 #define yo_int_rotl(ValType, val, n) yo_cast(ValType, (val << (n)) | (val >> (yo_value_bit_count(val) - (n))))
 
+// -----------------------------------------------------------------------------
+// Bit scanning.
+//
+// Note: The value passed to the scanning procedures should always be non-zero.
+// -----------------------------------------------------------------------------
+
+/// Index of the least significant bit set to 1.
+yo_api yo_inline u32 yo_u32_lsb_index(u32 value) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    return yo_cast(u32, __builtin_ctz(value));
+#elif defined(YO_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return yo_cast(u32, index);
+#else
+    u32 index = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+yo_api yo_inline u32 yo_u64_lsb_index(u64 value) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    return yo_cast(u32, __builtin_ctzll(value));
+#elif defined(YO_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return yo_cast(u32, index);
+#else
+    u32 index = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/// Index of the most significant bit set to 1.
+yo_api yo_inline u32 yo_u32_msb_index(u32 value) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    return 31 - yo_cast(u32, __builtin_clz(value));
+#elif defined(YO_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return yo_cast(u32, index);
+#else
+    u32 index = 0;
+    while (value >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+yo_api yo_inline u32 yo_u64_msb_index(u64 value) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    return 63 - yo_cast(u32, __builtin_clzll(value));
+#elif defined(YO_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return yo_cast(u32, index);
+#else
+    u32 index = 0;
+    while (value >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Bit counting.
+// -----------------------------------------------------------------------------
+
+/// Number of bits set to 1.
+yo_api yo_inline u32 yo_u64_popcount(u64 value) {
+#if defined(YO_COMPILER_CLANG) || defined(YO_COMPILER_GCC)
+    return yo_cast(u32, __builtin_popcountll(value));
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return yo_cast(u32, (value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
 #if defined(YO_LANG_CPP)
 }
 #endif
@@ -0,0 +1,131 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Dynamically sized bitsets.
+/// File name: yoneda_bitset.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_BITSET_H
+#define YONEDA_BITSET_H
+
+#include <yoneda_assert.h>
+#include <yoneda_bit.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Number of bits in each word of a bitset.
+#define YO_BITSET_WORD_BITS 64
+
+/// The word count of bitsets is a multiple of this value, so that bulk operations work on whole
+/// SIMD lanes without handling a remainder.
+#define YO_BITSET_WORD_GRANULARITY 4
+
+// -----------------------------------------------------------------------------
+// Bitset.
+//
+// Fixed-size set of bits stored in 64-bit words allocated from an arena. Bulk boolean operations
+// and population counts work on whole vectors of words, using AVX2, SSE2, or NEON when available.
+//
+// Bits past the bit count of the bitset are always zero.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_Bitset {
+    u64*  words;
+    usize word_count;
+    usize bit_count;
+};
+yo_type_alias(yo_Bitset, struct yo_Bitset);
+
+/// Make a bitset with all bits cleared.
+yo_api yo_Bitset yo_make_bitset(yo_Arena* arena, usize bit_count);
+
+/// Get the value of a bit.
+yo_api yo_inline bool yo_bitset_test(yo_Bitset const* bitset, usize idx) {
+    yo_assert_fmt(idx < bitset->bit_count, "Bit index %zu out of bounds (%zu bits).", idx, bitset->bit_count);
+    return ((bitset->words[idx / YO_BITSET_WORD_BITS] >> (idx % YO_BITSET_WORD_BITS)) & 1) != 0;
+}
+
+/// Set a bit to 1.
+yo_api yo_inline void yo_bitset_set(yo_Bitset* bitset, usize idx) {
+    yo_assert_fmt(idx < bitset->bit_count, "Bit index %zu out of bounds (%zu bits).", idx, bitset->bit_count);
+    bitset->words[idx / YO_BITSET_WORD_BITS] |= 1ULL << (idx % YO_BITSET_WORD_BITS);
+}
+
+/// Set a bit to 0.
+yo_api yo_inline void yo_bitset_clear(yo_Bitset* bitset, usize idx) {
+    yo_assert_fmt(idx < bitset->bit_count, "Bit index %zu out of bounds (%zu bits).", idx, bitset->bit_count);
+    bitset->words[idx / YO_BITSET_WORD_BITS] &= ~(1ULL << (idx % YO_BITSET_WORD_BITS));
+}
+
+/// Set all bits to 1.
+yo_api void yo_bitset_set_all(yo_Bitset* bitset);
+
+/// Set all bits to 0.
+yo_api void yo_bitset_clear_all(yo_Bitset* bitset);
+
+// Bulk boolean operations, storing the result in `dst`. Both bitsets should have the same number
+// of bits.
+
+/// Compute `dst & src`.
+yo_api void yo_bitset_and(yo_Bitset* dst, yo_Bitset const* src);
+
+/// Compute `dst | src`.
+yo_api void yo_bitset_or(yo_Bitset* dst, yo_Bitset const* src);
+
+/// Compute `dst ^ src`.
+yo_api void yo_bitset_xor(yo_Bitset* dst, yo_Bitset const* src);
+
+/// Compute `dst & ~src`, clearing the bits of `dst` that are set in `src`.
+yo_api void yo_bitset_and_not(yo_Bitset* dst, yo_Bitset const* src);
+
+/// Get the number of bits set to 1.
+yo_api usize yo_bitset_count(yo_Bitset const* bitset);
+
+/// Get the number of bits set to 1 whose index is less than `idx`.
+///
+/// Parameters:
+///     * idx: Index not greater than the bit count.
+yo_api usize yo_bitset_rank(yo_Bitset const* bitset, usize idx);
+
+/// Find the first bit set to 1 whose index is at least `idx`.
+///
+/// Return: The index of the bit, or the bit count of the bitset if there's none.
+yo_api usize yo_bitset_find_next_set(yo_Bitset const* bitset, usize idx);
+
+/// Find the first bit set to 0 whose index is at least `idx`.
+///
+/// Return: The index of the bit, or the bit count of the bitset if there's none.
+yo_api usize yo_bitset_find_next_unset(yo_Bitset const* bitset, usize idx);
+
+/// Iterate over the indices of the bits set to 1, in increasing order.
+#define yo_bitset_for_each_set(idx, bitset)                                         \
+    for (usize idx = yo_bitset_find_next_set(bitset, 0); idx < (bitset)->bit_count; \
+         idx = yo_bitset_find_next_set(bitset, idx + 1))
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_BITSET_H
@@ -0,0 +1,112 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Lock-free bump arena shared between threads.
+/// File name: yoneda_concurrent_arena.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_CONCURRENT_ARENA_H
+#define YONEDA_CONCURRENT_ARENA_H
+
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Number of concurrent arenas for which each thread keeps a reservation chunk.
+#define YO_CONCURRENT_ARENA_THREAD_CHUNK_COUNT 4
+
+// -----------------------------------------------------------------------------
+// Concurrent arena.
+// -----------------------------------------------------------------------------
+
+/// Arena allocator that can be shared by multiple threads without locking.
+///
+/// Each thread reserves chunks of the arena memory with an atomic fetch-add on the shared offset,
+/// and serves allocations from its current chunk without any synchronization. Allocations larger
+/// than a fraction of the chunk size are directly reserved from the shared offset.
+///
+/// Resetting the arena and restoring checkpoints aren't thread-safe: they should only happen at
+/// points where no other thread allocates from the arena, such as before forking or after joining
+/// a parallel phase. Each of these operations advances the generation of the arena, which
+/// invalidates the chunks held by all threads, so that a checkpoint taken before a parallel phase
+/// releases exactly the memory allocated by all threads during the phase when restored.
+struct yo_api yo_ConcurrentArena {
+    /// Offset of the memory not yet reserved by any thread. Kept in its own cache line, since it
+    /// is the only field written by concurrent allocations.
+    yo_align_as(YO_CACHE_LINE_SIZE) usize volatile offset;
+
+    /// Fields read by concurrent allocations, starting the next cache line.
+    yo_align_as(YO_CACHE_LINE_SIZE) u8* buf;
+    usize                               capacity;
+    /// Size of the chunks reserved by each thread.
+    usize                               chunk_size;
+    /// Offset past which the memory was never handed out, and thus is still zeroed.
+    usize                               dirty_offset;
+    /// Generation of the arena, changed whenever the thread chunks have to be invalidated.
+    u64 volatile                        generation;
+};
+yo_type_alias(yo_ConcurrentArena, struct yo_ConcurrentArena);
+
+/// Saved state of a concurrent arena.
+struct yo_api yo_ConcurrentArenaCheckpoint {
+    yo_ConcurrentArena* arena;
+    usize               saved_offset;
+};
+yo_type_alias(yo_ConcurrentArenaCheckpoint, struct yo_ConcurrentArenaCheckpoint);
+
+/// Make a concurrent arena that owns its memory.
+///
+/// Parameters:
+///     * capacity: The total capacity of the arena.
+///     * chunk_size: The size of the chunks reserved by each thread at once.
+yo_api yo_ConcurrentArena yo_make_concurrent_arena(usize capacity, usize chunk_size);
+
+/// Release the memory of the arena. No thread may be using the arena.
+yo_api void yo_destroy_concurrent_arena(yo_ConcurrentArena* arena);
+
+/// Allocate a zeroed block of memory from the arena. Can be called concurrently by multiple threads.
+yo_api u8* yo_concurrent_arena_alloc_align(yo_ConcurrentArena* arena, usize size_bytes, u32 alignment);
+
+/// Free all memory of the arena. No thread may be allocating from the arena.
+yo_api void yo_concurrent_arena_reset(yo_ConcurrentArena* arena);
+
+/// Save the state of the arena. No thread may be allocating from the arena.
+yo_api yo_ConcurrentArenaCheckpoint yo_make_concurrent_arena_checkpoint(yo_ConcurrentArena* arena);
+
+/// Free all memory allocated since the checkpoint was made. No thread may be allocating from the
+/// arena.
+yo_api void yo_concurrent_arena_checkpoint_restore(yo_ConcurrentArenaCheckpoint checkpoint);
+
+/// Get the number of bytes reserved by all threads, including the unused part of their chunks.
+yo_api usize yo_concurrent_arena_reserved_bytes(yo_ConcurrentArena const* arena);
+
+#define yo_concurrent_arena_alloc(arena, ValueType, count) \
+    yo_cast(ValueType*, yo_concurrent_arena_alloc_align(arena, yo_size_of(ValueType) * (count), yo_cast(u32, yo_align_of(ValueType))))
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_CONCURRENT_ARENA_H
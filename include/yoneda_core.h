@@ -263,7 +263,7 @@ extern "C" {
 /// Processor architecture.
 #if defined(__x86_64__) || defined(_M_X64) || defined(__amd64__)
 #    define YO_ARCH_X64
-#elif defined(__arm__) || defined(_ARM_) || defined(_ARM_ARCH)
+#elif defined(__arm__) || defined(_ARM_) || defined(_ARM_ARCH) || defined(__aarch64__) || defined(_M_ARM64)
 #    define YO_ARCH_ARM
 #endif
 
@@ -344,6 +344,15 @@ extern "C" {
 #define yo_internal static
 #define yo_global   static
 
+/// Storage with a distinct instance for each thread.
+#if defined(YO_LANG_CPP)
+#    define yo_thread_local thread_local
+#elif defined(YO_COMPILER_MSVC)
+#    define yo_thread_local __declspec(thread)
+#else
+#    define yo_thread_local _Thread_local
+#endif
+
 /// Hints for pointer aliasing rules.
 #if defined(YO_COMPILER_MSVC)
 #    define yo_no_alias __restrict
@@ -0,0 +1,132 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Fast non-cryptographic hash functions.
+/// File name: yoneda_hash.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_HASH_H
+#define YONEDA_HASH_H
+
+#include <yoneda_core.h>
+#include <yoneda_string.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Inputs up to this size are hashed by multiplying 16-byte chunks, larger ones go through the
+/// vectorized stripe accumulation.
+#define YO_HASH_SHORT_INPUT_MAX_SIZE 256
+
+/// Size of the chunks of data consumed by each step of the accumulation of large inputs.
+#define YO_HASH_STRIPE_SIZE 64
+
+/// Number of 64-bit accumulator lanes used for large inputs.
+#define YO_HASH_LANE_COUNT 8
+
+// -----------------------------------------------------------------------------
+// Integer mixers.
+//
+// Bijective mixing functions, meant for hashing integer keys.
+// -----------------------------------------------------------------------------
+
+yo_api yo_inline u32 yo_hash_u32(u32 value) {
+    value ^= value >> 16;
+    value *= 0x7FEB352DU;
+    value ^= value >> 15;
+    value *= 0x846CA68BU;
+    value ^= value >> 16;
+    return value;
+}
+
+yo_api yo_inline u64 yo_hash_u64(u64 value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// -----------------------------------------------------------------------------
+// One-shot hashing of byte sequences.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_Hash128 {
+    u64 low;
+    u64 high;
+};
+yo_type_alias(yo_Hash128, struct yo_Hash128);
+
+/// Compute the 64-bit hash of a sequence of bytes.
+///
+/// The result is the same across platforms and SIMD instruction sets, as long as they share the
+/// same byte order.
+yo_api u64 yo_hash_bytes(void const* data, usize size_bytes, u64 seed);
+
+/// Compute the 128-bit hash of a sequence of bytes.
+yo_api yo_Hash128 yo_hash128_bytes(void const* data, usize size_bytes, u64 seed);
+
+yo_api yo_inline u64 yo_hash_string(yo_String str, u64 seed) {
+    return yo_hash_bytes(str.buf, str.length, seed);
+}
+
+yo_api yo_inline yo_Hash128 yo_hash128_string(yo_String str, u64 seed) {
+    return yo_hash128_bytes(str.buf, str.length, seed);
+}
+
+// -----------------------------------------------------------------------------
+// Streaming hashing.
+//
+// Hashes data that arrives in pieces. The digest of a stream is equal to the one-shot hash of the
+// concatenation of all of its pieces.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_HashState {
+    u64   accumulators[YO_HASH_LANE_COUNT];
+    /// Input not yet accumulated. Always holds the last bytes of the stream, so that short streams
+    /// can be hashed in one shot.
+    u8    buffer[YO_HASH_SHORT_INPUT_MAX_SIZE];
+    usize buffer_size;
+    /// Number of stripes accumulated so far.
+    usize stripe_count;
+    u64   total_size;
+    u64   seed;
+};
+yo_type_alias(yo_HashState, struct yo_HashState);
+
+yo_api yo_HashState yo_make_hash_state(u64 seed);
+
+/// Feed a piece of the stream to the hash state.
+yo_api void yo_hash_state_update(yo_HashState* state, void const* data, usize size_bytes);
+
+/// Compute the 64-bit hash of the stream fed so far. The state can still be updated afterwards.
+yo_api u64 yo_hash_state_digest(yo_HashState const* state);
+
+/// Compute the 128-bit hash of the stream fed so far. The state can still be updated afterwards.
+yo_api yo_Hash128 yo_hash_state_digest128(yo_HashState const* state);
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_HASH_H
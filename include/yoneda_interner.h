@@ -0,0 +1,120 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: String interning table.
+/// File name: yoneda_interner.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_INTERNER_H
+#define YONEDA_INTERNER_H
+
+#include <yoneda_core.h>
+#include <yoneda_map.h>
+#include <yoneda_memory.h>
+#include <yoneda_string.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Identifier never given to an interned string.
+#define YO_INTERNER_INVALID_ID yo_cast(u32, 0xFFFFFFFF)
+
+/// Minimum amount of memory committed at once by the string pool of an interner.
+#if !defined(YO_INTERNER_POOL_COMMIT_SIZE)
+#    define YO_INTERNER_POOL_COMMIT_SIZE yo_kibibytes(64)
+#endif
+
+// -----------------------------------------------------------------------------
+// String interner.
+//
+// Stores a single copy of each distinct string and identifies it by a dense index, so that
+// strings can be compared by their identifiers instead of their contents. The copies are
+// zero-terminated and packed one after the other into a pool owned by the interner, whose address
+// range is reserved up front: they never move, and the strings obtained from the interner stay
+// valid until it is destroyed.
+//
+// The tables mapping strings to identifiers and back come from an arena given by the caller, and
+// are sized for the expected number of strings up front. Interning fewer strings than that never
+// allocates from the arena. Past it, a table that grows is copied to a new block of the arena,
+// unless it is the last allocation of the arena, and its old block stays behind until the arena
+// is reset.
+//
+// Once frozen, the interner no longer changes, and lookups can be made by multiple threads at the
+// same time.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_Interner {
+    /// Pool holding the copies of the interned strings.
+    yo_Arena               pool;
+    /// Identifier of each interned string, keyed by the string.
+    yo_Map                 ids;
+    /// Interned strings, indexed by their identifiers. Null if the interner couldn't be made.
+    yo_DynArray(yo_String) strings;
+    bool                   frozen;
+};
+yo_type_alias(yo_Interner, struct yo_Interner);
+
+/// Make an interner whose tables are allocated from an arena.
+///
+/// This call has to be paired with `yo_destroy_interner`. If any of the memory of the interner
+/// couldn't be allocated, no string can be interned by it.
+///
+/// Parameters:
+///     * capacity: Number of strings the interner can hold before growing its tables.
+///     * pool_size: Maximum total size of the interned strings, counting a zero terminator for
+///                  each of them. Reserved up front and committed as the strings are interned.
+yo_api yo_Interner yo_make_interner(yo_Arena* arena, usize capacity, usize pool_size);
+
+/// Free the string pool of an interner, invalidating all of its strings. The tables stay in the
+/// arena they were allocated from.
+yo_api void yo_destroy_interner(yo_Interner* interner);
+
+/// Get the identifier of a string, interning a copy of it if it wasn't interned yet.
+///
+/// Return: The identifier of the string, or `YO_INTERNER_INVALID_ID` if the string would have to
+///         be interned but the interner is frozen, its pool is full, or it is out of memory.
+yo_api u32 yo_interner_intern(yo_Interner* interner, yo_String str);
+
+/// Get the identifier of a string without interning it.
+///
+/// Return: The identifier of the string, or `YO_INTERNER_INVALID_ID` if it isn't interned.
+yo_api u32 yo_interner_find(yo_Interner const* interner, yo_String str);
+
+/// Forbid new strings from being interned, allowing concurrent lookups.
+yo_api void yo_interner_freeze(yo_Interner* interner);
+
+/// Get the number of interned strings, which is also the next identifier to be given.
+yo_api yo_inline u32 yo_interner_count(yo_Interner const* interner) {
+    return yo_cast(u32, yo_dynarray_count(interner->strings));
+}
+
+/// Get the interned string with a given identifier.
+yo_api yo_inline yo_String yo_interner_string(yo_Interner const* interner, u32 id) {
+    yo_assert_fmt(id < yo_interner_count(interner), "Invalid interned string identifier %u.", id);
+    return interner->strings[id];
+}
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_INTERNER_H
@@ -0,0 +1,197 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Open-addressing hash map with SIMD-probed control groups.
+/// File name: yoneda_map.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_MAP_H
+#define YONEDA_MAP_H
+
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_string.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Number of control bytes probed at once.
+#define YO_MAP_GROUP_WIDTH 16
+
+/// Control byte of a slot that never held an entry.
+#define YO_MAP_CONTROL_EMPTY yo_cast(u8, 0x80)
+
+/// Control byte of a slot whose entry was removed.
+#define YO_MAP_CONTROL_DELETED yo_cast(u8, 0xFE)
+
+// -----------------------------------------------------------------------------
+// Hash map.
+//
+// Each slot has a control byte telling whether the slot is empty, deleted, or full. Full slots
+// store the low 7 bits of the hash of their key in the control byte. Lookups compare a whole group
+// of control bytes against these bits at once with SIMD instructions. The key of a slot is only
+// compared on a match.
+//
+// The control bytes live in their own array, separate from the slot storage, so that probing
+// only touches one cache line per group. A table whose entries and deleted slots reach 7/8 of
+// its capacity is rehashed into a new table, which holds no deleted slots. The new table has
+// twice the capacity, unless the deleted slots alone made the table reach its limit.
+// -----------------------------------------------------------------------------
+
+/// Procedure hashing a key of `key_size` bytes.
+typedef u64 yo_MapHashProc(void const* key, usize key_size);
+
+/// Procedure checking whether two keys of `key_size` bytes are equal.
+typedef bool yo_MapEqualProc(void const* lhs, void const* rhs, usize key_size);
+
+/// Type-erased hash map.
+///
+/// The memory of the map comes either from an arena or from an allocator interface. Arena-backed
+/// maps leave their previous table in the arena whenever they grow.
+struct yo_api yo_Map {
+    /// Control bytes, followed by a copy of the first group so that any group can be loaded
+    /// without wrapping around.
+    u8*   controls;
+    /// Slots, each holding a key followed by its value.
+    u8*   slots;
+    /// Capacity of the map, always a power of two of at least `YO_MAP_GROUP_WIDTH`.
+    usize capacity;
+    /// Number of entries in the map.
+    usize count;
+    /// Number of slots marked as deleted.
+    usize deleted_count;
+
+    usize key_size;
+    usize value_size;
+    /// Offset of the value within a slot.
+    usize value_offset;
+    usize slot_size;
+    u32   slot_alignment;
+
+    /// Procedures used on the keys, which compare and hash the raw key bytes by default.
+    yo_MapHashProc*  hash_proc;
+    yo_MapEqualProc* equal_proc;
+
+    yo_Arena*           arena;
+    yo_Allocator const* allocator;
+};
+yo_type_alias(yo_Map, struct yo_Map);
+
+/// Make a map whose memory is allocated from an arena or from an allocator interface, exactly one
+/// of which should be provided.
+///
+/// Keys are hashed and compared by their raw bytes, thus any padding bytes of the key type must be
+/// zeroed. Custom procedures can be set via `hash_proc` and `equal_proc` before the first insertion.
+///
+/// Parameters:
+///     * capacity: Number of entries the map can hold before growing.
+yo_api yo_Map yo_make_map_raw(
+    yo_Arena*           arena,
+    yo_Allocator const* allocator,
+    usize               key_size,
+    u32                 key_alignment,
+    usize               value_size,
+    u32                 value_alignment,
+    usize               capacity);
+
+/// Release the memory of an allocator-backed map. Arena-backed maps are released with their arena.
+yo_api void yo_destroy_map(yo_Map* map);
+
+/// Insert an entry, or overwrite the value of an existing entry with the same key.
+///
+/// A null `value` inserts a zeroed value, or keeps the value of an existing entry.
+///
+/// Return: Pointer to the value stored in the map, which stays valid until the map grows, or null
+///         if the map failed to grow.
+yo_api void* yo_map_insert(yo_Map* map, void const* key, void const* value);
+
+/// Find the value of the entry with a given key.
+///
+/// Return: Pointer to the value stored in the map, or null if there is no such entry.
+yo_api void* yo_map_get(yo_Map const* map, void const* key);
+
+/// Remove the entry with a given key.
+///
+/// Return: Whether there was an entry to be removed.
+yo_api bool yo_map_remove(yo_Map* map, void const* key);
+
+/// Remove all entries, keeping the capacity of the map.
+yo_api void yo_map_clear(yo_Map* map);
+
+/// Iterate over the slots holding entries. The key and value of a slot are accessed via
+/// `yo_map_key_at` and `yo_map_value_at`.
+#define yo_map_for_each_slot(idx, map) \
+    for (usize idx = yo_impl_map_next_full_slot(map, 0); idx < (map)->capacity; idx = yo_impl_map_next_full_slot(map, idx + 1))
+
+/// Get the index of the first slot holding an entry at or after `idx`, or the capacity of the map
+/// if there is none.
+yo_api usize yo_impl_map_next_full_slot(yo_Map const* map, usize idx);
+
+#define yo_map_key_at(map, KeyType, idx)     yo_cast(KeyType*, (map)->slots + (idx) * (map)->slot_size)
+#define yo_map_value_at(map, ValueType, idx) yo_cast(ValueType*, (map)->slots + (idx) * (map)->slot_size + (map)->value_offset)
+
+#define yo_make_map(arena_ptr, KeyType, ValueType, capacity) \
+    yo_make_map_raw(arena_ptr, NULL, yo_size_of(KeyType), yo_cast(u32, yo_align_of(KeyType)), yo_size_of(ValueType), yo_cast(u32, yo_align_of(ValueType)), capacity)
+
+#define yo_make_map_with_allocator(allocator_ptr, KeyType, ValueType, capacity) \
+    yo_make_map_raw(NULL, allocator_ptr, yo_size_of(KeyType), yo_cast(u32, yo_align_of(KeyType)), yo_size_of(ValueType), yo_cast(u32, yo_align_of(ValueType)), capacity)
+
+/// Hash procedure for maps whose keys are `yo_String` values, hashing the string contents.
+yo_api u64 yo_map_hash_string(void const* key, usize key_size);
+
+/// Equality procedure for maps whose keys are `yo_String` values, comparing the string contents.
+yo_api bool yo_map_equal_string(void const* lhs, void const* rhs, usize key_size);
+
+// -----------------------------------------------------------------------------
+// Typed hash maps.
+//
+// `yo_define_map(Name, KeyType, ValueType)` declares the type `Name`, wrapping a `yo_Map`, along
+// with the procedures `Name##_make`, `Name##_make_with_allocator`, `Name##_insert`, `Name##_get`,
+// and `Name##_remove`, which take keys and values by value.
+// -----------------------------------------------------------------------------
+
+#define yo_define_map(Name, KeyType, ValueType)                                                            \
+    struct Name {                                                                                          \
+        yo_Map raw;                                                                                        \
+    };                                                                                                     \
+    yo_type_alias(Name, struct Name);                                                                      \
+    yo_internal yo_inline Name Name##_make(yo_Arena* arena, usize capacity) {                              \
+        return (Name){.raw = yo_make_map(arena, KeyType, ValueType, capacity)};                            \
+    }                                                                                                      \
+    yo_internal yo_inline Name Name##_make_with_allocator(yo_Allocator const* allocator, usize capacity) { \
+        return (Name){.raw = yo_make_map_with_allocator(allocator, KeyType, ValueType, capacity)};         \
+    }                                                                                                      \
+    yo_internal yo_inline ValueType* Name##_insert(Name* map, KeyType key, ValueType value) {              \
+        return yo_cast(ValueType*, yo_map_insert(&map->raw, &key, &value));                                \
+    }                                                                                                      \
+    yo_internal yo_inline ValueType* Name##_get(Name const* map, KeyType key) {                            \
+        return yo_cast(ValueType*, yo_map_get(&map->raw, &key));                                           \
+    }                                                                                                      \
+    yo_internal yo_inline bool Name##_remove(Name* map, KeyType key) {                                     \
+        return yo_map_remove(&map->raw, &key);                                                             \
+    }
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_MAP_H
@@ -27,6 +27,7 @@
 #define YONEDA_MEMORY_H
 
 #include <yoneda_assert.h>
+#include <yoneda_atomic.h>
 #include <yoneda_core.h>
 
 #if defined(YO_LANG_CPP)
@@ -56,9 +57,108 @@ yo_api bool yo_arch_is_big_endian(void);
 yo_api u8* yo_memory_virtual_alloc(usize size_bytes);
 
 /// Release and decommit all memory.
+///
+/// Can be used both for blocks obtained via `yo_memory_virtual_alloc` and for ranges obtained via
+/// `yo_memory_virtual_reserve`.
 yo_api void yo_memory_virtual_free(u8* memory, usize size_bytes);
 
-// TODO: add procedures for reserving/commiting memory separately.
+/// Query the size, in bytes, of a virtual memory page in the current system.
+yo_api usize yo_memory_page_size(void);
+
+/// Reserve a range of virtual addresses without committing any physical memory to it.
+///
+/// The reserved range is inaccessible until a sub-range of it gets committed via
+/// `yo_memory_virtual_commit`. Reserving costs no physical memory, thus it's fine to reserve huge
+/// ranges (e.g. tens of gibibytes) even if only a small fraction of it ends up being used.
+///
+/// Return: The start of the reserved range, aligned to the page size, or null if the OS refused to
+///         reserve the range.
+yo_api u8* yo_memory_virtual_reserve(usize size_bytes);
+
+/// Commit a sub-range of a block reserved via `yo_memory_virtual_reserve`.
+///
+/// The committed memory becomes readable and writable, and is always initialized to zero.
+///
+/// Parameters:
+///     * memory: Start of the range to be committed, should be aligned to the page size.
+///     * size_bytes: Size of the range to be committed, should be a multiple of the page size.
+yo_api yo_Status yo_memory_virtual_commit(u8* memory, usize size_bytes);
+
+/// Flags modifying how virtual memory is allocated.
+enum yo_MemoryFlag {
+    YO_MEMORY_FLAG_NONE = 0,
+
+    /// Back the memory with huge pages (see `yo_memory_huge_page_size`), reducing TLB misses for
+    /// large working sets. The allocation size and address are aligned to the huge page size.
+    ///
+    /// Explicit huge pages (`MAP_HUGETLB` on Linux, `MEM_LARGE_PAGES` on Windows) are tried first,
+    /// then transparent huge pages (Linux only), falling back to regular pages otherwise.
+    YO_MEMORY_FLAG_HUGE_PAGES = 1 << 0,
+};
+yo_type_alias(yo_MemoryFlag, enum yo_MemoryFlag);
+
+/// Block of virtual memory along with the properties the OS actually gave it.
+struct yo_api yo_VirtualMemory {
+    u8*   buf;
+    /// Size of the block, rounded up to a multiple of `page_size`. This is the size that should be
+    /// passed to `yo_memory_virtual_free`.
+    usize size_bytes;
+    /// Size of the pages backing the block.
+    usize page_size;
+};
+yo_type_alias(yo_VirtualMemory, struct yo_VirtualMemory);
+
+/// Query the size, in bytes, of the huge pages of the current system (typically 2 MiB on x64).
+yo_api usize yo_memory_huge_page_size(void);
+
+/// Reserve and commit a virtual block of memory, with a combination of `yo_MemoryFlag` values.
+///
+/// The memory allocated is always initialized to zero. On failure, the resulting block is null.
+yo_api yo_VirtualMemory yo_memory_virtual_alloc_with_flags(usize size_bytes, u32 flags);
+
+/// Reserve a range of virtual addresses, with a combination of `yo_MemoryFlag` values, that should
+/// be committed via `yo_memory_virtual_commit` before being accessed.
+///
+/// Only transparent huge pages can be requested for reserved ranges, thus the reported page size
+/// is the one that will be used once the memory gets committed.
+yo_api yo_VirtualMemory yo_memory_virtual_reserve_with_flags(usize size_bytes, u32 flags);
+
+/// Decommit a sub-range of a reserved block, returning its physical memory to the OS.
+///
+/// The range becomes inaccessible again until committed via `yo_memory_virtual_commit`.
+///
+/// Parameters:
+///     * memory: Start of the range to be decommitted, should be aligned to the page size.
+///     * size_bytes: Size of the range to be decommitted, should be a multiple of the page size.
+yo_api yo_Status yo_memory_virtual_decommit(u8* memory, usize size_bytes);
+
+/// Release the physical memory backing a page-aligned range, while keeping the range accessible.
+///
+/// Parameters:
+///     * memory: Start of the range to be purged, should be aligned to the page size.
+///     * size_bytes: Size of the range to be purged, should be a multiple of the page size.
+///     * lazy: If true, the OS only reclaims the pages under memory pressure and their contents are
+///             undefined until written again. Otherwise the pages are released right away and
+///             read back as zero.
+yo_api yo_Status yo_memory_virtual_purge(u8* memory, usize size_bytes, bool lazy);
+
+/// Map the same physical memory twice, at two adjacent virtual ranges, so that the byte at
+/// `memory + size_bytes + i` is the byte at `memory + i`.
+///
+/// Any span of up to `size_bytes` starting inside the first range is then contiguous, which lets
+/// ring buffers hand out spans that cross their wrap point. Uses a memfd on Linux and a paging
+/// file mapping on Windows, other platforms aren't supported.
+///
+/// Parameters:
+///     * size_bytes: Size of each of the two ranges, should be a multiple of the page size (on
+///                   Windows, of the 64 KiB allocation granularity).
+///
+/// Return: The start of the first range, or null if the platform or the OS refused to map it. The
+///         memory is initialized to zero.
+yo_api u8* yo_memory_virtual_alloc_mirrored(usize size_bytes);
+
+/// Unmap both ranges of a block obtained via `yo_memory_virtual_alloc_mirrored`.
+yo_api void yo_memory_virtual_free_mirrored(u8* memory, usize size_bytes);
 
 /// Simple wrapper around `memset` that automatically deals with null values.
 ///
@@ -73,10 +173,10 @@ yo_api void yo_memory_set(u8* memory, usize size_bytes, i32 fill);
 /// behaviour introduced by `memcpy` in this case.
 yo_api void yo_memory_copy(u8* yo_no_alias dst, u8 const* yo_no_alias src, usize size_bytes);
 
-/// Simple wrapper around `memmove`.
+/// Simple wrapper around `memmove`, the blocks of memory may overlap.
 ///
 /// Does nothing if either `dst` or `src` are null pointers.
-yo_api void yo_memory_move(u8* yo_no_alias dst, u8 const* yo_no_alias src, usize size_bytes);
+yo_api void yo_memory_move(u8* dst, u8 const* src, usize size_bytes);
 
 // -----------------------------------------------------------------------------
 // Alignment utilities.
@@ -86,7 +186,8 @@ yo_api void yo_memory_move(u8* yo_no_alias dst, u8 const* yo_no_alias src, usize
 ///
 /// The padding should contain the header, thus it is ensured that `padding >= header_size`.
 /// Both the alignment needed for the new memory block as the alignment required by the header
-/// will be accounted when calculating the padding.
+/// will be accounted when calculating the padding, with the header placed right before the new
+/// block, at the address `ptr + padding - header_size`.
 ///
 /// Parameters:
 ///     * ptr: The current memory address.
@@ -121,12 +222,59 @@ yo_api usize yo_align_forward(uptr ptr, usize alignment);
 // Forward declaration.
 struct yo_Arena;
 
+/// Properties of the memory managed by an arena.
+enum yo_ArenaFlag {
+    YO_ARENA_FLAG_NONE = 0,
+
+    /// The arena memory came zeroed from the OS (e.g. via `yo_memory_virtual_alloc`), so that any
+    /// memory past the high-water mark of the arena is known to be zero and doesn't need to be
+    /// cleared when allocated.
+    YO_ARENA_FLAG_FRESH_MEMORY = 1 << 0,
+
+    /// When out of memory, the arena spills into a new virtually allocated block (with geometric
+    /// growth) instead of failing. See `yo_make_chained_arena`.
+    YO_ARENA_FLAG_CHAINED = 1 << 1,
+
+    /// The current block of the arena was allocated by the arena itself and is linked to the
+    /// previous block. Managed internally by chained arenas.
+    YO_ARENA_FLAG_CHAIN_BLOCK = 1 << 2,
+
+    /// Clearing the arena, or restoring a checkpoint, may release the unused memory of the arena
+    /// back to the OS according to the trim policy of the arena. See `yo_arena_set_trim_policy`.
+    YO_ARENA_FLAG_TRIM = 1 << 3,
+};
+yo_type_alias(yo_ArenaFlag, enum yo_ArenaFlag);
+
+/// Policy for releasing the unused memory of an arena back to the OS.
+///
+/// When the arena is cleared or restored to a checkpoint, the memory it keeps resident (committed
+/// or touched pages) is compared against its usage at that moment. Once the surplus is larger than
+/// `threshold_bytes` for `delay` consecutive clears/restores, everything above the highest usage
+/// seen in that period (but never below `retain_bytes`) is released. The delay acts as hysteresis:
+/// frame-like clear loops with a steady usage never release memory that they will touch again.
+struct yo_api yo_ArenaTrimPolicy {
+    /// Amount of memory, from the start of the arena, that is never released.
+    usize retain_bytes;
+    /// Minimum surplus of resident memory that justifies releasing it.
+    usize threshold_bytes;
+    /// Number of consecutive clears/restores with surplus memory before releasing it.
+    u32   delay;
+    /// Release pages lazily (`MADV_FREE`), letting the OS reclaim them only under memory pressure.
+    /// Reserved arenas then keep the pages committed. Otherwise the pages are released immediately
+    /// (`MADV_DONTNEED`, or decommit for reserved arenas).
+    bool  lazy;
+};
+yo_type_alias(yo_ArenaTrimPolicy, struct yo_ArenaTrimPolicy);
+
 /// Manually managed checkpoint for arenas.
 ///
 /// You can create a checkpoint with `arena_make_checkpoint` and restore the arena to
 /// a given checkpoint via `arena_restore_state`.
 struct yo_api yo_ArenaCheckpoint {
     struct yo_Arena* arena;
+    /// The block of memory the arena was using, which may differ from the current one for chained
+    /// arenas.
+    u8*              saved_buf;
     usize            saved_offset;
 };
 yo_type_alias(yo_ArenaCheckpoint, struct yo_ArenaCheckpoint);
@@ -137,24 +285,62 @@ yo_type_alias(yo_ArenaCheckpoint, struct yo_ArenaCheckpoint);
 /// allocation takes nothing more than incrementing an offset.
 ///
 /// The arena does not own memory, thus it is not responsible for the freeing of it.
+///
+/// An arena may also be created over a reserved range of virtual addresses (see
+/// `yo_make_reserved_arena`), in which case only the prefix `[buf, buf + committed)` is backed by
+/// physical memory. The committed region grows in chunks of `commit_chunk_size` bytes whenever an
+/// allocation crosses the commit boundary, so that the arena can grow in-place up to its capacity
+/// without ever moving its memory.
+///
+/// Arenas with the `YO_ARENA_FLAG_CHAINED` flag never run out of memory: when the current block
+/// can't fit an allocation, a new block is allocated and linked to the previous one, which becomes
+/// unavailable until a checkpoint restore (or clear) releases the newer blocks.
 struct yo_api yo_Arena {
     /// Not-owned block of memory.
-    u8*   buf;
+    u8*                buf;
     /// Capacity in bytes of the arena block of memory.
-    usize capacity;
+    usize              capacity;
     /// The current offset to the free-space in the memory block.
-    usize offset;
+    usize              offset;
+    /// Number of bytes, starting at `buf`, that are committed. Only meaningful for reserved arenas.
+    usize              committed;
+    /// Granularity in which new memory is committed. Zero for arenas whose whole capacity is
+    /// already accessible.
+    usize              commit_chunk_size;
+    /// Highest offset ever handed out by the arena. Only meaningful with `YO_ARENA_FLAG_FRESH_MEMORY`.
+    usize              high_water_offset;
+    /// Size of the pages backing the memory of the arena, if the arena owns its memory.
+    usize              page_size;
+    /// Policy for releasing memory, only used with `YO_ARENA_FLAG_TRIM`.
+    yo_ArenaTrimPolicy trim_policy;
+    /// Highest usage seen during the current streak of clears/restores with surplus memory.
+    usize              trim_streak_peak;
+    /// Offset above which the memory was lazily released by the trim policy and wasn't touched
+    /// since, thus isn't released again.
+    usize              trim_resident_offset;
+    /// Length of the current streak of clears/restores with surplus memory.
+    u32                trim_streak;
+    /// Combination of `yo_ArenaFlag` values.
+    u32                flags;
 };
 yo_type_alias(yo_Arena, struct yo_Arena);
 
 // -----------------------------------------------------------------------------
 // Allocation procedures.
 //
-// @NOTE: All allocation procedures will zero-out the whole allocated block.
+// @NOTE: All allocation procedures will zero-out the whole allocated block, except for the
+//        `uninit` variants. Arenas with `YO_ARENA_FLAG_FRESH_MEMORY` only clear the part of the
+//        block that lies below the high-water mark, since the rest is still untouched OS memory.
 // -----------------------------------------------------------------------------
 
 u8* yo_arena_alloc_align(yo_Arena* arena, usize size_bytes, u32 alignment);
 
+/// Allocate a block of memory whose contents are left uninitialized.
+///
+/// Meant for blocks that are going to be fully overwritten right away (e.g. the target buffer of a
+/// file read), avoiding a redundant pass over the memory.
+u8* yo_arena_alloc_uninit_align(yo_Arena* arena, usize size_bytes, u32 alignment);
+
 u8* yo_arena_realloc_align(
     yo_Arena* arena,
     u8*       block,
@@ -167,6 +353,11 @@ u8* yo_arena_realloc_align(
         ValueType*,                             \
         yo_arena_alloc_align(arena, yo_size_of(ValueType) * count, yo_align_of(ValueType)))
 
+#define yo_arena_alloc_uninit(arena, ValueType, count) \
+    yo_cast(                                           \
+        ValueType*,                                    \
+        yo_arena_alloc_uninit_align(arena, yo_size_of(ValueType) * count, yo_align_of(ValueType)))
+
 #define yo_arena_realloc(arena, ValueType, block, current_count, new_count) \
     yo_cast(                                                                \
         ValueType*,                                                         \
@@ -181,18 +372,53 @@ u8* yo_arena_realloc_align(
 // Temporary memory management.
 // -----------------------------------------------------------------------------
 
+/// Release the chained blocks of an arena until its current block is `target_buf`.
+///
+/// If `target_buf` is null, all chained blocks are released. Used internally by the temporary
+/// memory management procedures.
+yo_api void yo_impl_arena_release_blocks(yo_Arena* arena, u8 const* target_buf);
+
+/// Apply the trim policy of the arena, prior to resetting its offset to `new_offset`.
+yo_api void yo_impl_arena_trim(yo_Arena* arena, usize new_offset);
+
+/// Set the policy used for releasing the unused memory of an arena that owns its memory.
+yo_inline void yo_arena_set_trim_policy(yo_Arena* arena, yo_ArenaTrimPolicy policy) {
+    yo_assert_msg(arena->page_size != 0, "Only arenas owning their memory can be trimmed.");
+    arena->trim_policy          = policy;
+    arena->trim_streak          = 0;
+    arena->trim_streak_peak     = 0;
+    arena->trim_resident_offset = arena->capacity;
+    arena->flags |= YO_ARENA_FLAG_TRIM;
+}
+
 /// Reset the offset of the allocator.
+///
+/// Chained arenas also release all blocks allocated when spilling.
 yo_inline void yo_arena_clear(yo_Arena* arena) {
+    if (yo_unlikely(arena->flags & YO_ARENA_FLAG_CHAIN_BLOCK)) {
+        yo_impl_arena_release_blocks(arena, NULL);
+    }
+    if (yo_unlikely(arena->flags & YO_ARENA_FLAG_TRIM)) {
+        yo_impl_arena_trim(arena, 0);
+    }
     arena->offset = 0;
 }
 
 /// Create a restorable checkpoint for the arena.
 yo_inline yo_ArenaCheckpoint yo_make_arena_checkpoint(yo_Arena* arena) {
-    return (yo_ArenaCheckpoint){.arena = arena, .saved_offset = arena->offset};
+    return (yo_ArenaCheckpoint){.arena = arena, .saved_buf = arena->buf, .saved_offset = arena->offset};
 }
 
 /// Restore the arena state to a given checkpoint.
+///
+/// Chained arenas also release all blocks allocated after the checkpoint was made.
 yo_inline void yo_arena_checkpoint_restore(yo_ArenaCheckpoint checkpoint) {
+    if (yo_unlikely(checkpoint.arena->buf != checkpoint.saved_buf)) {
+        yo_impl_arena_release_blocks(checkpoint.arena, checkpoint.saved_buf);
+    }
+    if (yo_unlikely(checkpoint.arena->flags & YO_ARENA_FLAG_TRIM)) {
+        yo_impl_arena_trim(checkpoint.arena, checkpoint.saved_offset);
+    }
     checkpoint.arena->offset = checkpoint.saved_offset;
     checkpoint.arena         = NULL;  // Invalidate the checkpoint for further uses.
 }
@@ -208,15 +434,218 @@ yo_inline yo_Arena yo_make_owned_arena(usize capacity) {
         capacity = 0;
     }
 
-    return (yo_Arena){.buf = memory, .capacity = capacity};
+    return (yo_Arena){
+        .buf       = memory,
+        .capacity  = capacity,
+        .page_size = yo_memory_page_size(),
+        .flags     = YO_ARENA_FLAG_FRESH_MEMORY,
+    };
+}
+
+/// Make an arena that owns its memory, allocated with a combination of `yo_MemoryFlag` values.
+///
+/// The capacity of the arena is rounded up to the size of the pages the OS actually gave, which
+/// is reported by the `page_size` member of the arena.
+yo_api yo_Arena yo_make_owned_arena_with_flags(usize capacity, u32 memory_flags);
+
+/// Make an arena that reserves a range of virtual addresses and commits memory on demand.
+///
+/// No memory is committed at creation time: the first allocation crossing the commit boundary
+/// commits enough chunks of `commit_chunk_size` bytes to fit it. Pointers returned by the arena
+/// are stable, since the reserved range never moves.
+///
+/// As with `yo_make_owned_arena`, this call has to be paired with `yo_destroy_owned_arena`.
+///
+/// Parameters:
+///     * reserve_size: Maximum capacity of the arena, rounded up to the page size.
+///     * commit_chunk_size: Minimum amount of memory committed at once, rounded up to the page size.
+yo_api yo_Arena yo_make_reserved_arena(usize reserve_size, usize commit_chunk_size);
+
+/// Make a reserved arena whose address range is reserved with a combination of `yo_MemoryFlag`
+/// values. When huge pages are used, the commit chunk size is at least the huge page size.
+yo_api yo_Arena yo_make_reserved_arena_with_flags(usize reserve_size, usize commit_chunk_size, u32 memory_flags);
+
+/// Make an arena that owns its memory and spills into new blocks when it runs out of memory.
+///
+/// Each new block has at least twice the capacity of the previous one. This allows the arena to be
+/// sized for the common case without failing on outlier workloads.
+///
+/// As with `yo_make_owned_arena`, this call has to be paired with `yo_destroy_owned_arena`.
+yo_inline yo_Arena yo_make_chained_arena(usize initial_capacity) {
+    yo_Arena arena = yo_make_owned_arena(initial_capacity);
+    arena.flags |= YO_ARENA_FLAG_CHAINED;
+    return arena;
 }
 
 /// Free the memory of an arena that owns its memory.
 ///
-/// This function should only be called for arenas that where created by `make_owned_arena`.
+/// This function should only be called for arenas that where created by `make_owned_arena`,
+/// `yo_make_reserved_arena`, or `yo_make_chained_arena`.
 yo_inline void yo_destroy_owned_arena(yo_Arena* arena) {
+    if (arena->flags & YO_ARENA_FLAG_CHAIN_BLOCK) {
+        yo_impl_arena_release_blocks(arena, NULL);
+    }
     yo_memory_virtual_free(arena->buf, arena->capacity);
-    arena->capacity = 0;
+    arena->capacity  = 0;
+    arena->committed = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Thread-local scratch arenas.
+//
+// Each thread owns a small set of reserved arenas for temporary allocations, so that procedures
+// don't need to receive a spare arena from their callers. A procedure acquires a scratch arena
+// that doesn't alias any of the arenas it was given (such as the arena its output lives in), and
+// all temporaries are released at once when the scratch ends.
+// -----------------------------------------------------------------------------
+
+/// Number of scratch arenas of each thread.
+///
+/// Two arenas suffice as long as each procedure passes at most one of its arenas as a conflict:
+/// nested scratches alternate between the arenas.
+#if !defined(YO_SCRATCH_ARENA_COUNT)
+#    define YO_SCRATCH_ARENA_COUNT 2
+#endif
+
+/// Size of the virtual address range reserved by each scratch arena.
+#if !defined(YO_SCRATCH_ARENA_RESERVE_SIZE)
+#    define YO_SCRATCH_ARENA_RESERVE_SIZE yo_gibibytes(1)
+#endif
+
+/// Temporary arena of the current thread, restored to its original state when the scratch ends.
+struct yo_api yo_Scratch {
+    yo_Arena*          arena;
+    yo_ArenaCheckpoint checkpoint;
+};
+yo_type_alias(yo_Scratch, struct yo_Scratch);
+
+/// Acquire a scratch arena of the current thread that differs from all conflicting arenas.
+///
+/// Scratch arenas are created on first use, reserving YO_SCRATCH_ARENA_RESERVE_SIZE bytes of
+/// address space that are committed on demand.
+///
+/// Parameters:
+///     * conflicts: Arenas that must not be used as the scratch arena. May be null if
+///                  `conflict_count` is zero.
+///     * conflict_count: Number of conflicting arenas.
+yo_api yo_Scratch yo_scratch_begin(yo_Arena* const* conflicts, usize conflict_count);
+
+/// Release all memory allocated from the scratch arena since the scratch began.
+yo_inline void yo_scratch_end(yo_Scratch scratch) {
+    yo_arena_checkpoint_restore(scratch.checkpoint);
+}
+
+/// Destroy the scratch arenas of the current thread. Should be called before a thread exits.
+yo_api void yo_scratch_thread_release(void);
+
+// -----------------------------------------------------------------------------
+// Allocator interface.
+//
+// Type-erased allocator that allows the same code to run on top of any allocation strategy. The
+// arena remains the default allocator of the library, and all procedures accepting an arena avoid
+// the indirection, the interface is meant for the `_with_allocator` variants.
+// -----------------------------------------------------------------------------
+
+/// Allocate a zeroed block of memory.
+typedef u8* (*yo_AllocatorAllocProc)(void* context, usize size_bytes, u32 alignment);
+
+/// Resize a block of memory, preserving its contents. Bytes past the current size are zeroed.
+typedef u8* (*yo_AllocatorResizeProc)(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+
+/// Release a block of memory. Allocators without individual releases may ignore the call.
+typedef void (*yo_AllocatorFreeProc)(void* context, void* block, usize size_bytes);
+
+/// Allocator interface, composed of the allocator procedures and the state they act upon.
+struct yo_api yo_Allocator {
+    void*                  context;
+    yo_AllocatorAllocProc  alloc;
+    yo_AllocatorResizeProc resize;
+    yo_AllocatorFreeProc   free;
+};
+yo_type_alias(yo_Allocator, struct yo_Allocator);
+
+yo_api yo_inline u8* yo_allocator_alloc_align(yo_Allocator const* allocator, usize size_bytes, u32 alignment) {
+    yo_assert_not_null(allocator);
+    return allocator->alloc(allocator->context, size_bytes, alignment);
+}
+
+/// Resize a block of memory. If the block is null, a new block is allocated.
+yo_api yo_inline u8* yo_allocator_resize_align(
+    yo_Allocator const* allocator,
+    u8*                 block,
+    usize               current_size_bytes,
+    usize               new_size_bytes,
+    u32                 alignment) {
+    yo_assert_not_null(allocator);
+    return (block != NULL) ? allocator->resize(allocator->context, block, current_size_bytes, new_size_bytes, alignment)
+                           : allocator->alloc(allocator->context, new_size_bytes, alignment);
+}
+
+/// Release a block of memory. Does nothing if `block` is a null pointer.
+yo_api yo_inline void yo_allocator_free(yo_Allocator const* allocator, void* block, usize size_bytes) {
+    yo_assert_not_null(allocator);
+    if (block != NULL) {
+        allocator->free(allocator->context, block, size_bytes);
+    }
+}
+
+#define yo_allocator_alloc(allocator, ValueType, count) \
+    yo_cast(ValueType*, yo_allocator_alloc_align(allocator, yo_size_of(ValueType) * (count), yo_cast(u32, yo_align_of(ValueType))))
+
+#define yo_allocator_resize(allocator, ValueType, block, current_count, new_count) \
+    yo_cast(                                                                        \
+        ValueType*,                                                                 \
+        yo_allocator_resize_align(                                                  \
+            allocator,                                                              \
+            yo_cast(u8*, block),                                                    \
+            yo_size_of(ValueType) * (current_count),                                \
+            yo_size_of(ValueType) * (new_count),                                    \
+            yo_cast(u32, yo_align_of(ValueType))))
+
+yo_api u8*  yo_impl_arena_allocator_alloc(void* context, usize size_bytes, u32 alignment);
+yo_api u8*  yo_impl_arena_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+yo_api void yo_impl_arena_allocator_free(void* context, void* block, usize size_bytes);
+
+/// Get the allocator interface of an arena. Releasing blocks is a no-op.
+yo_api yo_inline yo_Allocator yo_arena_allocator(yo_Arena* arena) {
+    return (yo_Allocator){
+        .context = arena,
+        .alloc   = yo_impl_arena_allocator_alloc,
+        .resize  = yo_impl_arena_allocator_resize,
+        .free    = yo_impl_arena_allocator_free,
+    };
+}
+
+/// Allocator wrapper that keeps track of the memory requested from an underlying allocator.
+///
+/// Useful for finding leaks and measuring the memory footprint of a subsystem.
+struct yo_api yo_TrackingAllocator {
+    yo_Allocator const* parent;
+    /// Number of bytes currently allocated through the tracker.
+    usize               live_bytes;
+    /// Highest number of bytes simultaneously allocated through the tracker.
+    usize               peak_bytes;
+    usize               alloc_count;
+    usize               free_count;
+};
+yo_type_alias(yo_TrackingAllocator, struct yo_TrackingAllocator);
+
+yo_api u8*  yo_impl_tracking_allocator_alloc(void* context, usize size_bytes, u32 alignment);
+yo_api u8*  yo_impl_tracking_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+yo_api void yo_impl_tracking_allocator_free(void* context, void* block, usize size_bytes);
+
+yo_api yo_inline yo_TrackingAllocator yo_make_tracking_allocator(yo_Allocator const* parent) {
+    return (yo_TrackingAllocator){.parent = parent};
+}
+
+/// Get the allocator interface of a tracking allocator.
+yo_api yo_inline yo_Allocator yo_tracking_allocator(yo_TrackingAllocator* tracker) {
+    return (yo_Allocator){
+        .context = tracker,
+        .alloc   = yo_impl_tracking_allocator_alloc,
+        .resize  = yo_impl_tracking_allocator_resize,
+        .free    = yo_impl_tracking_allocator_free,
+    };
 }
 
 // -----------------------------------------------------------------------------
@@ -235,6 +664,14 @@ yo_BufferHeader* yo_impl_buffer_header(void* buffer);
 /// Make a new buffer with a given fixed element count.
 #define yo_make_buffer(arena_ptr, T, count) yo_cast(T*, yo_impl_make_buffer(arena_ptr, count, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
 
+/// Make a new buffer whose memory is provided by an allocator interface.
+#define yo_make_buffer_with_allocator(allocator_ptr, T, count) \
+    yo_cast(T*, yo_impl_make_buffer_with_allocator(allocator_ptr, count, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
+
+/// Release a buffer created with `yo_make_buffer_with_allocator`.
+#define yo_destroy_buffer_with_allocator(allocator_ptr, buffer) \
+    yo_impl_destroy_buffer_with_allocator(allocator_ptr, buffer, yo_size_of(*(buffer)))
+
 /// Get the element count of the buffer.
 #define yo_buffer_count(buffer) (yo_impl_buffer_header(buffer)->element_count)
 
@@ -275,6 +712,29 @@ yo_Buffer(u8) yo_impl_make_buffer(yo_Arena* arena, usize element_count, usize el
     return memory;
 }
 
+yo_api yo_inline
+yo_Buffer(u8) yo_impl_make_buffer_with_allocator(yo_Allocator const* allocator, usize element_count, usize element_size, u32 element_alignment) {
+    usize effective_buffer_size = (element_size * element_count) + yo_size_of(yo_BufferHeader);
+
+    u8* memory = yo_allocator_alloc_align(allocator, effective_buffer_size, element_alignment);
+
+    if (yo_likely(memory != NULL)) {
+        yo_BufferHeader* header = yo_cast(yo_BufferHeader*, memory);
+        header->element_count   = element_count;
+
+        memory += yo_size_of(yo_BufferHeader);
+    }
+
+    return memory;
+}
+
+yo_api yo_inline void yo_impl_destroy_buffer_with_allocator(yo_Allocator const* allocator, void* buffer, usize element_size) {
+    if (buffer != NULL) {
+        yo_BufferHeader* header = yo_impl_buffer_header(buffer);
+        yo_allocator_free(allocator, header, (element_size * header->element_count) + yo_size_of(yo_BufferHeader));
+    }
+}
+
 #if defined(YO_COMPILER_CLANG)
 #    pragma clang diagnostic pop
 #endif
@@ -296,6 +756,14 @@ yo_ArrayHeader* yo_impl_array_header(void* array);
 /// Create a new array with a given fixed element capacity.
 #define yo_make_array(arena_ptr, T, capacity) yo_cast(T*, yo_impl_make_array(arena_ptr, capacity, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
 
+/// Create a new array whose memory is provided by an allocator interface.
+#define yo_make_array_with_allocator(allocator_ptr, T, capacity) \
+    yo_cast(T*, yo_impl_make_array_with_allocator(allocator_ptr, capacity, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
+
+/// Release an array created with `yo_make_array_with_allocator`.
+#define yo_destroy_array_with_allocator(allocator_ptr, array) \
+    yo_impl_destroy_array_with_allocator(allocator_ptr, array, yo_size_of(*(array)))
+
 /// Get the maximum (fixed) capacity of the array.
 #define yo_array_capacity(array) ((array != NULL) ? yo_impl_array_header(array)->element_capacity : 0)
 
@@ -336,8 +804,8 @@ yo_ArrayHeader* yo_impl_array_header(void* array);
 // Implementation details.
 //
 
-#if YO_ENABLE_BOUNDS_CHECK
-#    define yo_impl_array_assert_can_push(array) 0
+#if !YO_ENABLE_BOUNDS_CHECK
+#    define yo_impl_array_assert_can_push(array) ((void)0)
 #else
 #    define yo_impl_array_assert_can_push(array)                               \
         do {                                                                   \
@@ -378,14 +846,346 @@ yo_Array(u8) yo_impl_make_array(yo_Arena* arena, usize element_capacity, usize e
     return memory;
 }
 
+yo_api yo_inline
+yo_Array(u8) yo_impl_make_array_with_allocator(yo_Allocator const* allocator, usize element_capacity, usize element_size, u32 element_alignment) {
+    usize effective_array_size = (element_size * element_capacity) + yo_size_of(yo_ArrayHeader);
+
+    u8* memory = yo_allocator_alloc_align(allocator, effective_array_size, element_alignment);
+
+    if (yo_likely(memory != NULL)) {
+        yo_ArrayHeader* header   = yo_cast(yo_ArrayHeader*, memory);
+        header->element_capacity = element_capacity;
+        header->element_count    = 0;
+
+        memory += yo_size_of(yo_ArrayHeader);
+    }
+
+    return memory;
+}
+
+yo_api yo_inline void yo_impl_destroy_array_with_allocator(yo_Allocator const* allocator, void* array, usize element_size) {
+    if (array != NULL) {
+        yo_ArrayHeader* header = yo_impl_array_header(array);
+        yo_allocator_free(allocator, header, (element_size * header->element_capacity) + yo_size_of(yo_ArrayHeader));
+    }
+}
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic pop
+#endif
+
+// -----------------------------------------------------------------------------
+// Growable arrays, whose capacity grows on demand by reallocating from an arena.
+//
+// While the array is the last allocation of its arena, growing and shrinking it only moves the
+// arena offset, without copying any element. Operations that may grow the array may also move it,
+// thus they take the array variable itself and update it.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_DynArrayHeader {
+    usize     element_capacity;
+    usize     element_count;
+    /// Arena from which the array memory is reallocated.
+    yo_Arena* arena;
+    u32       element_alignment;
+};
+yo_type_alias(yo_DynArrayHeader, struct yo_DynArrayHeader);
+yo_DynArrayHeader* yo_impl_dynarray_header(void* array);
+
+/// Generic type alias for growable arrays.
+#define yo_DynArray(T) T*
+
+/// Create a new growable array with a given initial element capacity.
+#define yo_make_dynarray(arena_ptr, T, capacity) yo_cast(T*, yo_impl_make_dynarray(arena_ptr, capacity, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
+
+/// Get the current capacity of the array.
+#define yo_dynarray_capacity(array) ((array != NULL) ? yo_impl_dynarray_header(array)->element_capacity : 0)
+
+/// Get the current element count of the array.
+#define yo_dynarray_count(array) ((array != NULL) ? yo_impl_dynarray_header(array)->element_count : 0)
+
+/// Ensure that the array can hold at least `capacity` elements without growing.
+#define yo_dynarray_reserve(array, capacity) ((array) = yo_impl_dynarray_reserve(array, capacity, yo_size_of(*(array))))
+
+/// Push a new element by value to the end of the array, doubling its capacity if it's full.
+#define yo_dynarray_push(array, element)                                                                                           \
+    do {                                                                                                                           \
+        (array)                                                  = yo_impl_dynarray_reserve_extra(array, 1, yo_size_of(*(array))); \
+        (array)[yo_impl_dynarray_header(array)->element_count++] = (element);                                                      \
+    } while (0)
+
+/// Copy `count` elements to the end of the array.
+#define yo_dynarray_append(array, elements_ptr, count)                                                                                          \
+    do {                                                                                                                                        \
+        (array)                          = yo_impl_dynarray_reserve_extra(array, count, yo_size_of(*(array)));                                  \
+        yo_DynArrayHeader* yo_var_header = yo_impl_dynarray_header(array);                                                                      \
+        yo_memory_copy(yo_cast(u8*, (array) + yo_var_header->element_count), yo_cast(u8 const*, elements_ptr), (count) * yo_size_of(*(array))); \
+        yo_var_header->element_count += (count);                                                                                                \
+    } while (0)
+
+/// Insert an element at a given index, shifting the subsequent elements to the right.
+#define yo_dynarray_insert(array, idx, element)                                   \
+    do {                                                                          \
+        (array) = yo_impl_dynarray_reserve_extra(array, 1, yo_size_of(*(array))); \
+        yo_impl_dynarray_open_gap(array, idx, yo_size_of(*(array)));              \
+        (array)[idx] = (element);                                                 \
+    } while (0)
+
+/// Remove the element at a given index by moving the last element into its place. Doesn't
+/// preserve the order of the elements.
+#define yo_dynarray_remove_swap(array, idx)                                                                   \
+    do {                                                                                                      \
+        yo_DynArrayHeader* yo_var_header = yo_impl_dynarray_header(array);                                    \
+        yo_assert_fmt((idx) < yo_var_header->element_count, "Index %zu out of bounds.", yo_cast(usize, idx)); \
+        (array)[idx] = (array)[--yo_var_header->element_count];                                               \
+    } while (0)
+
+/// Clear the array, keeping its capacity.
+#define yo_dynarray_clear(array)                               \
+    do {                                                       \
+        if (array != NULL) {                                   \
+            yo_impl_dynarray_header(array)->element_count = 0; \
+        }                                                      \
+    } while (0)
+
+/// Shrink the capacity of the array down to its element count. The memory past the last element is
+/// only given back to the arena if the array is its last allocation.
+#define yo_dynarray_shrink_to_fit(array) yo_impl_dynarray_shrink_to_fit(array, yo_size_of(*(array)))
+
+//
+// Implementation details.
+//
+
+yo_api yo_DynArray(u8) yo_impl_make_dynarray(yo_Arena* arena, usize element_capacity, usize element_size, u32 element_alignment);
+yo_api void* yo_impl_dynarray_reserve(void* array, usize element_capacity, usize element_size);
+yo_api void* yo_impl_dynarray_try_reserve(void* array, usize element_capacity, usize element_size);
+yo_api void  yo_impl_dynarray_shrink_to_fit(void* array, usize element_size);
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+yo_api yo_inline yo_DynArrayHeader* yo_impl_dynarray_header(void* array) {
+    yo_assert_not_null(array);
+    return yo_cast(yo_DynArrayHeader*, yo_cast(u8*, array) - yo_size_of(yo_DynArrayHeader));
+}
+
+/// Ensure that the array can fit `extra_count` more elements, doubling its capacity if needed.
+yo_api yo_inline void* yo_impl_dynarray_reserve_extra(void* array, usize extra_count, usize element_size) {
+    yo_DynArrayHeader* header         = yo_impl_dynarray_header(array);
+    usize              required_count = header->element_count + extra_count;
+    if (yo_likely(required_count <= header->element_capacity)) {
+        return array;
+    }
+    return yo_impl_dynarray_reserve(array, yo_max_value(required_count, 2 * header->element_capacity), element_size);
+}
+
+/// Same as `yo_impl_dynarray_reserve_extra`, but returns null instead of aborting if the arena can't
+/// fit the grown array, in which case the array is left untouched.
+yo_api yo_inline void* yo_impl_dynarray_try_reserve_extra(void* array, usize extra_count, usize element_size) {
+    yo_DynArrayHeader* header         = yo_impl_dynarray_header(array);
+    usize              required_count = header->element_count + extra_count;
+    if (yo_likely(required_count <= header->element_capacity)) {
+        return array;
+    }
+    return yo_impl_dynarray_try_reserve(array, yo_max_value(required_count, 2 * header->element_capacity), element_size);
+}
+
+/// Shift the elements starting at `idx` one position to the right. The array should have room for
+/// an extra element.
+yo_api yo_inline void yo_impl_dynarray_open_gap(void* array, usize idx, usize element_size) {
+    yo_DynArrayHeader* header = yo_impl_dynarray_header(array);
+    yo_assert_fmt(idx <= header->element_count, "Index %zu out of bounds.", idx);
+
+    u8* gap = yo_cast(u8*, array) + idx * element_size;
+    yo_memory_move(gap + element_size, gap, (header->element_count - idx) * element_size);
+    ++header->element_count;
+}
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic pop
+#endif
+
+// -----------------------------------------------------------------------------
+// Ring buffer, an array of runtime-known fixed-size infinitely pushable.
+//
+// The capacity is always a power of two, so that the monotonic head and tail counters can be
+// mapped to slots with a mask.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_RingHeader {
+    usize element_capacity;
+    /// Number of elements ever popped.
+    usize head;
+    /// Number of elements ever pushed.
+    usize tail;
+};
+yo_type_alias(yo_RingHeader, struct yo_RingHeader);
+yo_RingHeader* yo_impl_ring_header(void* ring);
+
+/// Generic type alias for ring buffers.
+#define yo_Ring(T) T*
+
+/// Create a new ring buffer, whose capacity is rounded up to a power of two.
+#define yo_make_ring(arena_ptr, T, capacity) yo_cast(T*, yo_impl_make_ring(arena_ptr, capacity, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
+
+/// Get the capacity of the ring buffer.
+#define yo_ring_capacity(ring) ((ring != NULL) ? yo_impl_ring_header(ring)->element_capacity : 0)
+
+/// Get the number of elements currently in the ring buffer.
+#define yo_ring_count(ring) ((ring != NULL) ? (yo_impl_ring_header(ring)->tail - yo_impl_ring_header(ring)->head) : 0)
+
+/// Push an element by value to the back of the ring buffer. If the ring is full, the element at
+/// the front is overwritten.
+#define yo_ring_push(ring, element)                                                         \
+    do {                                                                                    \
+        yo_RingHeader* yo_var_header = yo_impl_ring_header(ring);                           \
+        if (yo_var_header->tail - yo_var_header->head == yo_var_header->element_capacity) { \
+            ++yo_var_header->head;                                                          \
+        }                                                                                   \
+        ring[yo_var_header->tail++ & (yo_var_header->element_capacity - 1)] = element;      \
+    } while (0)
+
+/// Pop the element at the front of the ring buffer into `element_ptr`.
+///
+/// Return: Whether there was an element to be popped.
+#define yo_ring_pop(ring, element_ptr) yo_impl_ring_pop(ring, element_ptr, yo_size_of(*(ring)))
+
+/// Get a pointer to the element at a given position from the front of the ring buffer.
+#define yo_ring_at(ring, idx) (&(ring)[yo_impl_ring_slot(ring, idx)])
+
+/// Remove all elements of the ring buffer.
+#define yo_ring_clear(ring)                                           \
+    do {                                                              \
+        if (ring != NULL) {                                           \
+            yo_RingHeader* yo_var_header = yo_impl_ring_header(ring); \
+            yo_var_header->head          = yo_var_header->tail;       \
+        }                                                             \
+    } while (0)
+
+//
+// Implementation details.
+//
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+yo_api yo_inline yo_RingHeader* yo_impl_ring_header(void* ring) {
+    yo_assert_not_null(ring);
+    return yo_cast(yo_RingHeader*, yo_cast(u8*, ring) - yo_size_of(yo_RingHeader));
+}
+
+yo_api yo_inline usize yo_impl_ring_slot(void* ring, usize idx) {
+    yo_RingHeader* header = yo_impl_ring_header(ring);
+    yo_assert_fmt(idx < header->tail - header->head, "Index %zu out of the ring buffer bounds.", idx);
+    return (header->head + idx) & (header->element_capacity - 1);
+}
+
+/// The header immediately precedes the elements, which are kept aligned.
+yo_api yo_inline
+yo_Ring(u8) yo_impl_make_ring(yo_Arena* arena, usize element_capacity, usize element_size, u32 element_alignment) {
+    yo_assert_not_null(arena);
+
+    usize capacity = 1;
+    while (capacity < element_capacity) {
+        capacity <<= 1;
+    }
+
+    usize header_offset = yo_align_forward(yo_size_of(yo_RingHeader), yo_max_value(element_alignment, yo_align_of(yo_RingHeader)));
+    u8*   memory        = yo_arena_alloc_align(arena, header_offset + element_size * capacity, yo_max_value(element_alignment, yo_cast(u32, yo_align_of(yo_RingHeader))));
+
+    if (yo_likely(memory != NULL)) {
+        memory += header_offset;
+
+        yo_RingHeader* header    = yo_impl_ring_header(memory);
+        header->element_capacity = capacity;
+        header->head             = 0;
+        header->tail             = 0;
+    }
+
+    return memory;
+}
+
+yo_api yo_inline bool yo_impl_ring_pop(void* ring, void* element, usize element_size) {
+    yo_RingHeader* header = yo_impl_ring_header(ring);
+    if (header->head == header->tail) {
+        return false;
+    }
+
+    usize slot = header->head++ & (header->element_capacity - 1);
+    yo_memory_copy(yo_cast(u8*, element), yo_cast(u8 const*, ring) + slot * element_size, element_size);
+    return true;
+}
+
 #if defined(YO_COMPILER_CLANG)
 #    pragma clang diagnostic pop
 #endif
 
 // -----------------------------------------------------------------------------
-// @TODO: Ring buffer, an array of runtime-known fixed-size infinitely pushable.
+// Lock-free single-producer/single-consumer ring buffer.
+//
+// Hands elements from exactly one producer thread to exactly one consumer thread without locks.
+// Each side only writes its own counter, and keeps a cached copy of the counter of the other side
+// so that the shared cache line is only read when the cached value says the ring is full or empty.
+//
+// The fields of each side, and the fields read by both, start their own cache line wherever the
+// ring is placed, so the struct is aligned to the cache line size.
 // -----------------------------------------------------------------------------
 
+struct yo_api yo_SpscRing {
+    /// Read by both sides and never written after the ring is made.
+    yo_align_as(YO_CACHE_LINE_SIZE) u8* buf;
+    usize                               element_size;
+    /// Capacity of the ring, always a power of two.
+    usize                               capacity;
+
+    /// Number of elements ever popped, written by the consumer.
+    yo_align_as(YO_CACHE_LINE_SIZE) usize volatile head;
+    /// Last value of `tail` seen by the consumer.
+    usize                                          cached_tail;
+
+    /// Number of elements ever pushed, written by the producer.
+    yo_align_as(YO_CACHE_LINE_SIZE) usize volatile tail;
+    /// Last value of `head` seen by the producer.
+    usize                                          cached_head;
+};
+yo_type_alias(yo_SpscRing, struct yo_SpscRing);
+
+/// Make a single-producer/single-consumer ring buffer, whose capacity is rounded up to a power of
+/// two.
+yo_api yo_SpscRing yo_make_spsc_ring_align(yo_Arena* arena, usize element_size, u32 alignment, usize capacity);
+
+/// Push an element to the ring. Should only be called by the producer thread.
+///
+/// Return: Whether the element was pushed, which fails if the ring is full.
+yo_api bool yo_spsc_ring_try_push(yo_SpscRing* ring, void const* element);
+
+/// Pop an element from the ring. Should only be called by the consumer thread.
+///
+/// Return: Whether an element was popped, which fails if the ring is empty.
+yo_api bool yo_spsc_ring_try_pop(yo_SpscRing* ring, void* element);
+
+/// Push as many elements as the ring can fit, up to `count`, copying at most two contiguous spans.
+/// Should only be called by the producer thread.
+///
+/// Return: The number of elements pushed.
+yo_api usize yo_spsc_ring_push_bulk(yo_SpscRing* ring, void const* elements, usize count);
+
+/// Pop as many elements as available, up to `max_count`, copying at most two contiguous spans.
+/// Should only be called by the consumer thread.
+///
+/// Return: The number of elements popped.
+yo_api usize yo_spsc_ring_pop_bulk(yo_SpscRing* ring, void* elements, usize max_count);
+
+/// Get the number of elements in the ring. The value may already be outdated when used, if the
+/// other side is active.
+yo_api usize yo_spsc_ring_count(yo_SpscRing const* ring);
+
+#define yo_make_spsc_ring(arena_ptr, T, capacity) yo_make_spsc_ring_align(arena_ptr, yo_size_of(T), yo_cast(u32, yo_align_of(T)), capacity)
+
 #if defined(YO_LANG_CPP)
 }
 #endif
@@ -0,0 +1,159 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Fixed-size object pool allocator.
+/// File name: yoneda_pool.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_POOL_H
+#define YONEDA_POOL_H
+
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Pool allocator.
+// -----------------------------------------------------------------------------
+
+/// Free slot of a pool, storing the link to the next free slot in the slot memory itself.
+struct yo_PoolFreeSlot {
+    struct yo_PoolFreeSlot* next;
+};
+yo_type_alias(yo_PoolFreeSlot, struct yo_PoolFreeSlot);
+
+/// Pool allocator
+///
+/// Allocates fixed-size, aligned slots in O(1) with independent lifetimes: slots can be freed in
+/// any order and are recycled through an intrusive free list. Meant for objects with high churn,
+/// for which neither leaking in an arena nor going to the system allocator is acceptable.
+///
+/// All slots are carved out of a single block allocated from an arena when the pool is created,
+/// thus pointers to slots are stable and can be converted to dense slot indices. Slots are only
+/// touched when first handed out, so the pool can be backed by a reserved arena with a huge
+/// capacity without committing memory for slots that are never used.
+struct yo_api yo_Pool {
+    /// Block of memory containing all slots of the pool.
+    u8*              slots;
+    /// Size of each slot, including the padding required for the slot alignment.
+    usize            slot_size;
+    /// Maximum number of slots of the pool.
+    usize            capacity;
+    /// Number of slots that were ever handed out. Slots past this count are unused.
+    usize            bump_count;
+    /// Number of slots currently allocated.
+    usize            live_count;
+    /// Highest number of simultaneously allocated slots.
+    usize            peak_count;
+    /// Intrusive list of freed slots.
+    yo_PoolFreeSlot* free_list;
+};
+yo_type_alias(yo_Pool, struct yo_Pool);
+
+/// Occupancy statistics of a pool.
+struct yo_api yo_PoolStats {
+    usize slot_size;
+    usize capacity;
+    usize live_count;
+    usize peak_count;
+    /// Number of slots that can still be allocated.
+    usize free_count;
+    /// Ratio between the live slots and the capacity, in the range [0, 1].
+    f32   occupancy;
+};
+yo_type_alias(yo_PoolStats, struct yo_PoolStats);
+
+/// Make a pool with a given slot capacity, whose memory is allocated from an arena.
+///
+/// Parameters:
+///     * arena: The arena allocator providing the memory of the slots.
+///     * slot_size: The size of each slot, at least the size of a pointer.
+///     * alignment: The alignment of each slot, at least the alignment of a pointer.
+///     * capacity: The maximum number of slots.
+yo_api yo_Pool yo_make_pool_align(yo_Arena* arena, usize slot_size, u32 alignment, usize capacity);
+
+/// Allocate a zeroed slot from the pool, or null if the pool is full.
+yo_api u8* yo_pool_alloc_slot(yo_Pool* pool);
+
+/// Return a slot to the pool.
+///
+/// Does nothing if `slot` is a null pointer.
+yo_api void yo_pool_free_slot(yo_Pool* pool, void* slot);
+
+/// Free all slots of the pool at once.
+yo_api void yo_pool_clear(yo_Pool* pool);
+
+/// Query the occupancy statistics of the pool.
+yo_api yo_PoolStats yo_pool_stats(yo_Pool const* pool);
+
+yo_api u8*  yo_impl_pool_allocator_alloc(void* context, usize size_bytes, u32 alignment);
+yo_api u8*  yo_impl_pool_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+yo_api void yo_impl_pool_allocator_free(void* context, void* block, usize size_bytes);
+
+/// Get the allocator interface of a pool.
+///
+/// Requests can't be larger than the slot size of the pool, blocks can only be resized within
+/// their slot.
+yo_api yo_inline yo_Allocator yo_pool_allocator(yo_Pool* pool) {
+    return (yo_Allocator){
+        .context = pool,
+        .alloc   = yo_impl_pool_allocator_alloc,
+        .resize  = yo_impl_pool_allocator_resize,
+        .free    = yo_impl_pool_allocator_free,
+    };
+}
+
+#define yo_make_pool(arena_ptr, T, capacity) yo_make_pool_align(arena_ptr, yo_size_of(T), yo_cast(u32, yo_align_of(T)), capacity)
+
+#define yo_pool_alloc(pool_ptr, T) yo_cast(T*, yo_pool_alloc_slot(pool_ptr))
+
+#define yo_pool_free(pool_ptr, slot_ptr) yo_pool_free_slot(pool_ptr, slot_ptr)
+
+// -----------------------------------------------------------------------------
+// Slot index handles.
+//
+// Slots can be referred to by their dense index in the pool, which is smaller than a pointer and
+// remains meaningful across serialization or when indexing parallel arrays.
+// -----------------------------------------------------------------------------
+
+/// Get the index of a slot of the pool.
+yo_api yo_inline u32 yo_pool_slot_index(yo_Pool const* pool, void const* slot) {
+    usize offset = yo_cast(usize, yo_cast(u8 const*, slot) - pool->slots);
+    yo_assert_msg((offset < pool->bump_count * pool->slot_size) && (offset % pool->slot_size == 0), "Slot doesn't belong to the pool.");
+    return yo_cast(u32, offset / pool->slot_size);
+}
+
+/// Get the slot with a given index in the pool.
+yo_api yo_inline u8* yo_pool_slot_at(yo_Pool const* pool, u32 index) {
+    yo_assert_fmt(index < pool->bump_count, "Slot index %u was never allocated by the pool.", index);
+    return pool->slots + yo_cast(usize, index) * pool->slot_size;
+}
+
+#define yo_pool_at(pool_ptr, T, index) yo_cast(T*, yo_pool_slot_at(pool_ptr, index))
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_POOL_H
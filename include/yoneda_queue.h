@@ -0,0 +1,121 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Bounded lock-free multi-producer/multi-consumer queue.
+/// File name: yoneda_queue.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_QUEUE_H
+#define YONEDA_QUEUE_H
+
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Number of times a blocking operation retries before putting the thread to sleep.
+#define YO_MPMC_QUEUE_SPIN_COUNT 64
+
+// -----------------------------------------------------------------------------
+// Multi-producer/multi-consumer queue.
+// -----------------------------------------------------------------------------
+
+/// Threads sleeping until the queue changes in a given direction.
+struct yo_api yo_MpmcQueueWaiters {
+    /// Futex word, incremented whenever the sleeping threads should recheck the queue.
+    u32 volatile epoch;
+    u32 volatile sleeper_count;
+};
+yo_type_alias(yo_MpmcQueueWaiters, struct yo_MpmcQueueWaiters);
+
+/// Bounded queue that can be pushed and popped by any number of threads without locking.
+///
+/// Each cell of the queue carries a sequence number telling whether the cell is ready to be
+/// written by the producer or read by the consumer of a given position. Producers and consumers
+/// claim positions with a compare-and-swap on their own counter, and hand cells over to each other
+/// by publishing the next sequence number of the cell, so that threads only ever contend on the
+/// counter of their side of the queue.
+///
+/// The blocking operations spin for a while and then sleep on a futex, which is only signaled
+/// when some thread is actually sleeping.
+///
+/// Each counter, the waiters, and the fields that are only read start their own cache line
+/// wherever the queue is placed, so the struct is aligned to the cache line size.
+struct yo_api yo_MpmcQueue {
+    /// Next position to be claimed by a producer.
+    yo_align_as(YO_CACHE_LINE_SIZE) usize volatile enqueue_position;
+
+    /// Next position to be claimed by a consumer.
+    yo_align_as(YO_CACHE_LINE_SIZE) usize volatile dequeue_position;
+
+    /// Consumers waiting for the queue to be non-empty.
+    yo_align_as(YO_CACHE_LINE_SIZE) yo_MpmcQueueWaiters not_empty;
+    /// Producers waiting for the queue to be non-full.
+    yo_MpmcQueueWaiters                                 not_full;
+
+    /// Cells of the queue, each starting with its sequence number followed by the element.
+    yo_align_as(YO_CACHE_LINE_SIZE) u8* cells;
+    usize                               cell_size;
+    usize                               element_offset;
+    usize                               element_size;
+    /// Capacity of the queue, always a power of two.
+    usize                               capacity;
+};
+yo_type_alias(yo_MpmcQueue, struct yo_MpmcQueue);
+
+/// Make a multi-producer/multi-consumer queue, whose capacity is rounded up to a power of two.
+///
+/// Parameters:
+///     * arena: Arena from which the cells of the queue are allocated.
+///     * element_size: Size of each element, in bytes.
+///     * alignment: Alignment of each element.
+///     * capacity: Minimum number of elements the queue can hold.
+yo_api yo_MpmcQueue yo_make_mpmc_queue_align(yo_Arena* arena, usize element_size, u32 alignment, usize capacity);
+
+/// Try to copy an element to the back of the queue.
+///
+/// Return: Whether the element was pushed, which fails only if the queue is full.
+yo_api bool yo_mpmc_queue_try_push(yo_MpmcQueue* queue, void const* element);
+
+/// Try to copy the element at the front of the queue into `element`.
+///
+/// Return: Whether an element was popped, which fails only if the queue is empty.
+yo_api bool yo_mpmc_queue_try_pop(yo_MpmcQueue* queue, void* element);
+
+/// Copy an element to the back of the queue, sleeping while the queue is full.
+yo_api void yo_mpmc_queue_push(yo_MpmcQueue* queue, void const* element);
+
+/// Copy the element at the front of the queue into `element`, sleeping while the queue is empty.
+yo_api void yo_mpmc_queue_pop(yo_MpmcQueue* queue, void* element);
+
+/// Get the number of elements in the queue. Only a snapshot if other threads are using the queue.
+yo_api usize yo_mpmc_queue_count(yo_MpmcQueue const* queue);
+
+#define yo_make_mpmc_queue(arena_ptr, T, capacity) yo_make_mpmc_queue_align(arena_ptr, yo_size_of(T), yo_cast(u32, yo_align_of(T)), capacity)
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_QUEUE_H
@@ -0,0 +1,166 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Size-class slab allocator with thread-local caches.
+/// File name: yoneda_slab.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_SLAB_H
+#define YONEDA_SLAB_H
+
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Size classes.
+//
+// Sizes up to 128 bytes are spaced by 16 bytes, larger sizes have four classes between
+// consecutive powers of two, bounding the internal fragmentation to 25%.
+// -----------------------------------------------------------------------------
+
+#define YO_SLAB_SIZE          yo_kibibytes(64)
+#define YO_SLAB_HEADER_SIZE   YO_CACHE_LINE_SIZE
+#define YO_SLAB_CLASS_COUNT   32
+#define YO_SLAB_MAX_SIZE      8192
+#define YO_SLAB_MAX_ALIGNMENT YO_CACHE_LINE_SIZE
+
+// -----------------------------------------------------------------------------
+// Slab heap.
+// -----------------------------------------------------------------------------
+
+/// Shared state of a size class, guarded by a spin lock.
+struct yo_api yo_SlabClass {
+    yo_SpinLock lock;
+    /// Number of objects exchanged between the class and the thread caches at once.
+    u32         batch_count;
+    /// Objects returned by the thread caches, linked through their first word.
+    u8*         free_list;
+    usize       free_count;
+    /// Range of the current slab that was never handed out.
+    u8*         carve_cursor;
+    u8*         carve_end;
+};
+yo_type_alias(yo_SlabClass, struct yo_SlabClass);
+
+/// Slab heap allocator.
+///
+/// General purpose heap for multi-threaded programs. Small allocations are rounded up to one of the
+/// size classes and served from slabs carved out of a single virtual memory reservation, larger
+/// allocations are mapped directly from the OS.
+///
+/// Each thread has a cache of free objects per size class, so that allocating and freeing an object
+/// doesn't require any synchronization in the common case. Caches exchange batches of objects with
+/// the shared size class state when they run empty or grow too large, which is also how objects
+/// freed by a thread other than the one that allocated them find their way back.
+///
+/// Note: The thread caches aren't released automatically, a thread should call
+///       `yo_slab_thread_flush` before exiting or else its cached objects can't be reused by
+///       other threads.
+struct yo_api yo_SlabHeap {
+    /// Reserved memory range, from which the slabs are taken.
+    u8*            reserve;
+    usize          reserve_size;
+    /// First slab of the reserved range, aligned to YO_SLAB_SIZE.
+    u8*            slabs;
+    usize          slab_capacity;
+    usize volatile slab_count;
+    /// Number of bytes mapped for allocations larger than YO_SLAB_MAX_SIZE.
+    usize volatile large_bytes;
+    yo_SlabClass   classes[YO_SLAB_CLASS_COUNT];
+};
+yo_type_alias(yo_SlabHeap, struct yo_SlabHeap);
+
+/// Usage statistics of a slab heap.
+struct yo_api yo_SlabStats {
+    usize slab_count;
+    usize slab_capacity;
+    /// Number of bytes committed for slabs.
+    usize slab_bytes;
+    /// Number of bytes mapped for allocations larger than YO_SLAB_MAX_SIZE.
+    usize large_bytes;
+};
+yo_type_alias(yo_SlabStats, struct yo_SlabStats);
+
+/// Create a slab heap able to hold up to `reserve_size` bytes of slabs.
+///
+/// The reserved range only has its memory committed as slabs are needed, so that `reserve_size`
+/// can be much larger than the expected memory usage.
+yo_api yo_SlabHeap yo_make_slab_heap(usize reserve_size);
+
+/// Release all memory of the slab heap.
+///
+/// Note: Large allocations that weren't freed are leaked, and all threads that used the heap
+///       should have flushed their caches before the heap is destroyed.
+yo_api void yo_destroy_slab_heap(yo_SlabHeap* heap);
+
+/// Allocate a zeroed block of memory with a given alignment.
+yo_api u8* yo_slab_alloc_align(yo_SlabHeap* heap, usize size_bytes, u32 alignment);
+
+/// Resize a block of memory, in place if the new size fits the size class of the block.
+///
+/// If the block is moved, the contents of the old block are copied to the new one. Bytes past the
+/// current size of the block are zeroed.
+yo_api u8* yo_slab_realloc_align(yo_SlabHeap* heap, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+
+/// Release a block of memory allocated by the heap, possibly from a different thread.
+///
+/// Does nothing if `block` is a null pointer.
+yo_api void yo_slab_free(yo_SlabHeap* heap, void* block);
+
+/// Return all objects cached by the calling thread to the heap the cache is bound to.
+///
+/// A thread cache is bound to a single heap at a time, using a different heap implicitly flushes
+/// the cache.
+yo_api void yo_slab_thread_flush(void);
+
+/// Query the memory usage statistics of the heap.
+yo_api yo_SlabStats yo_slab_stats(yo_SlabHeap const* heap);
+
+/// Get the size of the objects of the size class fitting a given size.
+yo_api usize yo_slab_class_size(usize size_bytes);
+
+yo_api u8*  yo_impl_slab_allocator_alloc(void* context, usize size_bytes, u32 alignment);
+yo_api u8*  yo_impl_slab_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+yo_api void yo_impl_slab_allocator_free(void* context, void* block, usize size_bytes);
+
+/// Get the allocator interface of a slab heap.
+yo_api yo_inline yo_Allocator yo_slab_allocator(yo_SlabHeap* heap) {
+    return (yo_Allocator){
+        .context = heap,
+        .alloc   = yo_impl_slab_allocator_alloc,
+        .resize  = yo_impl_slab_allocator_resize,
+        .free    = yo_impl_slab_allocator_free,
+    };
+}
+
+#define yo_slab_alloc(heap_ptr, T, count) \
+    yo_cast(T*, yo_slab_alloc_align(heap_ptr, yo_size_of(T) * (count), yo_cast(u32, yo_align_of(T))))
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_SLAB_H
@@ -0,0 +1,157 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Slot map with generational handles.
+/// File name: yoneda_slot_map.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_SLOT_MAP_H
+#define YONEDA_SLOT_MAP_H
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Index of a slot that doesn't exist.
+#define YO_SLOT_MAP_INVALID_INDEX yo_cast(u32, 0xFFFFFFFF)
+
+// -----------------------------------------------------------------------------
+// Slot map.
+//
+// Fixed capacity container whose elements are referred to by handles that remain valid until the
+// element is removed. Like arrays, the slot map is a pointer to its elements, preceded by a header:
+// the elements are densely packed in the first `yo_slot_map_count` positions, so that iterating
+// over them is a plain loop over an array.
+//
+// Each handle refers to a slot, which stores the position of the element in the dense array, and
+// carries the generation of the slot when the element was inserted. Removing an element moves the
+// last element into its place and bumps the generation of its slot, so that all handles to the
+// removed element become invalid, even after the slot is reused. A slot whose generation is
+// exhausted is retired rather than reused, which slightly lowers the number of elements the slot
+// map can hold from then on.
+// -----------------------------------------------------------------------------
+
+/// Handle to an element of a slot map.
+struct yo_api yo_SlotHandle {
+    u32 index;
+    /// Generation of the slot, always odd for handles of inserted elements.
+    u32 generation;
+};
+yo_type_alias(yo_SlotHandle, struct yo_SlotHandle);
+
+/// Handle that never refers to an element.
+#define yo_slot_handle_invalid() ((yo_SlotHandle){.index = YO_SLOT_MAP_INVALID_INDEX, .generation = 0})
+
+struct yo_api yo_SlotMapSlot {
+    /// Position of the element of the slot in the dense array, or the next free slot if the slot
+    /// is free.
+    u32 index;
+    /// Incremented at each insertion and removal: odd while the slot holds an element. Zero for
+    /// slots that were never used or were retired.
+    u32 generation;
+};
+yo_type_alias(yo_SlotMapSlot, struct yo_SlotMapSlot);
+
+struct yo_api yo_SlotMapHeader {
+    usize           element_capacity;
+    usize           element_count;
+    yo_SlotMapSlot* slots;
+    /// Slot of each element of the dense array.
+    u32*            dense_slots;
+    /// Number of slots that were ever used.
+    u32             slot_count;
+    /// First slot of the list of free slots.
+    u32             free_slot;
+};
+yo_type_alias(yo_SlotMapHeader, struct yo_SlotMapHeader);
+yo_SlotMapHeader* yo_impl_slot_map_header(void* map);
+
+/// Generic type alias for slot maps.
+#define yo_SlotMap(T) T*
+
+/// Create a new slot map with a given fixed element capacity.
+#define yo_make_slot_map(arena_ptr, T, capacity) \
+    yo_cast(T*, yo_impl_make_slot_map(arena_ptr, capacity, yo_cast(usize, yo_size_of(T)), yo_cast(u32, yo_align_of(T))))
+
+/// Get the fixed capacity of the slot map.
+#define yo_slot_map_capacity(map) ((map != NULL) ? yo_impl_slot_map_header(map)->element_capacity : 0)
+
+/// Get the number of elements of the slot map.
+#define yo_slot_map_count(map) ((map != NULL) ? yo_impl_slot_map_header(map)->element_count : 0)
+
+/// Copy an element into the slot map.
+///
+/// Return: The handle of the new element, or an invalid handle if the slot map is full or its
+///         remaining slots were all retired.
+#define yo_slot_map_insert(map, element_ptr) yo_impl_slot_map_insert(map, element_ptr, yo_size_of(*(map)))
+
+/// Get a pointer to the element of a handle, or null if the handle is no longer valid.
+#define yo_slot_map_get(map, handle) yo_impl_slot_map_get(map, handle, yo_size_of(*(map)))
+
+/// Remove the element of a handle by moving the last element into its place.
+///
+/// Return: Whether the handle was valid.
+#define yo_slot_map_remove(map, handle) yo_impl_slot_map_remove(map, handle, yo_size_of(*(map)))
+
+/// Check whether a handle refers to an element of the slot map.
+yo_api bool yo_slot_map_contains(void const* map, yo_SlotHandle handle);
+
+/// Get the handle of the element at a given position of the dense array.
+yo_api yo_SlotHandle yo_slot_map_handle_at(void const* map, usize idx);
+
+/// Remove all elements, invalidating all handles.
+yo_api void yo_slot_map_clear(void* map);
+
+/// Iterate over the positions of the elements in the dense array.
+#define yo_slot_map_for_index(idx, map) for (usize idx = 0, yo_var_count = yo_slot_map_count(map); idx < yo_var_count; ++idx)
+
+//
+// Implementation details.
+//
+
+yo_api yo_SlotMap(u8) yo_impl_make_slot_map(yo_Arena* arena, usize element_capacity, usize element_size, u32 element_alignment);
+yo_api yo_SlotHandle yo_impl_slot_map_insert(void* map, void const* element, usize element_size);
+yo_api void*         yo_impl_slot_map_get(void* map, yo_SlotHandle handle, usize element_size);
+yo_api bool          yo_impl_slot_map_remove(void* map, yo_SlotHandle handle, usize element_size);
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+yo_api yo_inline yo_SlotMapHeader* yo_impl_slot_map_header(void* map) {
+    yo_assert_not_null(map);
+    return yo_cast(yo_SlotMapHeader*, yo_cast(u8*, map) - yo_size_of(yo_SlotMapHeader));
+}
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic pop
+#endif
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_SLOT_MAP_H
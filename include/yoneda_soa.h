@@ -0,0 +1,141 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Struct-of-arrays containers.
+/// File name: yoneda_soa.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_SOA_H
+#define YONEDA_SOA_H
+
+#include <yoneda_assert.h>
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_log.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Alignment of the columns of struct-of-arrays containers.
+#define YO_SOA_COLUMN_ALIGNMENT YO_CACHE_LINE_SIZE
+
+// -----------------------------------------------------------------------------
+// Struct-of-arrays containers.
+//
+// Fixed capacity containers storing each field of their elements in a separate column, so that
+// loops touching only a few fields don't drag the other ones through the cache. The fields are
+// given by an X-macro, which is passed the macro to apply to each `(Type, name)` pair:
+//
+//     #define yo_particle_fields(X) X(yo_Vec3, position) X(yo_Vec3, velocity) X(f32, mass)
+//
+//     yo_define_soa(yo_Particles, yo_particle_fields)
+//
+// All columns come from a single arena allocation. Each column starts at a cache line boundary
+// and spans a whole number of cache lines, so that the column `soa.name` can be handed directly
+// to SIMD kernels, which may process whole vectors up to `yo_soa_column_capacity(soa, name)`
+// elements without handling a scalar remainder. The elements past `soa.count` are scratch space
+// that is overwritten by the following pushes.
+// -----------------------------------------------------------------------------
+
+/// Define the container `Name`, holding one column `T* name` for each field `X(T, name)` of
+/// `FIELDS`, along with the `count` of elements and their `capacity`.
+///
+/// The generated procedures are:
+///     * `Name Name##_make(yo_Arena* arena, usize capacity)`: Allocate the columns. On failure the
+///       container has zero capacity.
+///     * `bool Name##_push(Name* soa, T0 name0, T1 name1, ...)`: Append an element given by the
+///       value of each of its fields, in the order of `FIELDS`. Returns false if the container is
+///       full.
+///     * `void Name##_remove_swap(Name* soa, usize idx)`: Remove an element by moving the last
+///       element into its place. Doesn't preserve the order of the elements.
+///     * `void Name##_clear(Name* soa)`: Remove all elements.
+#define yo_define_soa(Name, FIELDS)                                                                             \
+    struct Name {                                                                                               \
+        FIELDS(yo_impl_soa_declare_column)                                                                      \
+        usize count;                                                                                            \
+        usize capacity;                                                                                         \
+    };                                                                                                          \
+    yo_type_alias(Name, struct Name);                                                                           \
+                                                                                                                \
+    yo_internal yo_inline Name Name##_make(yo_Arena* arena, usize capacity) {                                   \
+        Name  soa  = {.capacity = capacity};                                                                    \
+        usize size = 0 FIELDS(yo_impl_soa_add_column_size);                                                     \
+        if (size == 0) {                                                                                        \
+            return soa;                                                                                         \
+        }                                                                                                       \
+                                                                                                                \
+        u8* memory = yo_arena_alloc_align(arena, size, YO_SOA_COLUMN_ALIGNMENT);                                \
+        if (yo_unlikely(memory == NULL)) {                                                                      \
+            soa.capacity = 0;                                                                                   \
+            return soa;                                                                                         \
+        }                                                                                                       \
+        FIELDS(yo_impl_soa_assign_column)                                                                       \
+        return soa;                                                                                             \
+    }                                                                                                           \
+                                                                                                                \
+    yo_internal yo_inline bool Name##_push(Name* soa FIELDS(yo_impl_soa_declare_parameter)) {                   \
+        if (yo_unlikely(soa->count == soa->capacity)) {                                                         \
+            yo_log_error_fmt("Cannot push a new element for full " #Name " with capacity %zu.", soa->capacity); \
+            return false;                                                                                       \
+        }                                                                                                       \
+        usize idx = soa->count++;                                                                               \
+        FIELDS(yo_impl_soa_store_parameter)                                                                     \
+        return true;                                                                                            \
+    }                                                                                                           \
+                                                                                                                \
+    yo_internal yo_inline void Name##_remove_swap(Name* soa, usize idx) {                                       \
+        yo_assert_fmt(idx < soa->count, "Index %zu out of bounds.", idx);                                       \
+        usize last = --soa->count;                                                                              \
+        FIELDS(yo_impl_soa_move_last)                                                                           \
+    }                                                                                                           \
+                                                                                                                \
+    yo_internal yo_inline void Name##_clear(Name* soa) {                                                        \
+        soa->count = 0;                                                                                         \
+    }
+
+/// Get the number of elements that fit in the allocated cache lines of a column, which is at least
+/// the capacity of the container.
+#define yo_soa_column_capacity(soa, name)                                                        \
+    (yo_impl_soa_column_size(yo_size_of(*(soa).name), (soa).capacity) / yo_size_of(*(soa).name))
+
+//
+// Implementation details.
+//
+
+#define yo_impl_soa_column_size(element_size, capacity) yo_align_forward((element_size) * (capacity), YO_SOA_COLUMN_ALIGNMENT)
+
+#define yo_impl_soa_declare_column(T, name)    T* name;
+#define yo_impl_soa_add_column_size(T, name)   + yo_impl_soa_column_size(yo_size_of(T), capacity)
+#define yo_impl_soa_declare_parameter(T, name) , T name
+#define yo_impl_soa_store_parameter(T, name)   soa->name[idx] = name;
+#define yo_impl_soa_move_last(T, name)         soa->name[idx] = soa->name[last];
+#define yo_impl_soa_assign_column(T, name)                          \
+    yo_constexpr_assert(yo_align_of(T) <= YO_SOA_COLUMN_ALIGNMENT); \
+    soa.name = yo_cast(T*, yo_cast(void*, memory));                 \
+    memory += yo_impl_soa_column_size(yo_size_of(T), capacity);
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_SOA_H
@@ -0,0 +1,686 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Sorting algorithms.
+/// File name: yoneda_sort.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_SORT_H
+#define YONEDA_SORT_H
+
+#include <yoneda_assert.h>
+#include <yoneda_bit.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_thread.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+/// Element count up to which radix sorts fall back to an insertion sort.
+#if !defined(YO_RADIX_SORT_INSERTION_THRESHOLD)
+#    define YO_RADIX_SORT_INSERTION_THRESHOLD 64
+#endif
+
+// -----------------------------------------------------------------------------
+// Radix sort.
+//
+// Least significant digit radix sort with 8-bit digits. The histograms of all digits are counted
+// in a single pass over the input, and passes whose digit is the same for every element are
+// skipped. Elements are scattered back and forth between the input and a temporary buffer
+// allocated from a scratch arena of the current thread.
+//
+// Signed integers are sorted in numeric order. Floating point numbers are sorted by their total
+// order: negative zero comes before positive zero, and NaNs are placed at either end according
+// to their sign.
+// -----------------------------------------------------------------------------
+
+/// Key associated to the index of an element, used to sort elements by a key without moving them.
+struct yo_api yo_KeyIndex {
+    u32 key;
+    u32 index;
+};
+yo_type_alias(yo_KeyIndex, struct yo_KeyIndex);
+
+/// Sort values in ascending order.
+///
+/// Return: Whether the values were sorted, which only fails if the temporary buffer couldn't be
+///         allocated.
+yo_api bool yo_radix_sort_u32(u32* values, usize count);
+yo_api bool yo_radix_sort_u64(u64* values, usize count);
+yo_api bool yo_radix_sort_i32(i32* values, usize count);
+yo_api bool yo_radix_sort_f32(f32* values, usize count);
+
+/// Sort pairs in ascending order of their keys. The sort is stable: pairs with equal keys keep
+/// their relative order.
+///
+/// Return: Whether the pairs were sorted, which only fails if the temporary buffer couldn't be
+///         allocated.
+yo_api bool yo_radix_sort_key_index(yo_KeyIndex* pairs, usize count);
+
+/// Sort a whole buffer, where `Kind` is one of `u32`, `u64`, `i32`, `f32`, or `key_index`.
+#define yo_radix_sort_buffer(Kind, buffer) yo_radix_sort_##Kind(buffer, yo_buffer_count(buffer))
+
+// -----------------------------------------------------------------------------
+// Comparison sorts.
+//
+// Sorting procedures generated for a given element type and ordering, so that elements are
+// compared and swapped inline, with no indirect calls and no byte-wise copies.
+//
+// The unstable sort is a pattern-defeating quicksort: already sorted runs, runs with many equal
+// elements and adversarial inputs are all detected, and the worst case is bounded by falling back
+// to a heap sort. The stable sort is a merge sort whose temporary buffer, of half the element
+// count, is allocated from an arena and released before returning.
+// -----------------------------------------------------------------------------
+
+/// Element count below which comparison sorts use an insertion sort.
+#if !defined(YO_SORT_INSERTION_THRESHOLD)
+#    define YO_SORT_INSERTION_THRESHOLD 24
+#endif
+
+/// Element count above which the pivot is chosen as the median of three medians.
+#if !defined(YO_SORT_NINTHER_THRESHOLD)
+#    define YO_SORT_NINTHER_THRESHOLD 128
+#endif
+
+/// Maximum number of elements moved by an insertion sort trying to finish an almost sorted run.
+#define YO_SORT_PARTIAL_INSERTION_LIMIT 8
+
+/// Swap two elements of type `T` given by pointers.
+#define yo_sort_swap(T, lhs_ptr, rhs_ptr) \
+    do {                                  \
+        T* yo_var_lhs = (lhs_ptr);        \
+        T* yo_var_rhs = (rhs_ptr);        \
+        T  yo_var_tmp = *yo_var_lhs;      \
+        *yo_var_lhs   = *yo_var_rhs;      \
+        *yo_var_rhs   = yo_var_tmp;       \
+    } while (0)
+
+/// Define the sorting procedures `Name##_sort` and `Name##_stable_sort` for elements of type `T`.
+///
+/// Parameters:
+///     * is_less: Function or macro taking two `T const*` and returning whether the first element
+///                should come strictly before the second one. The arguments never have side
+///                effects, so a macro may expand them more than once.
+///
+/// The generated procedures are:
+///     * `void Name##_sort(T* elements, usize count)`: Unstable sort, never allocates.
+///     * `bool Name##_stable_sort(T* elements, usize count, yo_Arena* arena)`: Stable sort whose
+///       temporary buffer comes from the arena. Returns false, leaving the elements unsorted, if
+///       the buffer couldn't be allocated.
+#define yo_define_sort(Name, T, is_less)            \
+    yo_impl_define_sort_insertion(Name, T, is_less) \
+    yo_impl_define_sort_heap(Name, T, is_less)      \
+    yo_impl_define_sort_partition(Name, T, is_less) \
+    yo_impl_define_sort_pdq(Name, T, is_less)       \
+    yo_impl_define_sort_merge(Name, T, is_less)
+
+/// Sort a whole buffer with procedures generated by `yo_define_sort`.
+#define yo_sort_buffer(Name, buffer)               Name##_sort(buffer, yo_buffer_count(buffer))
+#define yo_stable_sort_buffer(Name, buffer, arena) Name##_stable_sort(buffer, yo_buffer_count(buffer), arena)
+
+//
+// Implementation details.
+//
+
+#define yo_impl_define_sort_insertion(Name, T, is_less)                                         \
+    /* Sort a range, assuming nothing about its surroundings. */                                \
+    yo_internal yo_inline void Name##_impl_insertion_sort(T* begin, T* end) {                   \
+        if (begin == end) {                                                                     \
+            return;                                                                             \
+        }                                                                                       \
+        for (T* current = begin + 1; current != end; ++current) {                               \
+            T* sift = current;                                                                  \
+            if (is_less(sift, sift - 1)) {                                                      \
+                T tmp = *sift;                                                                  \
+                do {                                                                            \
+                    *sift = *(sift - 1);                                                        \
+                    --sift;                                                                     \
+                } while ((sift != begin) && is_less(&tmp, sift - 1));                           \
+                *sift = tmp;                                                                    \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    /* Sort a range preceded by an element that isn't greater than any of its elements. */      \
+    yo_internal yo_inline void Name##_impl_unguarded_insertion_sort(T* begin, T* end) {         \
+        if (begin == end) {                                                                     \
+            return;                                                                             \
+        }                                                                                       \
+        for (T* current = begin + 1; current != end; ++current) {                               \
+            T* sift = current;                                                                  \
+            if (is_less(sift, sift - 1)) {                                                      \
+                T tmp = *sift;                                                                  \
+                do {                                                                            \
+                    *sift = *(sift - 1);                                                        \
+                    --sift;                                                                     \
+                } while (is_less(&tmp, sift - 1));                                              \
+                *sift = tmp;                                                                    \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    /* Try to sort an almost sorted range, giving up once too many elements have been moved. */ \
+    yo_internal yo_inline bool Name##_impl_partial_insertion_sort(T* begin, T* end) {           \
+        if (begin == end) {                                                                     \
+            return true;                                                                        \
+        }                                                                                       \
+        usize moved_count = 0;                                                                  \
+        for (T* current = begin + 1; current != end; ++current) {                               \
+            T* sift = current;                                                                  \
+            if (is_less(sift, sift - 1)) {                                                      \
+                T tmp = *sift;                                                                  \
+                do {                                                                            \
+                    *sift = *(sift - 1);                                                        \
+                    --sift;                                                                     \
+                } while ((sift != begin) && is_less(&tmp, sift - 1));                           \
+                *sift        = tmp;                                                             \
+                moved_count += yo_cast(usize, current - sift);                                  \
+            }                                                                                   \
+            if (moved_count > YO_SORT_PARTIAL_INSERTION_LIMIT) {                                \
+                return false;                                                                   \
+            }                                                                                   \
+        }                                                                                       \
+        return true;                                                                            \
+    }
+
+#define yo_impl_define_sort_heap(Name, T, is_less)                                           \
+    yo_internal yo_inline void Name##_impl_sift_down(T* elements, usize root, usize count) { \
+        for (;;) {                                                                           \
+            usize child = 2 * root + 1;                                                      \
+            if (child >= count) {                                                            \
+                break;                                                                       \
+            }                                                                                \
+            if ((child + 1 < count) && is_less(elements + child, elements + child + 1)) {    \
+                ++child;                                                                     \
+            }                                                                                \
+            if (!is_less(elements + root, elements + child)) {                               \
+                break;                                                                       \
+            }                                                                                \
+            yo_sort_swap(T, elements + root, elements + child);                              \
+            root = child;                                                                    \
+        }                                                                                    \
+    }                                                                                        \
+                                                                                             \
+    yo_internal yo_inline void Name##_impl_heap_sort(T* begin, T* end) {                     \
+        usize count = yo_cast(usize, end - begin);                                           \
+        for (usize idx = count / 2; idx-- > 0;) {                                            \
+            Name##_impl_sift_down(begin, idx, count);                                        \
+        }                                                                                    \
+        for (usize idx = count; idx-- > 1;) {                                                \
+            yo_sort_swap(T, begin, begin + idx);                                             \
+            Name##_impl_sift_down(begin, 0, idx);                                            \
+        }                                                                                    \
+    }
+
+#define yo_impl_define_sort_partition(Name, T, is_less)                                                 \
+    yo_internal yo_inline void Name##_impl_sort3(T* a, T* b, T* c) {                                    \
+        if (is_less(b, a)) {                                                                            \
+            yo_sort_swap(T, a, b);                                                                      \
+        }                                                                                               \
+        if (is_less(c, b)) {                                                                            \
+            yo_sort_swap(T, b, c);                                                                      \
+        }                                                                                               \
+        if (is_less(b, a)) {                                                                            \
+            yo_sort_swap(T, a, b);                                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    /* Partition around the pivot at `begin`, placing elements equal to the pivot to the right. */      \
+    /* Requires an element not less than the pivot to exist in the range. */                            \
+    yo_internal yo_inline T* Name##_impl_partition_right(T* begin, T* end, bool* already_partitioned) { \
+        T  pivot = *begin;                                                                              \
+        T* first = begin;                                                                               \
+        T* last  = end;                                                                                 \
+                                                                                                        \
+        do {                                                                                            \
+            ++first;                                                                                    \
+        } while (is_less(first, &pivot));                                                               \
+        if (first - 1 == begin) {                                                                       \
+            while (first < last) {                                                                      \
+                --last;                                                                                 \
+                if (is_less(last, &pivot)) {                                                            \
+                    break;                                                                              \
+                }                                                                                       \
+            }                                                                                           \
+        } else {                                                                                        \
+            do {                                                                                        \
+                --last;                                                                                 \
+            } while (!is_less(last, &pivot));                                                           \
+        }                                                                                               \
+                                                                                                        \
+        *already_partitioned = (first >= last);                                                         \
+        while (first < last) {                                                                          \
+            yo_sort_swap(T, first, last);                                                               \
+            do {                                                                                        \
+                ++first;                                                                                \
+            } while (is_less(first, &pivot));                                                           \
+            do {                                                                                        \
+                --last;                                                                                 \
+            } while (!is_less(last, &pivot));                                                           \
+        }                                                                                               \
+                                                                                                        \
+        T* pivot_position = first - 1;                                                                  \
+        *begin            = *pivot_position;                                                            \
+        *pivot_position   = pivot;                                                                      \
+        return pivot_position;                                                                          \
+    }                                                                                                   \
+                                                                                                        \
+    /* Partition around the pivot at `begin`, placing elements equal to the pivot to the left. */       \
+    /* Requires the range to be preceded by an element not less than the pivot. */                      \
+    yo_internal yo_inline T* Name##_impl_partition_left(T* begin, T* end) {                             \
+        T  pivot = *begin;                                                                              \
+        T* first = begin;                                                                               \
+        T* last  = end;                                                                                 \
+                                                                                                        \
+        do {                                                                                            \
+            --last;                                                                                     \
+        } while (is_less(&pivot, last));                                                                \
+        if (last + 1 == end) {                                                                          \
+            while (first < last) {                                                                      \
+                ++first;                                                                                \
+                if (is_less(&pivot, first)) {                                                           \
+                    break;                                                                              \
+                }                                                                                       \
+            }                                                                                           \
+        } else {                                                                                        \
+            do {                                                                                        \
+                ++first;                                                                                \
+            } while (!is_less(&pivot, first));                                                          \
+        }                                                                                               \
+                                                                                                        \
+        while (first < last) {                                                                          \
+            yo_sort_swap(T, first, last);                                                               \
+            do {                                                                                        \
+                --last;                                                                                 \
+            } while (is_less(&pivot, last));                                                            \
+            do {                                                                                        \
+                ++first;                                                                                \
+            } while (!is_less(&pivot, first));                                                          \
+        }                                                                                               \
+                                                                                                        \
+        *begin = *last;                                                                                 \
+        *last  = pivot;                                                                                 \
+        return last;                                                                                    \
+    }
+
+#define yo_impl_define_sort_pdq(Name, T, is_less)                                                   \
+    yo_internal void Name##_impl_pdq_sort(T* begin, T* end, u32 bad_allowed, bool leftmost) {       \
+        for (;;) {                                                                                  \
+            usize size = yo_cast(usize, end - begin);                                               \
+            if (size < YO_SORT_INSERTION_THRESHOLD) {                                               \
+                if (leftmost) {                                                                     \
+                    Name##_impl_insertion_sort(begin, end);                                         \
+                } else {                                                                            \
+                    Name##_impl_unguarded_insertion_sort(begin, end);                               \
+                }                                                                                   \
+                return;                                                                             \
+            }                                                                                       \
+                                                                                                    \
+            /* Move the pivot to the start of the range. */                                         \
+            usize half = size / 2;                                                                  \
+            if (size > YO_SORT_NINTHER_THRESHOLD) {                                                 \
+                Name##_impl_sort3(begin, begin + half, end - 1);                                    \
+                Name##_impl_sort3(begin + 1, begin + (half - 1), end - 2);                          \
+                Name##_impl_sort3(begin + 2, begin + (half + 1), end - 3);                          \
+                Name##_impl_sort3(begin + (half - 1), begin + half, begin + (half + 1));            \
+                yo_sort_swap(T, begin, begin + half);                                               \
+            } else {                                                                                \
+                Name##_impl_sort3(begin + half, begin, end - 1);                                    \
+            }                                                                                       \
+                                                                                                    \
+            /* If the pivot equals the element preceding the range, which is the pivot of a */      \
+            /* previous partition, no element of the range is less than it: skip the equal ones. */ \
+            if (!leftmost && !is_less(begin - 1, begin)) {                                          \
+                begin = Name##_impl_partition_left(begin, end) + 1;                                 \
+                continue;                                                                           \
+            }                                                                                       \
+                                                                                                    \
+            bool  already_partitioned;                                                              \
+            T*    pivot_position = Name##_impl_partition_right(begin, end, &already_partitioned);   \
+            usize left_size      = yo_cast(usize, pivot_position - begin);                          \
+            usize right_size     = yo_cast(usize, end - (pivot_position + 1));                      \
+                                                                                                    \
+            if ((left_size < size / 8) || (right_size < size / 8)) {                                \
+                /* Too many unbalanced partitions mean an adversarial input. */                     \
+                if (--bad_allowed == 0) {                                                           \
+                    Name##_impl_heap_sort(begin, end);                                              \
+                    return;                                                                         \
+                }                                                                                   \
+                                                                                                    \
+                /* Break patterns that could produce the same bad pivot again. */                   \
+                if (left_size >= YO_SORT_INSERTION_THRESHOLD) {                                     \
+                    usize quarter = left_size / 4;                                                  \
+                    yo_sort_swap(T, begin, begin + quarter);                                        \
+                    yo_sort_swap(T, pivot_position - 1, pivot_position - quarter);                  \
+                    if (left_size > YO_SORT_NINTHER_THRESHOLD) {                                    \
+                        yo_sort_swap(T, begin + 1, begin + (quarter + 1));                          \
+                        yo_sort_swap(T, begin + 2, begin + (quarter + 2));                          \
+                        yo_sort_swap(T, pivot_position - 2, pivot_position - (quarter + 1));        \
+                        yo_sort_swap(T, pivot_position - 3, pivot_position - (quarter + 2));        \
+                    }                                                                               \
+                }                                                                                   \
+                if (right_size >= YO_SORT_INSERTION_THRESHOLD) {                                    \
+                    usize quarter = right_size / 4;                                                 \
+                    yo_sort_swap(T, pivot_position + 1, pivot_position + (1 + quarter));            \
+                    yo_sort_swap(T, end - 1, end - quarter);                                        \
+                    if (right_size > YO_SORT_NINTHER_THRESHOLD) {                                   \
+                        yo_sort_swap(T, pivot_position + 2, pivot_position + (2 + quarter));        \
+                        yo_sort_swap(T, pivot_position + 3, pivot_position + (3 + quarter));        \
+                        yo_sort_swap(T, end - 2, end - (1 + quarter));                              \
+                        yo_sort_swap(T, end - 3, end - (2 + quarter));                              \
+                    }                                                                               \
+                }                                                                                   \
+            } else if (already_partitioned                                                          \
+                       && Name##_impl_partial_insertion_sort(begin, pivot_position)                 \
+                       && Name##_impl_partial_insertion_sort(pivot_position + 1, end)) {            \
+                /* The range was already sorted, or close enough to it. */                          \
+                return;                                                                             \
+            }                                                                                       \
+                                                                                                    \
+            /* Recurse into the left partition and keep looping on the right one. */                \
+            Name##_impl_pdq_sort(begin, pivot_position, bad_allowed, leftmost);                     \
+            begin    = pivot_position + 1;                                                          \
+            leftmost = false;                                                                       \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    yo_internal yo_inline void Name##_sort(T* elements, usize count) {                              \
+        if (count < 2) {                                                                            \
+            return;                                                                                 \
+        }                                                                                           \
+        yo_assert_not_null(elements);                                                               \
+        Name##_impl_pdq_sort(elements, elements + count, yo_u64_msb_index(count) + 1, true);        \
+    }
+
+#define yo_impl_define_sort_merge(Name, T, is_less)                                                     \
+    /* Sort a range using a buffer that can hold half of its elements. */                               \
+    yo_internal void Name##_impl_merge_sort(T* elements, usize count, T* buffer) {                      \
+        if (count < YO_SORT_INSERTION_THRESHOLD) {                                                      \
+            Name##_impl_insertion_sort(elements, elements + count);                                     \
+            return;                                                                                     \
+        }                                                                                               \
+                                                                                                        \
+        usize left_count = count / 2;                                                                   \
+        T*    right      = elements + left_count;                                                       \
+        T*    end        = elements + count;                                                            \
+        Name##_impl_merge_sort(elements, left_count, buffer);                                           \
+        Name##_impl_merge_sort(right, count - left_count, buffer);                                      \
+        if (!is_less(right, right - 1)) {                                                               \
+            return;                                                                                     \
+        }                                                                                               \
+                                                                                                        \
+        /* Move the left half out of the way and merge both halves back into place. */                  \
+        yo_memory_copy(yo_cast(u8*, buffer), yo_cast(u8 const*, elements), left_count * yo_size_of(T)); \
+        T* left     = buffer;                                                                           \
+        T* left_end = buffer + left_count;                                                              \
+        T* out      = elements;                                                                         \
+        while ((left < left_end) && (right < end)) {                                                    \
+            *out++ = is_less(right, left) ? *right++ : *left++;                                         \
+        }                                                                                               \
+        while (left < left_end) {                                                                       \
+            *out++ = *left++;                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    yo_internal yo_inline bool Name##_stable_sort(T* elements, usize count, yo_Arena* arena) {          \
+        if (count < YO_SORT_INSERTION_THRESHOLD) {                                                      \
+            Name##_impl_insertion_sort(elements, elements + count);                                     \
+            return true;                                                                                \
+        }                                                                                               \
+        yo_assert_not_null(elements);                                                                   \
+                                                                                                        \
+        yo_ArenaCheckpoint checkpoint = yo_make_arena_checkpoint(arena);                                \
+        T*                 buffer     = yo_arena_alloc_uninit(arena, T, count / 2);                     \
+        if (yo_unlikely(buffer == NULL)) {                                                              \
+            return false;                                                                               \
+        }                                                                                               \
+        Name##_impl_merge_sort(elements, count, buffer);                                                \
+        yo_arena_checkpoint_restore(checkpoint);                                                        \
+        return true;                                                                                    \
+    }
+
+// -----------------------------------------------------------------------------
+// Parallel sort.
+//
+// Sample sort over multiple threads, generated for the procedures of a `yo_define_sort`. The
+// threads are spawned once and go through all phases together, waiting on a barrier in between:
+//     1. The elements are split into one chunk per thread, and each thread sorts its chunk and
+//        takes evenly spaced samples of it.
+//     2. The last thread to finish its chunk sorts the samples, which give the splitters between
+//        the buckets of the output, one bucket per thread.
+//     3. Each thread finds the runs of its bucket in all chunks and gathers them into a temporary
+//        buffer.
+//     4. Each thread merges the runs of its bucket back into the elements.
+// Every phase but the second runs on all threads, so the sort scales with the thread count as long
+// as the buckets are balanced. Inputs dominated by a few repeated values produce unbalanced buckets.
+// -----------------------------------------------------------------------------
+
+/// Maximum number of threads used by a parallel sort.
+#if !defined(YO_PARALLEL_SORT_MAX_THREAD_COUNT)
+#    define YO_PARALLEL_SORT_MAX_THREAD_COUNT 64
+#endif
+
+/// Minimum number of elements sorted by each thread of a parallel sort.
+#if !defined(YO_PARALLEL_SORT_MIN_THREAD_ELEMENT_COUNT)
+#    define YO_PARALLEL_SORT_MIN_THREAD_ELEMENT_COUNT 16384
+#endif
+
+/// State shared by the threads of a parallel sort.
+struct yo_api yo_ParallelSortContext {
+    void*        elements;
+    usize        count;
+    /// Temporary buffer with the same size as the elements.
+    void*        buffer;
+    /// Samples of each chunk, `thread_count - 1` per chunk.
+    void*        samples;
+    u32          thread_count;
+    yo_Barrier   barrier;
+    /// Futex word, set to 1 once the thread count is final and the threads may start.
+    u32 volatile started;
+};
+yo_type_alias(yo_ParallelSortContext, struct yo_ParallelSortContext);
+
+struct yo_api yo_ParallelSortTask {
+    yo_ParallelSortContext* context;
+    u32                     thread_index;
+};
+yo_type_alias(yo_ParallelSortTask, struct yo_ParallelSortTask);
+
+/// Define the procedure `Name##_parallel_sort` for the procedures generated by
+/// `yo_define_sort(Name, T, is_less)`.
+///
+/// The generated procedure is:
+///     * `bool Name##_parallel_sort(T* elements, usize count, u32 thread_count, yo_Arena* arena)`:
+///       Unstable sort using up to `thread_count` threads, including the calling one. The temporary
+///       buffer, as large as the elements, comes from the arena. Returns false, leaving the
+///       elements unsorted, if the buffer couldn't be allocated.
+#define yo_define_parallel_sort(Name, T, is_less)         \
+    yo_impl_define_parallel_sort_worker(Name, T, is_less) \
+    yo_impl_define_parallel_sort(Name, T, is_less)
+
+/// Sort a whole buffer with a procedure generated by `yo_define_parallel_sort`.
+#define yo_parallel_sort_buffer(Name, buffer, thread_count, arena) \
+    Name##_parallel_sort(buffer, yo_buffer_count(buffer), thread_count, arena)
+
+//
+// Implementation details.
+//
+
+/// Spawn the threads of a parallel sort and run `worker` on each of them, the first task running on
+/// the calling thread. If a thread can't be created, the sort goes on with the threads spawned so
+/// far, the context getting the final thread count before any worker starts.
+yo_api void yo_impl_parallel_sort_run(yo_ParallelSortContext* context, yo_ThreadProc* worker);
+
+/// Block a worker until the thread count of the context is final.
+yo_api void yo_impl_parallel_sort_wait_start(yo_ParallelSortContext* context);
+
+#define yo_impl_define_parallel_sort_worker(Name, T, is_less)                                                              \
+    /* Index of the first element of a sorted chunk that comes after the splitter. */                                      \
+    yo_internal usize Name##_impl_parallel_sort_split(T const* chunk, usize chunk_size, T const* splitter) {               \
+        usize low  = 0;                                                                                                    \
+        usize high = chunk_size;                                                                                           \
+        while (low < high) {                                                                                               \
+            usize middle = low + (high - low) / 2;                                                                         \
+            if (is_less(splitter, chunk + middle)) {                                                                       \
+                high = middle;                                                                                             \
+            } else {                                                                                                       \
+                low = middle + 1;                                                                                          \
+            }                                                                                                              \
+        }                                                                                                                  \
+        return low;                                                                                                        \
+    }                                                                                                                      \
+                                                                                                                           \
+    /* Merge the sorted runs of the buffer back into the elements, alternating between the two. */                         \
+    yo_internal void Name##_impl_parallel_sort_merge(T* elements, T* buffer, usize* run_bounds, u32 run_count) {           \
+        usize offset = run_bounds[run_count];                                                                              \
+        T*    src    = buffer;                                                                                             \
+        T*    dst    = elements;                                                                                           \
+        while (run_count > 1) {                                                                                            \
+            u32 merged_count = 0;                                                                                          \
+            for (u32 run = 0; run < run_count; run += 2) {                                                                 \
+                usize    start     = run_bounds[run];                                                                      \
+                usize    middle    = run_bounds[run + 1];                                                                  \
+                usize    end       = (run + 1 < run_count) ? run_bounds[run + 2] : middle;                                 \
+                T const* left      = src + start;                                                                          \
+                T const* left_end  = src + middle;                                                                         \
+                T const* right     = left_end;                                                                             \
+                T const* right_end = src + end;                                                                            \
+                T*       out       = dst + start;                                                                          \
+                while ((left < left_end) && (right < right_end)) {                                                         \
+                    *out++ = is_less(right, left) ? *right++ : *left++;                                                    \
+                }                                                                                                          \
+                while (left < left_end) {                                                                                  \
+                    *out++ = *left++;                                                                                      \
+                }                                                                                                          \
+                while (right < right_end) {                                                                                \
+                    *out++ = *right++;                                                                                     \
+                }                                                                                                          \
+                run_bounds[merged_count++] = start;                                                                        \
+            }                                                                                                              \
+            run_bounds[merged_count] = offset;                                                                             \
+            run_count                = merged_count;                                                                       \
+                                                                                                                           \
+            T* swap = src;                                                                                                 \
+            src     = dst;                                                                                                 \
+            dst     = swap;                                                                                                \
+        }                                                                                                                  \
+                                                                                                                           \
+        if (src != elements) {                                                                                             \
+            yo_memory_copy(yo_cast(u8*, elements), yo_cast(u8 const*, src), offset * yo_size_of(T));                       \
+        }                                                                                                                  \
+    }                                                                                                                      \
+                                                                                                                           \
+    yo_internal void Name##_impl_parallel_sort_worker(void* user_data) {                                                   \
+        yo_ParallelSortTask const* task    = yo_cast(yo_ParallelSortTask const*, user_data);                               \
+        yo_ParallelSortContext*    context = task->context;                                                                \
+        yo_impl_parallel_sort_wait_start(context);                                                                         \
+                                                                                                                           \
+        u32   thread_count = context->thread_count;                                                                        \
+        u32   sample_count = thread_count - 1;                                                                             \
+        u32   bucket       = task->thread_index;                                                                           \
+        usize count        = context->count;                                                                               \
+        T*    elements     = yo_cast(T*, context->elements);                                                               \
+        T*    buffer       = yo_cast(T*, context->buffer);                                                                 \
+        T*    samples      = yo_cast(T*, context->samples);                                                                \
+                                                                                                                           \
+        /* Sort the chunk of the thread and take evenly spaced samples of it. */                                           \
+        usize chunk_start = count * bucket / thread_count;                                                                 \
+        usize chunk_size  = count * (bucket + 1) / thread_count - chunk_start;                                             \
+        Name##_sort(elements + chunk_start, chunk_size);                                                                   \
+        for (u32 idx = 0; idx < sample_count; ++idx) {                                                                     \
+            samples[bucket * sample_count + idx] = elements[chunk_start + chunk_size * (idx + 1) / thread_count];          \
+        }                                                                                                                  \
+        if (yo_barrier_wait(&context->barrier)) {                                                                          \
+            Name##_sort(samples, thread_count * sample_count);                                                             \
+        }                                                                                                                  \
+        yo_discard_value(yo_barrier_wait(&context->barrier));                                                              \
+                                                                                                                           \
+        /* Find the run of the bucket in each chunk, elements equal to a splitter going to the lower bucket. */            \
+        T const* splitters    = samples + sample_count / 2;                                                                \
+        usize    run_starts[YO_PARALLEL_SORT_MAX_THREAD_COUNT];                                                            \
+        usize    run_bounds[YO_PARALLEL_SORT_MAX_THREAD_COUNT + 1];                                                        \
+        usize    bucket_start = 0;                                                                                         \
+        usize    offset       = 0;                                                                                         \
+        for (u32 chunk = 0; chunk < thread_count; ++chunk) {                                                               \
+            usize    start     = count * chunk / thread_count;                                                             \
+            usize    size      = count * (chunk + 1) / thread_count - start;                                               \
+            T const* begin     = elements + start;                                                                         \
+            usize    run_start = 0;                                                                                        \
+            usize    run_end   = size;                                                                                     \
+            if (bucket != 0) {                                                                                             \
+                run_start = Name##_impl_parallel_sort_split(begin, size, splitters + bucket * sample_count);               \
+            }                                                                                                              \
+            if (bucket != sample_count) {                                                                                  \
+                run_end = Name##_impl_parallel_sort_split(begin, size, splitters + (bucket + 1) * sample_count);           \
+            }                                                                                                              \
+            /* The bucket starts after the runs of the lower buckets in every chunk. */                                    \
+            run_starts[chunk] = start + run_start;                                                                         \
+            run_bounds[chunk] = offset;                                                                                    \
+            bucket_start += run_start;                                                                                     \
+            offset += run_end - run_start;                                                                                 \
+        }                                                                                                                  \
+        run_bounds[thread_count] = offset;                                                                                 \
+                                                                                                                           \
+        /* Every run must be gathered into the buffer before any bucket is merged over the chunks. */                      \
+        for (u32 chunk = 0; chunk < thread_count; ++chunk) {                                                               \
+            usize run_size = run_bounds[chunk + 1] - run_bounds[chunk];                                                    \
+            T*    dst      = buffer + bucket_start + run_bounds[chunk];                                                    \
+            yo_memory_copy(yo_cast(u8*, dst), yo_cast(u8 const*, elements + run_starts[chunk]), run_size * yo_size_of(T)); \
+        }                                                                                                                  \
+        yo_discard_value(yo_barrier_wait(&context->barrier));                                                              \
+                                                                                                                           \
+        Name##_impl_parallel_sort_merge(elements + bucket_start, buffer + bucket_start, run_bounds, thread_count);         \
+    }
+
+#define yo_impl_define_parallel_sort(Name, T, is_less)                                                              \
+    yo_internal bool Name##_parallel_sort(T* elements, usize count, u32 thread_count, yo_Arena* arena) {            \
+        thread_count = yo_min_value(thread_count, YO_PARALLEL_SORT_MAX_THREAD_COUNT);                               \
+        thread_count = yo_cast(u32, yo_min_value(thread_count, count / YO_PARALLEL_SORT_MIN_THREAD_ELEMENT_COUNT)); \
+        if (thread_count <= 1) {                                                                                    \
+            Name##_sort(elements, count);                                                                           \
+            return true;                                                                                            \
+        }                                                                                                           \
+                                                                                                                    \
+        yo_ArenaCheckpoint     checkpoint = yo_make_arena_checkpoint(arena);                                        \
+        yo_ParallelSortContext context    = {                                                                       \
+            .elements     = elements,                                                                               \
+            .count        = count,                                                                                  \
+            .buffer       = yo_arena_alloc_uninit(arena, T, count),                                                 \
+            .samples      = yo_arena_alloc_uninit(arena, T, thread_count * (thread_count - 1)),                     \
+            .thread_count = thread_count,                                                                           \
+        };                                                                                                          \
+        if (yo_unlikely((context.buffer == NULL) || (context.samples == NULL))) {                                   \
+            yo_arena_checkpoint_restore(checkpoint);                                                                \
+            return false;                                                                                           \
+        }                                                                                                           \
+                                                                                                                    \
+        yo_impl_parallel_sort_run(&context, Name##_impl_parallel_sort_worker);                                      \
+        yo_arena_checkpoint_restore(checkpoint);                                                                    \
+        return true;                                                                                                \
+    }
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_SORT_H
@@ -0,0 +1,161 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: LIFO stack allocator.
+/// File name: yoneda_stack.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_STACK_H
+#define YONEDA_STACK_H
+
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Stack allocator.
+// -----------------------------------------------------------------------------
+
+/// Header placed right before each block allocated by a stack.
+struct yo_StackHeader {
+    /// Distance, in bytes, from the end of the previous block to the start of this block.
+    usize padding;
+    /// Size of the block.
+    usize capacity;
+    /// Offset of the previous top block, zero if there was none.
+    usize previous_offset;
+};
+yo_type_alias(yo_StackHeader, struct yo_StackHeader);
+
+/// Stack allocator
+///
+/// Blocks are freed in the reverse order of their allocation, as in a stack. Each block carries
+/// a small header that allows the stack to check that pops follow the LIFO order, and to resize
+/// the top block in-place. Compared to arena checkpoints, each block can be released as soon as
+/// it's no longer needed, without having to keep track of any state.
+///
+/// The stack does not own memory, thus it is not responsible for the freeing of it.
+struct yo_api yo_Stack {
+    /// Not-owned block of memory.
+    u8*   buf;
+    /// Capacity in bytes of the stack block of memory.
+    usize capacity;
+    /// The current offset to the free-space in the memory block.
+    usize offset;
+    /// Offset of the top block, zero if the stack is empty.
+    usize top_offset;
+};
+yo_type_alias(yo_Stack, struct yo_Stack);
+
+/// Saved state of a stack, used for scoped allocations.
+struct yo_api yo_StackScope {
+    struct yo_Stack* stack;
+    usize            saved_offset;
+    usize            saved_top_offset;
+};
+yo_type_alias(yo_StackScope, struct yo_StackScope);
+
+/// Make a stack whose memory is allocated from an arena.
+yo_api yo_Stack yo_make_stack(yo_Arena* arena, usize capacity);
+
+// -----------------------------------------------------------------------------
+// Allocation procedures.
+//
+// @NOTE: All allocation procedures will zero-out the whole allocated block.
+// -----------------------------------------------------------------------------
+
+/// Push a new block to the top of the stack.
+yo_api u8* yo_stack_push_align(yo_Stack* stack, usize size_bytes, u32 alignment);
+
+/// Resize a block of the stack.
+///
+/// The top block is resized in-place, any other block is copied to a new block at the top of
+/// the stack.
+yo_api u8* yo_stack_realloc_align(yo_Stack* stack, u8* block, usize new_size_bytes, u32 alignment);
+
+/// Pop a given block from the stack.
+///
+/// Fails, leaving the stack untouched, if the block isn't the top block of the stack.
+yo_api yo_Status yo_stack_pop_block(yo_Stack* stack, void const* block);
+
+/// Pop the top block of the stack, doing nothing if the stack is empty.
+yo_api void yo_stack_pop_top(yo_Stack* stack);
+
+#define yo_stack_push(stack, ValueType, count) \
+    yo_cast(ValueType*, yo_stack_push_align(stack, yo_size_of(ValueType) * (count), yo_align_of(ValueType)))
+
+#define yo_stack_realloc(stack, ValueType, block, new_count) \
+    yo_cast(ValueType*, yo_stack_realloc_align(stack, yo_cast(u8*, block), yo_size_of(ValueType) * (new_count), yo_align_of(ValueType)))
+
+#define yo_stack_pop(stack, block) yo_stack_pop_block(stack, block)
+
+/// Get the top block of the stack, or null if the stack is empty.
+yo_api yo_inline u8* yo_stack_top(yo_Stack const* stack) {
+    return (stack->top_offset != 0) ? stack->buf + stack->top_offset : NULL;
+}
+
+/// Get the size of a block of the stack.
+yo_api yo_inline usize yo_stack_block_size(void const* block) {
+    yo_assert_not_null(block);
+    return (yo_cast(yo_StackHeader const*, block) - 1)->capacity;
+}
+
+/// Pop all blocks of the stack.
+yo_api yo_inline void yo_stack_clear(yo_Stack* stack) {
+    stack->offset     = 0;
+    stack->top_offset = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Scoped allocations.
+//
+// All blocks pushed between the start and the end of a scope are popped at once when the scope
+// ends. Scopes can be nested, as long as they end in the reverse order they were started.
+// -----------------------------------------------------------------------------
+
+/// Start a new scope of allocations in the stack.
+yo_api yo_inline yo_StackScope yo_stack_scope_begin(yo_Stack* stack) {
+    return (yo_StackScope){.stack = stack, .saved_offset = stack->offset, .saved_top_offset = stack->top_offset};
+}
+
+/// Pop all blocks pushed since the start of the scope.
+yo_api yo_inline void yo_stack_scope_end(yo_StackScope scope) {
+    yo_assert_msg(scope.saved_offset <= scope.stack->offset, "Scopes should end in the reverse order they were started.");
+    scope.stack->offset     = scope.saved_offset;
+    scope.stack->top_offset = scope.saved_top_offset;
+}
+
+/// Run the following statement (or block) inside a stack scope.
+///
+/// Note: Leaving the scope via `return`, `break` or `goto` skips the end of the scope.
+#define yo_stack_scoped(stack)                                                               \
+    for (yo_StackScope yo_var_scope_ = yo_stack_scope_begin(stack), *yo_var_once_ = NULL; \
+         yo_var_once_ == NULL;                                                               \
+         yo_stack_scope_end(yo_var_scope_), yo_var_once_ = &yo_var_scope_)
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_STACK_H
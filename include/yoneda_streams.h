@@ -116,11 +116,92 @@ yo_type_alias(yo_FileReadResult, struct yo_FileReadResult);
 ///     * flag: Can be any flag with read permission.
 yo_api yo_FileReadResult yo_read_file(yo_Arena* arena, cstring path, yo_FileFlag flag);
 
+/// Read file contents to a buffer provided by an allocator interface.
+///
+/// The resulting buffer should be released with `yo_allocator_free` using its size `buf_size`.
+yo_api yo_FileReadResult yo_read_file_with_allocator(yo_Allocator const* allocator, cstring path, yo_FileFlag flag);
+
 /// Read the standard input stream bytes to a string.
 yo_api yo_DynString yo_read_stdin(yo_Arena* arena, u32 initial_buf_size, u32 read_chunk_size);
 
 yo_api yo_DynString yo_absolute_path(yo_Arena* arena, cstring file_path);
 
+// -----------------------------------------------------------------------------
+// Stream ring buffer.
+//
+// Byte ring buffer for input that is consumed incrementally, such as by streaming parsers. When
+// possible, the memory of the ring is mapped twice back to back (see
+// `yo_memory_virtual_alloc_mirrored`), so that the readable and the writable bytes are each a
+// single contiguous span, even across the wrap point. Otherwise, the spans stop at the end of the
+// ring memory and copies are split in two.
+// -----------------------------------------------------------------------------
+
+#ifndef YO_STREAM_RING_MIN_CAPACITY
+#    define YO_STREAM_RING_MIN_CAPACITY yo_kibibytes(64)
+#endif
+
+struct yo_api yo_StreamRing {
+    u8*   buf;
+    /// Capacity of the ring, always a power of two.
+    usize capacity;
+    /// Number of bytes ever consumed.
+    usize head;
+    /// Number of bytes ever produced.
+    usize tail;
+    /// Whether the memory of the ring is mapped twice, back to back.
+    bool  mirrored;
+};
+yo_type_alias(yo_StreamRing, struct yo_StreamRing);
+
+/// Make a ring buffer that owns its memory.
+///
+/// Parameters:
+///     * capacity: Minimum number of bytes the ring can hold. Rounded up to a power of two of at
+///                 least `YO_STREAM_RING_MIN_CAPACITY` bytes.
+yo_api yo_StreamRing yo_make_stream_ring(usize capacity);
+
+/// Release the memory of the ring.
+yo_api void yo_destroy_stream_ring(yo_StreamRing* ring);
+
+/// Copy bytes to the back of the ring.
+///
+/// Return: The number of bytes written, limited by the free space of the ring.
+yo_api usize yo_stream_ring_write(yo_StreamRing* ring, u8 const* data, usize size_bytes);
+
+/// Copy bytes from the front of the ring, consuming them.
+///
+/// Return: The number of bytes read, limited by the number of bytes in the ring.
+yo_api usize yo_stream_ring_read(yo_StreamRing* ring, u8* data, usize size_bytes);
+
+/// Get a view of the bytes at the front of the ring, without consuming them.
+///
+/// If the ring is mirrored, the view contains all bytes of the ring, otherwise it stops at the end
+/// of the ring memory. The view is valid until the bytes are consumed.
+yo_api yo_String yo_stream_ring_peek(yo_StreamRing const* ring);
+
+/// Consume bytes from the front of the ring, typically after being viewed via
+/// `yo_stream_ring_peek`.
+yo_api void yo_stream_ring_consume(yo_StreamRing* ring, usize size_bytes);
+
+/// Get the free memory at the back of the ring, so that it can be directly written to.
+///
+/// If the ring is mirrored, the span contains all free space of the ring, otherwise it stops at the
+/// end of the ring memory. The written bytes should be published via `yo_stream_ring_commit`.
+///
+/// Parameters:
+///     * span_size: Output parameter, receives the size of the span.
+yo_api u8* yo_stream_ring_write_span(yo_StreamRing* ring, usize* span_size);
+
+/// Publish bytes written to the span obtained via `yo_stream_ring_write_span`.
+yo_api void yo_stream_ring_commit(yo_StreamRing* ring, usize size_bytes);
+
+/// Read the available bytes of the standard input stream directly into the ring, with a single
+/// read call.
+///
+/// Return: The number of bytes read, zero at the end of the stream or if the ring is full, or -1
+///         if the read failed.
+yo_api isize yo_stream_ring_read_stdin(yo_StreamRing* ring);
+
 #if defined(YO_LANG_CPP)
 }
 #endif
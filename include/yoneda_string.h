@@ -136,11 +136,15 @@ yo_api yo_inline yo_StringBuffer yo_make_string_buffer(yo_Arena* arena, usize le
 }
 
 /// Dynamically sized string.
+///
+/// The string memory is provided either by an arena or, if `allocator` isn't null, by an allocator
+/// interface.
 struct yo_api yo_DynString {
-    char*     buf;
-    usize     length;
-    usize     capacity;
-    yo_Arena* arena;
+    char*               buf;
+    usize               length;
+    usize               capacity;
+    yo_Arena*           arena;
+    yo_Allocator const* allocator;
 };
 yo_type_alias(yo_DynString, struct yo_DynString);
 
@@ -156,14 +160,42 @@ yo_api yo_inline yo_DynString yo_make_dynstring(yo_Arena* arena, usize capacity)
     };
 }
 
+/// Make a dynamic string whose memory is provided by an allocator interface.
+///
+/// The string should be released with `yo_destroy_dynstring`.
+yo_api yo_inline yo_DynString yo_make_dynstring_with_allocator(yo_Allocator const* allocator, usize capacity) {
+    char* memory = yo_allocator_alloc(allocator, char, capacity);
+    yo_assert_msg(memory != NULL, "Failed to allocate memory.");
+
+    return (yo_DynString){
+        .buf       = memory,
+        .length    = 0,
+        .capacity  = capacity,
+        .allocator = allocator,
+    };
+}
+
+/// Release the memory of a dynamic string created with an allocator interface.
+///
+/// Strings whose memory comes from an arena are left untouched.
+yo_api yo_inline void yo_destroy_dynstring(yo_DynString* dstring) {
+    if (dstring->allocator != NULL) {
+        yo_allocator_free(dstring->allocator, dstring->buf, dstring->capacity);
+        dstring->buf      = NULL;
+        dstring->length   = 0;
+        dstring->capacity = 0;
+    }
+}
+
 yo_api yo_inline void yo_init_dynstring(yo_DynString* string, yo_Arena* arena, usize capacity) {
     char* memory = yo_arena_alloc(arena, char, capacity);
     yo_assert_msg(memory != NULL, "Failed to allocate memory.");
 
-    string->buf      = memory;
-    string->length   = 0;
-    string->capacity = capacity;
-    string->arena    = arena;
+    string->buf       = memory;
+    string->length    = 0;
+    string->capacity  = capacity;
+    string->arena     = arena;
+    string->allocator = NULL;
 }
 
 yo_api yo_inline yo_DynString yo_make_dynstring_from_string(yo_Arena* arena, yo_String string) {
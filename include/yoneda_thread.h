@@ -0,0 +1,121 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Threads and thread synchronization primitives.
+/// File name: yoneda_thread.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_THREAD_H
+#define YONEDA_THREAD_H
+
+#include <yoneda_core.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Threads.
+//
+// Minimal support for running procedures on operating system threads. Implemented with pthreads
+// on POSIX systems and native threads on Windows.
+// -----------------------------------------------------------------------------
+
+/// Procedure executed by a thread.
+typedef void yo_ThreadProc(void* user_data);
+
+struct yo_api yo_Thread {
+    yo_ThreadProc* proc;
+    void*          user_data;
+    /// Native handle of the thread.
+    uptr           handle;
+};
+yo_type_alias(yo_Thread, struct yo_Thread);
+
+/// Start a new thread executing `proc(user_data)`.
+///
+/// The thread structure is used by the new thread until it starts running the procedure, so it
+/// must stay alive, and not be moved, until the thread is joined.
+///
+/// Return: Whether the thread could be created.
+yo_api bool yo_thread_spawn(yo_Thread* thread, yo_ThreadProc* proc, void* user_data);
+
+/// Wait for a thread to finish and release its resources.
+yo_api void yo_thread_join(yo_Thread* thread);
+
+/// Get the number of hardware threads available to the program, or 1 if unknown.
+yo_api u32 yo_thread_hardware_count(void);
+
+/// Give up the rest of the time slice of the calling thread to other ready threads.
+yo_api void yo_thread_yield(void);
+
+// -----------------------------------------------------------------------------
+// Futex.
+//
+// Lets threads sleep until the value of a 32-bit word changes, without spinning. Implemented with
+// futex on Linux and WaitOnAddress on Windows. Other platforms fall back to yielding the thread.
+// -----------------------------------------------------------------------------
+
+/// Block the calling thread while the value at `address` is equal to `expected_value`.
+///
+/// The comparison and the sleep happen atomically with respect to the wake calls on the same
+/// address, so a thread that changes the value and then wakes the waiters can't be missed. The
+/// call may return spuriously, so it should be made in a loop that rechecks the waited condition.
+yo_api void yo_futex_wait(u32 volatile* address, u32 expected_value);
+
+/// Wake at most one thread waiting on `address`.
+yo_api void yo_futex_wake_one(u32 volatile* address);
+
+/// Wake all threads waiting on `address`.
+yo_api void yo_futex_wake_all(u32 volatile* address);
+
+// -----------------------------------------------------------------------------
+// Barrier.
+//
+// Lets a fixed group of threads wait for each other between the phases of a computation, sleeping
+// on a futex instead of spinning. The barrier resets itself once every thread arrives, so the same
+// group can keep using it for each of the following phases.
+// -----------------------------------------------------------------------------
+
+struct yo_api yo_Barrier {
+    u32          thread_count;
+    /// Number of threads that arrived at the current phase.
+    u32 volatile arrived_count;
+    /// Futex word, incremented each time all threads arrive.
+    u32 volatile phase;
+};
+yo_type_alias(yo_Barrier, struct yo_Barrier);
+
+/// Create a barrier for a group of `thread_count` threads.
+yo_api yo_Barrier yo_make_barrier(u32 thread_count);
+
+/// Block the calling thread until all threads of the group reach the barrier. Memory writes made by
+/// any of the threads before reaching the barrier are visible to all of them once they leave it.
+///
+/// Return: Whether the calling thread was the last one to arrive, which is true for exactly one
+///         thread of each phase.
+yo_api bool yo_barrier_wait(yo_Barrier* barrier);
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_THREAD_H
@@ -0,0 +1,194 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Two-level segregated fit general purpose allocator.
+/// File name: yoneda_tlsf.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_TLSF_H
+#define YONEDA_TLSF_H
+
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#if defined(YO_LANG_CPP)
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Size classes.
+//
+// Free blocks are segregated into first level classes, one for each power of two, which are in
+// turn linearly subdivided into second level classes. Blocks smaller than YO_TLSF_SMALL_BLOCK_SIZE
+// are all placed in the first class, which is linearly subdivided.
+// -----------------------------------------------------------------------------
+
+#define YO_TLSF_ALIGN_SIZE_LOG2     3
+#define YO_TLSF_ALIGN_SIZE          (1 << YO_TLSF_ALIGN_SIZE_LOG2)
+#define YO_TLSF_SL_INDEX_COUNT_LOG2 5
+#define YO_TLSF_SL_INDEX_COUNT      (1 << YO_TLSF_SL_INDEX_COUNT_LOG2)
+#define YO_TLSF_FL_INDEX_MAX        40
+#define YO_TLSF_FL_INDEX_SHIFT      (YO_TLSF_SL_INDEX_COUNT_LOG2 + YO_TLSF_ALIGN_SIZE_LOG2)
+#define YO_TLSF_FL_INDEX_COUNT      (YO_TLSF_FL_INDEX_MAX - YO_TLSF_FL_INDEX_SHIFT + 1)
+#define YO_TLSF_SMALL_BLOCK_SIZE    (1 << YO_TLSF_FL_INDEX_SHIFT)
+
+// -----------------------------------------------------------------------------
+// TLSF allocator.
+// -----------------------------------------------------------------------------
+
+/// Header of a block of memory managed by the TLSF allocator.
+///
+/// The link to the previous physical block is stored in the last word of the previous block and
+/// is only valid when the previous block is free. The free list links are only valid when the
+/// block itself is free, thus an allocated block has only the size word as overhead.
+struct yo_TlsfBlock {
+    struct yo_TlsfBlock* prev_physical;
+    /// Size of the block, whose two least significant bits encode whether the block and the
+    /// previous physical block are free.
+    usize                size;
+    struct yo_TlsfBlock* next_free;
+    struct yo_TlsfBlock* prev_free;
+};
+yo_type_alias(yo_TlsfBlock, struct yo_TlsfBlock);
+
+/// Two-level segregated fit allocator.
+///
+/// General purpose allocator supporting the release of individual blocks of variable size in any
+/// order. Allocation, release and reallocation all run in bounded constant time: a pair of bitmaps
+/// is used to find a free list with a suitable block with bit scans, and free blocks are merged
+/// with their physical neighbours immediately when released. This makes the worst case latency
+/// deterministic, which is required for soft real-time applications.
+///
+/// The allocator doesn't own any memory, it manages pools of memory provided by the user, such as
+/// blocks allocated from an arena or a committed range of a virtual memory reservation. The
+/// allocator state itself lives at the start of the first pool.
+struct yo_api yo_Tlsf {
+    /// Sentinel block marking the end of each free list.
+    yo_TlsfBlock  null_block;
+    /// Bitmap of the first level classes containing free blocks.
+    u64           fl_bitmap;
+    /// Bitmaps of the second level classes containing free blocks, for each first level class.
+    u32           sl_bitmap[YO_TLSF_FL_INDEX_COUNT];
+    /// Heads of the free lists of each class.
+    yo_TlsfBlock* blocks[YO_TLSF_FL_INDEX_COUNT][YO_TLSF_SL_INDEX_COUNT];
+    /// Total number of bytes that can be handed out by all pools, including the block overhead.
+    usize         capacity;
+    /// Number of bytes in allocated blocks, including the block overhead.
+    usize         used_bytes;
+    /// Highest number of bytes simultaneously in use.
+    usize         peak_used_bytes;
+};
+yo_type_alias(yo_Tlsf, struct yo_Tlsf);
+
+/// Fragmentation statistics of a TLSF allocator.
+struct yo_api yo_TlsfStats {
+    usize capacity;
+    usize used_bytes;
+    usize peak_used_bytes;
+    usize free_bytes;
+    /// Number of free blocks across all pools.
+    usize free_block_count;
+    /// Size of the largest block that can currently be allocated.
+    usize largest_free_block;
+    /// Fraction of the free memory that can't be served by a single allocation, in the range [0, 1].
+    f32   fragmentation;
+};
+yo_type_alias(yo_TlsfStats, struct yo_TlsfStats);
+
+/// Create a TLSF allocator in a block of memory.
+///
+/// The allocator state is placed at the start of the memory block and the rest of it is used as
+/// the first pool of the allocator.
+///
+/// Parameters:
+///     * memory: The memory block, aligned to YO_TLSF_ALIGN_SIZE.
+///     * size_bytes: The size of the memory block.
+///
+/// Return: The allocator, or null if the memory block is too small.
+yo_api yo_Tlsf* yo_make_tlsf_in_memory(u8* memory, usize size_bytes);
+
+/// Create a TLSF allocator whose memory is allocated from an arena.
+///
+/// The memory is not touched until it is handed out by the allocator, so the arena may be a
+/// reserved arena with a huge capacity.
+yo_api yo_Tlsf* yo_make_tlsf(yo_Arena* arena, usize size_bytes);
+
+/// Add a new pool of memory to the allocator.
+///
+/// Blocks are never merged across pools, even if the pools are adjacent.
+yo_api yo_Status yo_tlsf_add_pool(yo_Tlsf* tlsf, u8* memory, usize size_bytes);
+
+/// Allocate a zeroed block of memory with a given alignment.
+///
+/// Return: The block of memory, or null if there isn't any suitable free block.
+yo_api u8* yo_tlsf_alloc_align(yo_Tlsf* tlsf, usize size_bytes, u32 alignment);
+
+/// Resize a block of memory, in place if possible.
+///
+/// If the block is moved, the contents of the old block are copied to the new one. Bytes past the
+/// original size of the block are zeroed.
+///
+/// Parameters:
+///     * block: The block to resize. If null, a new block is allocated.
+///     * new_size_bytes: The new size of the block. If zero, the block is freed.
+///     * alignment: The alignment of the block.
+yo_api u8* yo_tlsf_realloc_align(yo_Tlsf* tlsf, u8* block, usize new_size_bytes, u32 alignment);
+
+/// Release a block of memory back to the allocator.
+///
+/// Does nothing if `block` is a null pointer.
+yo_api void yo_tlsf_free(yo_Tlsf* tlsf, void* block);
+
+/// Get the usable size of a block allocated by a TLSF allocator, which may be larger than the
+/// size originally requested.
+yo_api usize yo_tlsf_block_size(void const* block);
+
+/// Query the fragmentation statistics of the allocator.
+///
+/// Note: Unlike the remaining procedures, this walks the free list containing the largest free
+///       blocks and shouldn't be called in latency sensitive code.
+yo_api yo_TlsfStats yo_tlsf_stats(yo_Tlsf const* tlsf);
+
+yo_api u8*  yo_impl_tlsf_allocator_alloc(void* context, usize size_bytes, u32 alignment);
+yo_api u8*  yo_impl_tlsf_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment);
+yo_api void yo_impl_tlsf_allocator_free(void* context, void* block, usize size_bytes);
+
+/// Get the allocator interface of a TLSF allocator.
+yo_api yo_inline yo_Allocator yo_tlsf_allocator(yo_Tlsf* tlsf) {
+    return (yo_Allocator){
+        .context = tlsf,
+        .alloc   = yo_impl_tlsf_allocator_alloc,
+        .resize  = yo_impl_tlsf_allocator_resize,
+        .free    = yo_impl_tlsf_allocator_free,
+    };
+}
+
+#define yo_tlsf_alloc(tlsf_ptr, T, count) \
+    yo_cast(T*, yo_tlsf_alloc_align(tlsf_ptr, yo_size_of(T) * (count), yo_cast(u32, yo_align_of(T))))
+
+#define yo_tlsf_realloc(tlsf_ptr, T, block, new_count) \
+    yo_cast(T*, yo_tlsf_realloc_align(tlsf_ptr, yo_cast(u8*, block), yo_size_of(T) * (new_count), yo_cast(u32, yo_align_of(T))))
+
+#if defined(YO_LANG_CPP)
+}
+#endif
+
+#endif  // YONEDA_TLSF_H
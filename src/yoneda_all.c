@@ -24,12 +24,31 @@
 /// File name: yoneda_all.c
 /// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
 
+// Expose the POSIX and Linux-specific interfaces (e.g. MAP_ANONYMOUS and MAP_NORESERVE) even when
+// compiling under a strict C standard.
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#    define _GNU_SOURCE
+#endif
+
 // clang-format off
 #include <yoneda_all.h>
 
 #include "yoneda_time.c"
 #include "yoneda_log.c"
 #include "yoneda_memory.c"
+#include "yoneda_pool.c"
+#include "yoneda_stack.c"
+#include "yoneda_tlsf.c"
+#include "yoneda_slab.c"
+#include "yoneda_concurrent_arena.c"
+#include "yoneda_thread.c"
+#include "yoneda_queue.c"
+#include "yoneda_map.c"
 #include "yoneda_string.c"
+#include "yoneda_hash.c"
+#include "yoneda_interner.c"
+#include "yoneda_sort.c"
+#include "yoneda_bitset.c"
+#include "yoneda_slot_map.c"
 #include "yoneda_streams.c"
 // clang-format on
@@ -0,0 +1,238 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the dynamically sized bitsets.
+/// File name: yoneda_bitset.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_bitset.h>
+
+#include <yoneda_log.h>
+
+#if defined(YO_ARCH_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(YO_ARCH_SIMD_SSE2)
+#    include <emmintrin.h>
+#elif defined(YO_ARCH_SIMD_NEON)
+#    include <arm_neon.h>
+#endif
+
+#include "yoneda_impl_common.h"
+
+/// Alignment of the words of bitsets, keeping each vector of words within a single cache line.
+#define YO_IMPL_BITSET_ALIGNMENT 64
+
+yo_Bitset yo_make_bitset(yo_Arena* arena, usize bit_count) {
+    usize word_count = yo_align_forward((bit_count + YO_BITSET_WORD_BITS - 1) / YO_BITSET_WORD_BITS, YO_BITSET_WORD_GRANULARITY);
+    u64*  words      = NULL;
+    if (word_count != 0) {
+        words = yo_cast(u64*, yo_cast(void*, yo_arena_alloc_align(arena, word_count * yo_size_of(u64), YO_IMPL_BITSET_ALIGNMENT)));
+        if (yo_unlikely(words == NULL)) {
+            yo_log_error_fmt("Unable to allocate a bitset of %zu bits.", bit_count);
+            return (yo_Bitset){0};
+        }
+    }
+
+    return (yo_Bitset){
+        .words      = words,
+        .word_count = word_count,
+        .bit_count  = bit_count,
+    };
+}
+
+void yo_bitset_set_all(yo_Bitset* bitset) {
+    yo_assert_not_null(bitset);
+
+    usize full_word_count = bitset->bit_count / YO_BITSET_WORD_BITS;
+    usize remaining_bits  = bitset->bit_count % YO_BITSET_WORD_BITS;
+    for (usize idx = 0; idx < full_word_count; ++idx) {
+        bitset->words[idx] = ~0ULL;
+    }
+
+    // Keep the bits past the end of the bitset cleared.
+    if (remaining_bits != 0) {
+        bitset->words[full_word_count] = yo_bit_ones(remaining_bits);
+    }
+}
+
+void yo_bitset_clear_all(yo_Bitset* bitset) {
+    yo_assert_not_null(bitset);
+    if (bitset->word_count != 0) {
+        yo_memory_set(yo_cast(u8*, bitset->words), bitset->word_count * yo_size_of(u64), 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Bulk boolean operations.
+// -----------------------------------------------------------------------------
+
+#define yo_impl_bitset_and_scalar(lhs, rhs)     ((lhs) & (rhs))
+#define yo_impl_bitset_or_scalar(lhs, rhs)      ((lhs) | (rhs))
+#define yo_impl_bitset_xor_scalar(lhs, rhs)     ((lhs) ^ (rhs))
+#define yo_impl_bitset_and_not_scalar(lhs, rhs) ((lhs) & ~(rhs))
+
+#if defined(YO_ARCH_SIMD_AVX2)
+#    define YO_IMPL_BITSET_LANE_WORDS 4
+#    define yo_impl_bitset_and_vector(lhs, rhs)     _mm256_and_si256(lhs, rhs)
+#    define yo_impl_bitset_or_vector(lhs, rhs)      _mm256_or_si256(lhs, rhs)
+#    define yo_impl_bitset_xor_vector(lhs, rhs)     _mm256_xor_si256(lhs, rhs)
+#    define yo_impl_bitset_and_not_vector(lhs, rhs) _mm256_andnot_si256(rhs, lhs)
+#    define yo_impl_bitset_apply(name, dst, src)                                         \
+        _mm256_storeu_si256(                                                             \
+            yo_cast(__m256i*, yo_cast(void*, dst)),                                      \
+            yo_impl_bitset_##name##_vector(                                              \
+                _mm256_loadu_si256(yo_cast(__m256i const*, yo_cast(void const*, dst))),  \
+                _mm256_loadu_si256(yo_cast(__m256i const*, yo_cast(void const*, src)))))
+#elif defined(YO_ARCH_SIMD_SSE2)
+#    define YO_IMPL_BITSET_LANE_WORDS 2
+#    define yo_impl_bitset_and_vector(lhs, rhs)     _mm_and_si128(lhs, rhs)
+#    define yo_impl_bitset_or_vector(lhs, rhs)      _mm_or_si128(lhs, rhs)
+#    define yo_impl_bitset_xor_vector(lhs, rhs)     _mm_xor_si128(lhs, rhs)
+#    define yo_impl_bitset_and_not_vector(lhs, rhs) _mm_andnot_si128(rhs, lhs)
+#    define yo_impl_bitset_apply(name, dst, src)                                      \
+        _mm_storeu_si128(                                                             \
+            yo_cast(__m128i*, yo_cast(void*, dst)),                                   \
+            yo_impl_bitset_##name##_vector(                                           \
+                _mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, dst))),  \
+                _mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, src)))))
+#elif defined(YO_ARCH_SIMD_NEON)
+#    define YO_IMPL_BITSET_LANE_WORDS 2
+#    define yo_impl_bitset_and_vector(lhs, rhs)     vandq_u64(lhs, rhs)
+#    define yo_impl_bitset_or_vector(lhs, rhs)      vorrq_u64(lhs, rhs)
+#    define yo_impl_bitset_xor_vector(lhs, rhs)     veorq_u64(lhs, rhs)
+#    define yo_impl_bitset_and_not_vector(lhs, rhs) vbicq_u64(lhs, rhs)
+#    define yo_impl_bitset_apply(name, dst, src)    vst1q_u64(dst, yo_impl_bitset_##name##_vector(vld1q_u64(dst), vld1q_u64(src)))
+#else
+#    define YO_IMPL_BITSET_LANE_WORDS            1
+#    define yo_impl_bitset_apply(name, dst, src) (*(dst) = yo_impl_bitset_##name##_scalar(*(dst), *(src)))
+#endif
+
+// The word count of bitsets is a multiple of the lane size, so there's no remainder to handle.
+#define yo_impl_define_bitset_operation(name)                                                       \
+    void yo_bitset_##name(yo_Bitset* dst, yo_Bitset const* src) {                                   \
+        yo_assert_not_null(dst);                                                                    \
+        yo_assert_not_null(src);                                                                    \
+        yo_assert_msg(dst->bit_count == src->bit_count, "Bitsets should have the same bit count."); \
+                                                                                                    \
+        u64*       dst_words  = dst->words;                                                         \
+        u64 const* src_words  = src->words;                                                         \
+        usize      word_count = dst->word_count;                                                    \
+        for (usize idx = 0; idx < word_count; idx += YO_IMPL_BITSET_LANE_WORDS) {                   \
+            yo_impl_bitset_apply(name, dst_words + idx, src_words + idx);                           \
+        }                                                                                           \
+    }
+
+yo_impl_define_bitset_operation(and)
+yo_impl_define_bitset_operation(or)
+yo_impl_define_bitset_operation(xor)
+yo_impl_define_bitset_operation(and_not)
+
+// -----------------------------------------------------------------------------
+// Population count.
+// -----------------------------------------------------------------------------
+
+/// Count the bits set in a range of words.
+yo_internal usize yo_impl_bitset_popcount_words(u64 const* words, usize word_count) {
+    usize count = 0;
+    usize idx   = 0;
+
+#if defined(YO_ARCH_SIMD_AVX2)
+    // Count the bits of each nibble with a lookup table, and sum the bytes of each lane.
+    __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i low_mask    = _mm256_set1_epi8(0x0F);
+    __m256i accumulator = _mm256_setzero_si256();
+    for (; idx + 4 <= word_count; idx += 4) {
+        __m256i data   = _mm256_loadu_si256(yo_cast(__m256i const*, yo_cast(void const*, words + idx)));
+        __m256i low    = _mm256_and_si256(data, low_mask);
+        __m256i high   = _mm256_and_si256(_mm256_srli_epi16(data, 4), low_mask);
+        __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+        accumulator    = _mm256_add_epi64(accumulator, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+    count += yo_cast(usize, _mm256_extract_epi64(accumulator, 0)) + yo_cast(usize, _mm256_extract_epi64(accumulator, 1))
+           + yo_cast(usize, _mm256_extract_epi64(accumulator, 2)) + yo_cast(usize, _mm256_extract_epi64(accumulator, 3));
+#elif defined(YO_ARCH_SIMD_NEON)
+    // Count the bits of each byte, and widen the counts by pairwise additions.
+    uint64x2_t accumulator = vdupq_n_u64(0);
+    for (; idx + 2 <= word_count; idx += 2) {
+        uint8x16_t counts = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + idx)));
+        accumulator       = vaddq_u64(accumulator, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counts))));
+    }
+    count += yo_cast(usize, vgetq_lane_u64(accumulator, 0) + vgetq_lane_u64(accumulator, 1));
+#endif
+
+    for (; idx < word_count; ++idx) {
+        count += yo_u64_popcount(words[idx]);
+    }
+    return count;
+}
+
+usize yo_bitset_count(yo_Bitset const* bitset) {
+    yo_assert_not_null(bitset);
+    return yo_impl_bitset_popcount_words(bitset->words, bitset->word_count);
+}
+
+usize yo_bitset_rank(yo_Bitset const* bitset, usize idx) {
+    yo_assert_not_null(bitset);
+    yo_assert_fmt(idx <= bitset->bit_count, "Bit index %zu out of bounds (%zu bits).", idx, bitset->bit_count);
+
+    usize word_idx = idx / YO_BITSET_WORD_BITS;
+    usize bit_idx  = idx % YO_BITSET_WORD_BITS;
+    usize rank     = yo_impl_bitset_popcount_words(bitset->words, word_idx);
+    if (bit_idx != 0) {
+        rank += yo_u64_popcount(bitset->words[word_idx] & yo_bit_ones(bit_idx));
+    }
+    return rank;
+}
+
+// -----------------------------------------------------------------------------
+// Bit search.
+// -----------------------------------------------------------------------------
+
+/// Find the first bit whose index is at least `idx` among the words, inverted by `flip`.
+yo_internal yo_inline usize yo_impl_bitset_find_next(yo_Bitset const* bitset, usize idx, u64 flip) {
+    yo_assert_not_null(bitset);
+    if (idx >= bitset->bit_count) {
+        return bitset->bit_count;
+    }
+
+    usize word_idx = idx / YO_BITSET_WORD_BITS;
+    u64   word     = (bitset->words[word_idx] ^ flip) & (~0ULL << (idx % YO_BITSET_WORD_BITS));
+    while (word == 0) {
+        if (++word_idx == bitset->word_count) {
+            return bitset->bit_count;
+        }
+        word = bitset->words[word_idx] ^ flip;
+    }
+
+    // Cleared bits past the end of the bitset may be found when searching for unset bits.
+    usize found = word_idx * YO_BITSET_WORD_BITS + yo_u64_lsb_index(word);
+    return yo_min_value(found, bitset->bit_count);
+}
+
+usize yo_bitset_find_next_set(yo_Bitset const* bitset, usize idx) {
+    return yo_impl_bitset_find_next(bitset, idx, 0);
+}
+
+usize yo_bitset_find_next_unset(yo_Bitset const* bitset, usize idx) {
+    return yo_impl_bitset_find_next(bitset, idx, ~0ULL);
+}
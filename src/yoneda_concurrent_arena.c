@@ -0,0 +1,204 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the lock-free bump arena shared between threads.
+/// File name: yoneda_concurrent_arena.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_concurrent_arena.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+/// Range of a concurrent arena reserved by the current thread.
+struct yo_ConcurrentArenaChunk {
+    yo_ConcurrentArena const* arena;
+    u64                       generation;
+    usize                     cursor;
+    usize                     end;
+};
+yo_type_alias(yo_ConcurrentArenaChunk, struct yo_ConcurrentArenaChunk);
+
+struct yo_ConcurrentArenaThreadState {
+    yo_ConcurrentArenaChunk chunks[YO_CONCURRENT_ARENA_THREAD_CHUNK_COUNT];
+    u32                     next_evicted;
+};
+yo_type_alias(yo_ConcurrentArenaThreadState, struct yo_ConcurrentArenaThreadState);
+
+yo_global yo_thread_local yo_ConcurrentArenaThreadState yo_impl_concurrent_arena_thread_state;
+
+/// Generations are unique across all arenas, so that a chunk can never be mistaken as belonging to
+/// a new arena placed at the address of a destroyed one.
+yo_global u64 volatile yo_impl_concurrent_arena_generation_counter = 1;
+
+yo_internal yo_inline u64 yo_impl_concurrent_arena_next_generation(void) {
+    return yo_atomic_fetch_add_u64(&yo_impl_concurrent_arena_generation_counter, 1, YO_MEMORY_ORDER_RELAXED);
+}
+
+/// Start a new generation, invalidating all thread chunks and marking the memory used so far as
+/// dirty.
+yo_internal void yo_impl_concurrent_arena_invalidate_chunks(yo_ConcurrentArena* arena) {
+    usize offset        = yo_min_value(yo_atomic_load_usize(&arena->offset, YO_MEMORY_ORDER_RELAXED), arena->capacity);
+    arena->dirty_offset = yo_max_value(arena->dirty_offset, offset);
+    yo_atomic_store_u64(&arena->generation, yo_impl_concurrent_arena_next_generation(), YO_MEMORY_ORDER_RELEASE);
+}
+
+/// Atomically reserve a range of the arena memory, returning its start offset.
+yo_internal yo_inline bool yo_impl_concurrent_arena_reserve(yo_ConcurrentArena* arena, usize size_bytes, usize* start) {
+    *start = yo_atomic_fetch_add_usize(&arena->offset, size_bytes, YO_MEMORY_ORDER_RELAXED);
+    return (*start <= arena->capacity) && (size_bytes <= arena->capacity - *start);
+}
+
+yo_internal yo_inline u8* yo_impl_concurrent_arena_hand_out(yo_ConcurrentArena const* arena, usize start, usize size_bytes) {
+    u8* block = arena->buf + start;
+
+    // Memory past the dirty offset is still zeroed from the OS.
+    if (start < arena->dirty_offset) {
+        yo_memory_set(block, yo_min_value(size_bytes, arena->dirty_offset - start), 0);
+    }
+    return block;
+}
+
+yo_ConcurrentArena yo_make_concurrent_arena(usize capacity, usize chunk_size) {
+    yo_assert_msg(chunk_size != 0, "Chunk size of a concurrent arena should be non-zero.");
+
+    u8* memory = yo_memory_virtual_alloc(capacity);
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("Unable to allocate %zu bytes for a concurrent arena.", capacity);
+        return yo_make_default(yo_ConcurrentArena);
+    }
+
+    return (yo_ConcurrentArena){
+        .buf        = memory,
+        .capacity   = capacity,
+        .chunk_size = chunk_size,
+        .generation = yo_impl_concurrent_arena_next_generation(),
+    };
+}
+
+void yo_destroy_concurrent_arena(yo_ConcurrentArena* arena) {
+    yo_assert_not_null(arena);
+
+    if (arena->buf != NULL) {
+        yo_memory_virtual_free(arena->buf, arena->capacity);
+    }
+    arena->buf      = NULL;
+    arena->capacity = 0;
+    arena->offset   = 0;
+}
+
+u8* yo_concurrent_arena_alloc_align(yo_ConcurrentArena* arena, usize size_bytes, u32 alignment) {
+    yo_assert_not_null(arena);
+    yo_assert_fmt(yo_is_pow_of_two(alignment), "Expected alignment (%u) to be a power of two.", alignment);
+
+    if (yo_unlikely(size_bytes == 0)) {
+        return NULL;
+    }
+
+    u64                            generation = yo_atomic_load_u64(&arena->generation, YO_MEMORY_ORDER_ACQUIRE);
+    yo_ConcurrentArenaThreadState* state      = &yo_impl_concurrent_arena_thread_state;
+
+    // Fast path: bump the chunk of the current thread.
+    yo_ConcurrentArenaChunk* chunk = NULL;
+    for (u32 idx = 0; idx < YO_CONCURRENT_ARENA_THREAD_CHUNK_COUNT; ++idx) {
+        if (state->chunks[idx].arena == arena) {
+            chunk = &state->chunks[idx];
+            break;
+        }
+    }
+    if (yo_likely((chunk != NULL) && (chunk->generation == generation))) {
+        usize start = yo_align_forward(yo_cast(uptr, arena->buf) + chunk->cursor, alignment) - yo_cast(uptr, arena->buf);
+        if (yo_likely(start + size_bytes <= chunk->end)) {
+            chunk->cursor = start + size_bytes;
+            return yo_impl_concurrent_arena_hand_out(arena, start, size_bytes);
+        }
+    }
+
+    // Large blocks are reserved directly, keeping the current chunk of the thread.
+    usize request_size = size_bytes + alignment - 1;
+    if (request_size > arena->chunk_size / 4) {
+        usize start;
+        if (yo_unlikely(!yo_impl_concurrent_arena_reserve(arena, request_size, &start))) {
+            yo_log_error_fmt("Concurrent arena unable to allocate %zu bytes, its capacity of %zu bytes was exhausted.", size_bytes, arena->capacity);
+            yo_impl_return_from_memory_error();
+        }
+
+        start = yo_align_forward(yo_cast(uptr, arena->buf) + start, alignment) - yo_cast(uptr, arena->buf);
+        return yo_impl_concurrent_arena_hand_out(arena, start, size_bytes);
+    }
+
+    // Reserve a new chunk for the thread, evicting the chunk of another arena if needed.
+    usize chunk_start;
+    if (yo_unlikely(!yo_impl_concurrent_arena_reserve(arena, arena->chunk_size, &chunk_start))) {
+        yo_log_error_fmt("Concurrent arena unable to allocate %zu bytes, its capacity of %zu bytes was exhausted.", size_bytes, arena->capacity);
+        yo_impl_return_from_memory_error();
+    }
+
+    if (chunk == NULL) {
+        chunk               = &state->chunks[state->next_evicted];
+        state->next_evicted = (state->next_evicted + 1) % YO_CONCURRENT_ARENA_THREAD_CHUNK_COUNT;
+    }
+
+    usize start       = yo_align_forward(yo_cast(uptr, arena->buf) + chunk_start, alignment) - yo_cast(uptr, arena->buf);
+    chunk->arena      = arena;
+    chunk->generation = generation;
+    chunk->cursor     = start + size_bytes;
+    chunk->end        = chunk_start + arena->chunk_size;
+    return yo_impl_concurrent_arena_hand_out(arena, start, size_bytes);
+}
+
+void yo_concurrent_arena_reset(yo_ConcurrentArena* arena) {
+    yo_assert_not_null(arena);
+
+    yo_impl_concurrent_arena_invalidate_chunks(arena);
+    yo_atomic_store_usize(&arena->offset, 0, YO_MEMORY_ORDER_RELEASE);
+}
+
+yo_ConcurrentArenaCheckpoint yo_make_concurrent_arena_checkpoint(yo_ConcurrentArena* arena) {
+    yo_assert_not_null(arena);
+
+    // Chunks reserved before the checkpoint can't be used afterwards, otherwise memory allocated
+    // after the checkpoint would lie below the saved offset.
+    yo_impl_concurrent_arena_invalidate_chunks(arena);
+
+    return (yo_ConcurrentArenaCheckpoint){
+        .arena        = arena,
+        .saved_offset = yo_min_value(yo_atomic_load_usize(&arena->offset, YO_MEMORY_ORDER_RELAXED), arena->capacity),
+    };
+}
+
+void yo_concurrent_arena_checkpoint_restore(yo_ConcurrentArenaCheckpoint checkpoint) {
+    yo_ConcurrentArena* arena = checkpoint.arena;
+    yo_assert_not_null(arena);
+    yo_assert_msg(
+        checkpoint.saved_offset <= yo_atomic_load_usize(&arena->offset, YO_MEMORY_ORDER_RELAXED),
+        "Checkpoint is newer than the current state of the arena.");
+
+    yo_impl_concurrent_arena_invalidate_chunks(arena);
+    yo_atomic_store_usize(&arena->offset, checkpoint.saved_offset, YO_MEMORY_ORDER_RELEASE);
+}
+
+usize yo_concurrent_arena_reserved_bytes(yo_ConcurrentArena const* arena) {
+    yo_assert_not_null(arena);
+    return yo_min_value(yo_atomic_load_usize(&arena->offset, YO_MEMORY_ORDER_RELAXED), arena->capacity);
+}
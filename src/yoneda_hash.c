@@ -0,0 +1,397 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the fast non-cryptographic hash functions.
+/// File name: yoneda_hash.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_hash.h>
+
+#include <string.h>
+#include <yoneda_assert.h>
+
+#if defined(YO_ARCH_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(YO_ARCH_SIMD_SSE2)
+#    include <emmintrin.h>
+#elif defined(YO_ARCH_SIMD_NEON)
+#    include <arm_neon.h>
+#endif
+
+#if defined(YO_COMPILER_MSVC)
+#    include <intrin.h>
+#endif
+
+#include "yoneda_impl_common.h"
+
+/// Number of stripes accumulated between each scramble of the accumulators.
+#define YO_IMPL_HASH_STRIPES_PER_BLOCK 16
+
+#define YO_IMPL_HASH_PRIME32_1 0x9E3779B1U
+#define YO_IMPL_HASH_PRIME32_2 0x85EBCA77U
+#define YO_IMPL_HASH_PRIME32_3 0xC2B2AE3DU
+#define YO_IMPL_HASH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define YO_IMPL_HASH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define YO_IMPL_HASH_PRIME64_3 0x165667B19E3779F9ULL
+#define YO_IMPL_HASH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define YO_IMPL_HASH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+/// Random constants mixed into the input. Stripe `n` of a block is keyed by the 8 words starting at
+/// index `n`, and the scrambling of the accumulators uses the last 8 words.
+yo_global u64 const yo_impl_hash_secret[YO_IMPL_HASH_STRIPES_PER_BLOCK + YO_HASH_LANE_COUNT] = {
+    0x2CB0F69F4ABEA221ULL, 0x9417034723148989ULL, 0xDD555950609DFE03ULL, 0xDBAFB150DEB12800ULL,
+    0x7E789B2E6C442CB6ULL, 0xF41E5636C7E4F8C4ULL, 0x0959D150F8FBA7E4ULL, 0xA97316F13CDB9EEAULL,
+    0x74CD8258F9520068ULL, 0x55C74A62E116868BULL, 0xD2F4C799A2023CBDULL, 0xDF98CB79A37B51B9ULL,
+    0x396F5885524F3905ULL, 0xAF1D56386CA3B276ULL, 0xA9FFBE6B5104E85AULL, 0x6BD0C51B9FD533B3ULL,
+    0x980CE91C50AB4B56ULL, 0x28AC395780FE62C5ULL, 0x768912E3A6BCEDC7ULL, 0x50B3E8C9332C7C88ULL,
+    0xCE3BBFE520BD47DAULL, 0xCBA6C8E8E0BB7C4FULL, 0xBF194DB8434A346DULL, 0x7D8F2A7B60416D7FULL,
+};
+
+// -----------------------------------------------------------------------------
+// Primitives.
+// -----------------------------------------------------------------------------
+
+yo_internal yo_inline u64 yo_impl_hash_read64(u8 const* bytes) {
+    u64 value;
+    yo_discard_value(memcpy(&value, bytes, yo_size_of(value)));
+    return value;
+}
+
+yo_internal yo_inline u64 yo_impl_hash_read32(u8 const* bytes) {
+    u32 value;
+    yo_discard_value(memcpy(&value, bytes, yo_size_of(value)));
+    return value;
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 yo_impl_hash_u128;
+#endif
+
+/// Compute the full 128-bit product of two words, storing its low half in `lhs` and its high half
+/// in `rhs`.
+yo_internal yo_inline void yo_impl_hash_multiply(u64* lhs, u64* rhs) {
+#if defined(__SIZEOF_INT128__)
+    yo_impl_hash_u128 product = yo_cast(yo_impl_hash_u128, *lhs) * (*rhs);
+    *lhs                      = yo_cast(u64, product);
+    *rhs                      = yo_cast(u64, product >> 64);
+#elif defined(YO_COMPILER_MSVC) && defined(YO_ARCH_X64)
+    *lhs = _umul128(*lhs, *rhs, rhs);
+#else
+    u64 lhs_high = *lhs >> 32;
+    u64 lhs_low  = *lhs & 0xFFFFFFFF;
+    u64 rhs_high = *rhs >> 32;
+    u64 rhs_low  = *rhs & 0xFFFFFFFF;
+
+    u64 low_low   = lhs_low * rhs_low;
+    u64 high_low  = lhs_high * rhs_low;
+    u64 low_high  = lhs_low * rhs_high;
+    u64 high_high = lhs_high * rhs_high;
+
+    u64 cross = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    *lhs      = (cross << 32) | (low_low & 0xFFFFFFFF);
+    *rhs      = high_high + (high_low >> 32) + (cross >> 32);
+#endif
+}
+
+/// Fold the 128-bit product of two words into a single word.
+yo_internal yo_inline u64 yo_impl_hash_mix(u64 lhs, u64 rhs) {
+    yo_impl_hash_multiply(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+yo_internal yo_inline u64 yo_impl_hash_avalanche(u64 hash) {
+    hash ^= hash >> 37;
+    hash *= 0x165667919E3779F9ULL;
+    return hash ^ (hash >> 32);
+}
+
+// -----------------------------------------------------------------------------
+// Short inputs.
+// -----------------------------------------------------------------------------
+
+/// Hash an input of at most `YO_HASH_SHORT_INPUT_MAX_SIZE` bytes with the pair of secret words
+/// starting at `secret`.
+yo_internal u64 yo_impl_hash_short(u8 const* bytes, usize size_bytes, u64 seed, u64 const* secret) {
+    seed ^= yo_impl_hash_mix(seed ^ secret[0], secret[1]);
+
+    u64 lhs = 0;
+    u64 rhs = 0;
+    if (size_bytes <= 16) {
+        if (size_bytes >= 4) {
+            // Two possibly overlapping pairs of 4-byte reads cover the whole input.
+            usize shift = (size_bytes >> 3) << 2;
+            lhs         = (yo_impl_hash_read32(bytes) << 32) | yo_impl_hash_read32(bytes + shift);
+            rhs         = (yo_impl_hash_read32(bytes + size_bytes - 4) << 32) | yo_impl_hash_read32(bytes + size_bytes - 4 - shift);
+        } else if (size_bytes > 0) {
+            lhs = (yo_cast(u64, bytes[0]) << 16) | (yo_cast(u64, bytes[size_bytes >> 1]) << 8) | bytes[size_bytes - 1];
+        }
+    } else {
+        u8 const* cursor    = bytes;
+        usize     remaining = size_bytes;
+        while (remaining > 16) {
+            seed = yo_impl_hash_mix(yo_impl_hash_read64(cursor) ^ secret[1], yo_impl_hash_read64(cursor + 8) ^ seed);
+            cursor += 16;
+            remaining -= 16;
+        }
+
+        // The last 16 bytes, possibly overlapping the last chunk.
+        lhs = yo_impl_hash_read64(bytes + size_bytes - 16);
+        rhs = yo_impl_hash_read64(bytes + size_bytes - 8);
+    }
+
+    lhs ^= secret[1];
+    rhs ^= seed;
+    yo_impl_hash_multiply(&lhs, &rhs);
+    return yo_impl_hash_mix(lhs ^ secret[0] ^ size_bytes, rhs ^ secret[1]);
+}
+
+// -----------------------------------------------------------------------------
+// Long inputs.
+//
+// Each lane of a stripe is keyed by a secret word. The 32-bit halves of the keyed lane are
+// multiplied into its accumulator, and the raw lane is added to the neighbouring accumulator, so
+// that no input bit is lost by the multiplication. This maps directly to the 32x32-bit widening
+// multiplications of SSE2, AVX2, and NEON, which all produce the same result as the scalar code.
+// -----------------------------------------------------------------------------
+
+yo_internal yo_inline void yo_impl_hash_init_accumulators(u64* accumulators, u64 seed) {
+    accumulators[0] = YO_IMPL_HASH_PRIME32_3 + seed;
+    accumulators[1] = YO_IMPL_HASH_PRIME64_1 - seed;
+    accumulators[2] = YO_IMPL_HASH_PRIME64_2 + seed;
+    accumulators[3] = YO_IMPL_HASH_PRIME64_3 - seed;
+    accumulators[4] = YO_IMPL_HASH_PRIME64_4 + seed;
+    accumulators[5] = YO_IMPL_HASH_PRIME32_2 - seed;
+    accumulators[6] = YO_IMPL_HASH_PRIME64_5 + seed;
+    accumulators[7] = YO_IMPL_HASH_PRIME32_1 - seed;
+}
+
+yo_internal yo_inline void yo_impl_hash_accumulate_stripe(u64* yo_no_alias accumulators, u8 const* yo_no_alias stripe, u64 const* secret) {
+#if defined(YO_ARCH_SIMD_AVX2)
+    for (u32 idx = 0; idx < 2; ++idx) {
+        __m256i data    = _mm256_loadu_si256(yo_cast(__m256i const*, yo_cast(void const*, stripe)) + idx);
+        __m256i key     = _mm256_xor_si256(data, _mm256_loadu_si256(yo_cast(__m256i const*, yo_cast(void const*, secret)) + idx));
+        __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+        __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+        __m256i* accumulator = yo_cast(__m256i*, yo_cast(void*, accumulators)) + idx;
+        _mm256_storeu_si256(accumulator, _mm256_add_epi64(_mm256_loadu_si256(accumulator), _mm256_add_epi64(product, swapped)));
+    }
+#elif defined(YO_ARCH_SIMD_SSE2)
+    for (u32 idx = 0; idx < 4; ++idx) {
+        __m128i data    = _mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, stripe)) + idx);
+        __m128i key     = _mm_xor_si128(data, _mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, secret)) + idx));
+        __m128i product = _mm_mul_epu32(key, _mm_srli_epi64(key, 32));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+        __m128i* accumulator = yo_cast(__m128i*, yo_cast(void*, accumulators)) + idx;
+        _mm_storeu_si128(accumulator, _mm_add_epi64(_mm_loadu_si128(accumulator), _mm_add_epi64(product, swapped)));
+    }
+#elif defined(YO_ARCH_SIMD_NEON)
+    for (u32 idx = 0; idx < 4; ++idx) {
+        uint64x2_t data    = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * idx));
+        uint64x2_t key     = veorq_u64(data, vld1q_u64(secret + 2 * idx));
+        uint64x2_t product = vmull_u32(vmovn_u64(key), vshrn_n_u64(key, 32));
+        uint64x2_t swapped = vextq_u64(data, data, 1);
+
+        vst1q_u64(accumulators + 2 * idx, vaddq_u64(vld1q_u64(accumulators + 2 * idx), vaddq_u64(product, swapped)));
+    }
+#else
+    for (u32 lane = 0; lane < YO_HASH_LANE_COUNT; ++lane) {
+        u64 data = yo_impl_hash_read64(stripe + 8 * lane);
+        u64 key  = data ^ secret[lane];
+        accumulators[lane ^ 1] += data;
+        accumulators[lane] += (key & 0xFFFFFFFF) * (key >> 32);
+    }
+#endif
+}
+
+/// Spread the high bits of the accumulators, which the multiplications only move upwards.
+yo_internal yo_inline void yo_impl_hash_scramble(u64* accumulators) {
+    u64 const* secret = yo_impl_hash_secret + YO_IMPL_HASH_STRIPES_PER_BLOCK;
+    for (u32 lane = 0; lane < YO_HASH_LANE_COUNT; ++lane) {
+        u64 accumulator = accumulators[lane];
+        accumulator ^= accumulator >> 47;
+        accumulator ^= secret[lane];
+        accumulators[lane] = accumulator * YO_IMPL_HASH_PRIME32_1;
+    }
+}
+
+yo_internal void yo_impl_hash_consume_stripes(u64* accumulators, usize* stripe_count, u8 const* stripes, usize count) {
+    for (usize idx = 0; idx < count; ++idx) {
+        usize stripe_in_block = *stripe_count % YO_IMPL_HASH_STRIPES_PER_BLOCK;
+        yo_impl_hash_accumulate_stripe(accumulators, stripes + idx * YO_HASH_STRIPE_SIZE, yo_impl_hash_secret + stripe_in_block);
+
+        ++*stripe_count;
+        if (*stripe_count % YO_IMPL_HASH_STRIPES_PER_BLOCK == 0) {
+            yo_impl_hash_scramble(accumulators);
+        }
+    }
+}
+
+/// Merge the accumulators into a single word, using the secret words starting at `secret`.
+yo_internal yo_inline u64 yo_impl_hash_merge(u64 const* accumulators, u64 const* secret, u64 start) {
+    u64 hash = start;
+    for (u32 lane = 0; lane < YO_HASH_LANE_COUNT; lane += 2) {
+        hash += yo_impl_hash_mix(accumulators[lane] ^ secret[lane], accumulators[lane + 1] ^ secret[lane + 1]);
+    }
+    return yo_impl_hash_avalanche(hash);
+}
+
+/// Accumulate the last 1 to `YO_HASH_STRIPE_SIZE` bytes of a long input, padded with zeros, and
+/// merge the accumulators into the final hash.
+yo_internal yo_Hash128 yo_impl_hash_finish_long(
+    u64*      accumulators,
+    usize     stripe_count,
+    u8 const* tail,
+    usize     tail_size,
+    u64       total_size,
+    u64       seed,
+    bool      wide) {
+    yo_assert((tail_size != 0) && (tail_size <= YO_HASH_STRIPE_SIZE));
+
+    u8 last_stripe[YO_HASH_STRIPE_SIZE] = {0};
+    yo_discard_value(memcpy(last_stripe, tail, tail_size));
+    yo_impl_hash_consume_stripes(accumulators, &stripe_count, last_stripe, 1);
+
+    yo_Hash128 hash = {.low = yo_impl_hash_merge(accumulators, yo_impl_hash_secret + 3, (total_size * YO_IMPL_HASH_PRIME64_1) ^ seed)};
+    if (wide) {
+        hash.high = yo_impl_hash_merge(accumulators, yo_impl_hash_secret + 11, ~(total_size * YO_IMPL_HASH_PRIME64_2) ^ seed);
+    }
+    return hash;
+}
+
+yo_internal yo_Hash128 yo_impl_hash_long(u8 const* bytes, usize size_bytes, u64 seed, bool wide) {
+    u64 accumulators[YO_HASH_LANE_COUNT];
+    yo_impl_hash_init_accumulators(accumulators, seed);
+
+    // Leave at least one byte for the last stripe.
+    usize stripe_count      = 0;
+    usize full_stripe_count = (size_bytes - 1) / YO_HASH_STRIPE_SIZE;
+    yo_impl_hash_consume_stripes(accumulators, &stripe_count, bytes, full_stripe_count);
+
+    usize consumed_size = full_stripe_count * YO_HASH_STRIPE_SIZE;
+    return yo_impl_hash_finish_long(accumulators, stripe_count, bytes + consumed_size, size_bytes - consumed_size, size_bytes, seed, wide);
+}
+
+// -----------------------------------------------------------------------------
+// One-shot hashing.
+// -----------------------------------------------------------------------------
+
+u64 yo_hash_bytes(void const* data, usize size_bytes, u64 seed) {
+    yo_assert((data != NULL) || (size_bytes == 0));
+
+    u8 const* bytes = yo_cast(u8 const*, data);
+    if (size_bytes <= YO_HASH_SHORT_INPUT_MAX_SIZE) {
+        return yo_impl_hash_short(bytes, size_bytes, seed, yo_impl_hash_secret);
+    }
+    return yo_impl_hash_long(bytes, size_bytes, seed, false).low;
+}
+
+yo_Hash128 yo_hash128_bytes(void const* data, usize size_bytes, u64 seed) {
+    yo_assert((data != NULL) || (size_bytes == 0));
+
+    u8 const* bytes = yo_cast(u8 const*, data);
+    if (size_bytes <= YO_HASH_SHORT_INPUT_MAX_SIZE) {
+        return (yo_Hash128){
+            .low  = yo_impl_hash_short(bytes, size_bytes, seed, yo_impl_hash_secret),
+            .high = yo_impl_hash_short(bytes, size_bytes, seed, yo_impl_hash_secret + 2),
+        };
+    }
+    return yo_impl_hash_long(bytes, size_bytes, seed, true);
+}
+
+// -----------------------------------------------------------------------------
+// Streaming hashing.
+// -----------------------------------------------------------------------------
+
+yo_HashState yo_make_hash_state(u64 seed) {
+    yo_HashState state = {.seed = seed};
+    yo_impl_hash_init_accumulators(state.accumulators, seed);
+    return state;
+}
+
+void yo_hash_state_update(yo_HashState* state, void const* data, usize size_bytes) {
+    yo_assert_not_null(state);
+    yo_assert((data != NULL) || (size_bytes == 0));
+
+    u8 const* input = yo_cast(u8 const*, data);
+    state->total_size += size_bytes;
+
+    while (size_bytes != 0) {
+        // More input follows the buffered bytes, thus they can be accumulated.
+        if (state->buffer_size == YO_HASH_SHORT_INPUT_MAX_SIZE) {
+            yo_impl_hash_consume_stripes(state->accumulators, &state->stripe_count, state->buffer, YO_HASH_SHORT_INPUT_MAX_SIZE / YO_HASH_STRIPE_SIZE);
+            state->buffer_size = 0;
+        }
+
+        // Accumulate large inputs in place, only buffering the last stripe.
+        if ((state->buffer_size == 0) && (size_bytes > YO_HASH_SHORT_INPUT_MAX_SIZE)) {
+            usize stripe_count = (size_bytes - 1) / YO_HASH_STRIPE_SIZE;
+            yo_impl_hash_consume_stripes(state->accumulators, &state->stripe_count, input, stripe_count);
+            input += stripe_count * YO_HASH_STRIPE_SIZE;
+            size_bytes -= stripe_count * YO_HASH_STRIPE_SIZE;
+        }
+
+        usize copy_size = yo_min_value(size_bytes, YO_HASH_SHORT_INPUT_MAX_SIZE - state->buffer_size);
+        yo_discard_value(memcpy(state->buffer + state->buffer_size, input, copy_size));
+        state->buffer_size += copy_size;
+        input += copy_size;
+        size_bytes -= copy_size;
+    }
+}
+
+yo_internal yo_Hash128 yo_impl_hash_state_digest(yo_HashState const* state, bool wide) {
+    yo_assert_not_null(state);
+
+    // Short streams are still entirely buffered.
+    if (state->total_size <= YO_HASH_SHORT_INPUT_MAX_SIZE) {
+        yo_Hash128 hash = {.low = yo_impl_hash_short(state->buffer, state->buffer_size, state->seed, yo_impl_hash_secret)};
+        if (wide) {
+            hash.high = yo_impl_hash_short(state->buffer, state->buffer_size, state->seed, yo_impl_hash_secret + 2);
+        }
+        return hash;
+    }
+
+    u64 accumulators[YO_HASH_LANE_COUNT];
+    yo_discard_value(memcpy(accumulators, state->accumulators, yo_size_of(accumulators)));
+
+    usize stripe_count      = state->stripe_count;
+    usize full_stripe_count = (state->buffer_size - 1) / YO_HASH_STRIPE_SIZE;
+    yo_impl_hash_consume_stripes(accumulators, &stripe_count, state->buffer, full_stripe_count);
+
+    usize consumed_size = full_stripe_count * YO_HASH_STRIPE_SIZE;
+    return yo_impl_hash_finish_long(
+        accumulators,
+        stripe_count,
+        state->buffer + consumed_size,
+        state->buffer_size - consumed_size,
+        state->total_size,
+        state->seed,
+        wide);
+}
+
+u64 yo_hash_state_digest(yo_HashState const* state) {
+    return yo_impl_hash_state_digest(state, false).low;
+}
+
+yo_Hash128 yo_hash_state_digest128(yo_HashState const* state) {
+    return yo_impl_hash_state_digest(state, true);
+}
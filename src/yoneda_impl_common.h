@@ -0,0 +1,43 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation details shared across the library source files.
+/// File name: yoneda_impl_common.h
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#ifndef YONEDA_IMPL_COMMON_H
+#define YONEDA_IMPL_COMMON_H
+
+#include <yoneda_core.h>
+#include <yoneda_log.h>
+
+/// Return from a failed allocation, aborting the program if YO_ENABLE_ABORT_AT_MEMORY_ERROR is set.
+#if YO_ENABLE_ABORT_AT_MEMORY_ERROR
+#    define yo_impl_return_from_memory_error()                                               \
+        do {                                                                                 \
+            yo_log_fatal("YO_ENABLE_ABORT_AT_MEMORY_ERROR active, aborting the program..."); \
+            yo_abort_program();                                                              \
+        } while (0)
+#else
+#    define yo_impl_return_from_memory_error() return NULL
+#endif
+
+#endif  // YONEDA_IMPL_COMMON_H
@@ -0,0 +1,111 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the string interning table.
+/// File name: yoneda_interner.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_interner.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+yo_Interner yo_make_interner(yo_Arena* arena, usize capacity, usize pool_size) {
+    yo_assert_not_null(arena);
+
+    yo_Interner interner    = {.pool = yo_make_reserved_arena(pool_size, YO_INTERNER_POOL_COMMIT_SIZE)};
+    interner.ids            = yo_make_map(arena, yo_String, u32, capacity);
+    interner.ids.hash_proc  = yo_map_hash_string;
+    interner.ids.equal_proc = yo_map_equal_string;
+
+    // The strings table is made last, so that it grows in place while nothing else is allocated
+    // from the arena.
+    yo_String* strings = yo_make_dynarray(arena, yo_String, capacity);
+    if (yo_unlikely((interner.pool.buf == NULL) || (interner.ids.capacity == 0) || (strings == NULL))) {
+        yo_log_error("Unable to allocate the memory of the interner.");
+        return interner;
+    }
+    interner.strings = strings;
+
+    return interner;
+}
+
+void yo_destroy_interner(yo_Interner* interner) {
+    yo_assert_not_null(interner);
+
+    if (interner->pool.buf != NULL) {
+        yo_destroy_owned_arena(&interner->pool);
+    }
+    interner->pool    = yo_make_default(yo_Arena);
+    interner->strings = NULL;
+}
+
+u32 yo_interner_intern(yo_Interner* interner, yo_String str) {
+    yo_assert_not_null(interner);
+
+    u32* existing_id = yo_cast(u32*, yo_map_get(&interner->ids, &str));
+    if (existing_id != NULL) {
+        return *existing_id;
+    }
+
+    if (yo_unlikely(interner->frozen || (interner->strings == NULL))) {
+        return YO_INTERNER_INVALID_ID;
+    }
+
+    // Make room for the string before it gets an identifier in the map, so that running out of
+    // memory leaves the interner unchanged.
+    yo_String* strings = yo_impl_dynarray_try_reserve_extra(interner->strings, 1, yo_size_of(yo_String));
+    if (yo_unlikely(strings == NULL)) {
+        return YO_INTERNER_INVALID_ID;
+    }
+    interner->strings = strings;
+
+    // Copy the string along with a zero terminator.
+    char* buf = yo_arena_alloc_uninit(&interner->pool, char, str.length + 1);
+    if (yo_unlikely(buf == NULL)) {
+        return YO_INTERNER_INVALID_ID;
+    }
+    yo_memory_copy(yo_cast(u8*, buf), yo_cast(u8 const*, str.buf), str.length);
+    buf[str.length] = 0;
+
+    yo_String interned = {.buf = buf, .length = str.length};
+    u32       id       = yo_interner_count(interner);
+    if (yo_unlikely(yo_map_insert(&interner->ids, &interned, &id) == NULL)) {
+        return YO_INTERNER_INVALID_ID;
+    }
+    yo_dynarray_push(interner->strings, interned);
+
+    return id;
+}
+
+u32 yo_interner_find(yo_Interner const* interner, yo_String str) {
+    yo_assert_not_null(interner);
+
+    u32 const* id = yo_cast(u32 const*, yo_map_get(&interner->ids, &str));
+    return (id != NULL) ? *id : YO_INTERNER_INVALID_ID;
+}
+
+void yo_interner_freeze(yo_Interner* interner) {
+    yo_assert_not_null(interner);
+    interner->frozen = true;
+}
@@ -0,0 +1,438 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the open-addressing hash map.
+/// File name: yoneda_map.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_map.h>
+
+#include <string.h>
+#include <yoneda_assert.h>
+#include <yoneda_bit.h>
+#include <yoneda_hash.h>
+#include <yoneda_log.h>
+
+#if defined(YO_ARCH_SIMD_SSE2)
+#    include <emmintrin.h>
+#elif defined(YO_ARCH_SIMD_NEON)
+#    include <arm_neon.h>
+#endif
+
+#include "yoneda_impl_common.h"
+
+// -----------------------------------------------------------------------------
+// Control groups.
+//
+// Matching a group yields a mask with a set bit for each matching control byte. NEON has no
+// equivalent to the SSE2 `movemask`, so its masks have 4 bits per control byte, of which only the
+// highest is kept.
+// -----------------------------------------------------------------------------
+
+#if defined(YO_ARCH_SIMD_NEON)
+#    define YO_IMPL_MAP_LANE_SHIFT 2
+#else
+#    define YO_IMPL_MAP_LANE_SHIFT 0
+#endif
+
+#if defined(YO_ARCH_SIMD_SSE2)
+
+yo_internal yo_inline u64 yo_impl_map_match_byte(u8 const* group, u8 value) {
+    __m128i controls = _mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, group)));
+    return yo_cast(u64, _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(yo_cast(char, value)))));
+}
+
+/// Match the empty and deleted control bytes, which are the only ones with the highest bit set.
+yo_internal yo_inline u64 yo_impl_map_match_free(u8 const* group) {
+    return yo_cast(u64, _mm_movemask_epi8(_mm_loadu_si128(yo_cast(__m128i const*, yo_cast(void const*, group)))));
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_full(u8 const* group) {
+    return ~yo_impl_map_match_free(group) & 0xFFFF;
+}
+
+#elif defined(YO_ARCH_SIMD_NEON)
+
+yo_internal yo_inline u64 yo_impl_map_narrow_mask(uint8x16_t lanes) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_byte(u8 const* group, u8 value) {
+    return yo_impl_map_narrow_mask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(value)));
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_free(u8 const* group) {
+    return yo_impl_map_narrow_mask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(YO_MAP_CONTROL_EMPTY)));
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_full(u8 const* group) {
+    return ~yo_impl_map_match_free(group) & 0x8888888888888888ULL;
+}
+
+#else
+
+yo_internal yo_inline u64 yo_impl_map_match_byte(u8 const* group, u8 value) {
+    u64 mask = 0;
+    for (u32 lane = 0; lane < YO_MAP_GROUP_WIDTH; ++lane) {
+        mask |= yo_cast(u64, group[lane] == value) << lane;
+    }
+    return mask;
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_free(u8 const* group) {
+    u64 mask = 0;
+    for (u32 lane = 0; lane < YO_MAP_GROUP_WIDTH; ++lane) {
+        mask |= yo_cast(u64, group[lane] >> 7) << lane;
+    }
+    return mask;
+}
+
+yo_internal yo_inline u64 yo_impl_map_match_full(u8 const* group) {
+    return ~yo_impl_map_match_free(group) & 0xFFFF;
+}
+
+#endif
+
+yo_internal yo_inline usize yo_impl_map_first_lane(u64 mask) {
+    return yo_u64_lsb_index(mask) >> YO_IMPL_MAP_LANE_SHIFT;
+}
+
+yo_internal yo_inline usize yo_impl_map_last_lane(u64 mask) {
+    return yo_u64_msb_index(mask) >> YO_IMPL_MAP_LANE_SHIFT;
+}
+
+// -----------------------------------------------------------------------------
+// Table management.
+// -----------------------------------------------------------------------------
+
+yo_internal u64 yo_impl_map_hash_bytes(void const* key, usize key_size) {
+    return yo_hash_bytes(key, key_size, 0);
+}
+
+yo_internal u64 yo_impl_map_hash_u32(void const* key, usize key_size) {
+    yo_discard_value(key_size);
+
+    u32 value;
+    yo_discard_value(memcpy(&value, key, yo_size_of(value)));
+    return yo_hash_u64(value);
+}
+
+yo_internal u64 yo_impl_map_hash_u64(void const* key, usize key_size) {
+    yo_discard_value(key_size);
+
+    u64 value;
+    yo_discard_value(memcpy(&value, key, yo_size_of(value)));
+    return yo_hash_u64(value);
+}
+
+yo_internal bool yo_impl_map_equal_bytes(void const* lhs, void const* rhs, usize key_size) {
+    return memcmp(lhs, rhs, key_size) == 0;
+}
+
+/// Maximum number of entries and deleted slots a table can hold before being rehashed.
+yo_internal yo_inline usize yo_impl_map_max_load(usize capacity) {
+    return capacity - capacity / 8;
+}
+
+/// Size of the memory block holding the slots followed by the control bytes of a table.
+yo_internal yo_inline usize yo_impl_map_block_size(usize capacity, usize slot_size) {
+    return capacity * slot_size + capacity + YO_MAP_GROUP_WIDTH;
+}
+
+yo_internal yo_inline u8* yo_impl_map_slot(yo_Map const* map, usize idx) {
+    return map->slots + idx * map->slot_size;
+}
+
+yo_internal yo_inline void yo_impl_map_set_control(yo_Map* map, usize idx, u8 control) {
+    map->controls[idx] = control;
+
+    // Keep the copy of the first group up to date.
+    if (idx < YO_MAP_GROUP_WIDTH) {
+        map->controls[map->capacity + idx] = control;
+    }
+}
+
+/// Find the slot holding a given key.
+///
+/// Return: The index of the slot, or the capacity of the map if the key isn't in the map.
+yo_internal usize yo_impl_map_find(yo_Map const* map, void const* key, u64 hash) {
+    usize mask     = map->capacity - 1;
+    usize position = yo_cast(usize, hash >> 7) & mask;
+    u8    h2       = yo_cast(u8, hash & 0x7F);
+
+    for (usize stride = YO_MAP_GROUP_WIDTH;; stride += YO_MAP_GROUP_WIDTH) {
+        u8 const* group = map->controls + position;
+
+        for (u64 matches = yo_impl_map_match_byte(group, h2); matches != 0; matches &= matches - 1) {
+            usize idx = (position + yo_impl_map_first_lane(matches)) & mask;
+            if (map->equal_proc(key, yo_impl_map_slot(map, idx), map->key_size)) {
+                return idx;
+            }
+        }
+
+        // An entry is never placed past a group with empty slots.
+        if (yo_impl_map_match_byte(group, YO_MAP_CONTROL_EMPTY) != 0) {
+            return map->capacity;
+        }
+
+        position = (position + stride) & mask;
+    }
+}
+
+/// Find the first empty or deleted slot in the probe sequence of a hash.
+yo_internal usize yo_impl_map_find_free(yo_Map const* map, u64 hash) {
+    usize mask     = map->capacity - 1;
+    usize position = yo_cast(usize, hash >> 7) & mask;
+
+    for (usize stride = YO_MAP_GROUP_WIDTH;; stride += YO_MAP_GROUP_WIDTH) {
+        u64 free_slots = yo_impl_map_match_free(map->controls + position);
+        if (free_slots != 0) {
+            return (position + yo_impl_map_first_lane(free_slots)) & mask;
+        }
+
+        position = (position + stride) & mask;
+    }
+}
+
+yo_internal u8* yo_impl_map_alloc_table(yo_Map const* map, usize capacity) {
+    usize block_size = yo_impl_map_block_size(capacity, map->slot_size);
+    if (map->allocator != NULL) {
+        return yo_allocator_alloc_align(map->allocator, block_size, map->slot_alignment);
+    }
+    return yo_arena_alloc_uninit_align(map->arena, block_size, map->slot_alignment);
+}
+
+yo_internal void yo_impl_map_free_table(yo_Map const* map) {
+    if ((map->allocator != NULL) && (map->slots != NULL)) {
+        yo_allocator_free(map->allocator, map->slots, yo_impl_map_block_size(map->capacity, map->slot_size));
+    }
+}
+
+/// Move all entries to a new table with a given capacity, leaving out the deleted slots.
+yo_internal yo_Status yo_impl_map_rehash(yo_Map* map, usize new_capacity) {
+    u8* block = yo_impl_map_alloc_table(map, new_capacity);
+    if (yo_unlikely(block == NULL)) {
+        yo_log_error_fmt("Unable to allocate a map table with capacity for %zu entries.", new_capacity);
+        return YO_STATUS_FAILED;
+    }
+
+    yo_Map old_map     = *map;
+    map->slots         = block;
+    map->controls      = block + new_capacity * map->slot_size;
+    map->capacity      = new_capacity;
+    map->deleted_count = 0;
+    yo_memory_set(map->controls, new_capacity + YO_MAP_GROUP_WIDTH, YO_MAP_CONTROL_EMPTY);
+
+    // No key of the old table is equal to another, so entries can be placed without comparisons.
+    yo_map_for_each_slot(old_idx, &old_map) {
+        u8 const* old_slot = yo_impl_map_slot(&old_map, old_idx);
+        u64       hash     = map->hash_proc(old_slot, map->key_size);
+        usize     idx      = yo_impl_map_find_free(map, hash);
+
+        yo_impl_map_set_control(map, idx, yo_cast(u8, hash & 0x7F));
+        yo_memory_copy(yo_impl_map_slot(map, idx), old_slot, map->slot_size);
+    }
+
+    yo_impl_map_free_table(&old_map);
+    return YO_STATUS_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Map operations.
+// -----------------------------------------------------------------------------
+
+yo_Map yo_make_map_raw(
+    yo_Arena*           arena,
+    yo_Allocator const* allocator,
+    usize               key_size,
+    u32                 key_alignment,
+    usize               value_size,
+    u32                 value_alignment,
+    usize               capacity) {
+    yo_assert_msg((arena == NULL) != (allocator == NULL), "A map needs either an arena or an allocator.");
+    yo_assert_msg(key_size != 0, "Map keys should have a non-zero size.");
+
+    usize value_offset   = yo_align_forward(key_size, value_alignment);
+    u32   slot_alignment = yo_max_value(key_alignment, value_alignment);
+
+    yo_Map map = {
+        .key_size       = key_size,
+        .value_size     = value_size,
+        .value_offset   = value_offset,
+        .slot_size      = yo_align_forward(value_offset + value_size, slot_alignment),
+        .slot_alignment = slot_alignment,
+        .hash_proc      = yo_impl_map_hash_bytes,
+        .equal_proc     = yo_impl_map_equal_bytes,
+        .arena          = arena,
+        .allocator      = allocator,
+    };
+
+    // Keys of the size of an integer only need to be mixed.
+    if (key_size == yo_size_of(u32)) {
+        map.hash_proc = yo_impl_map_hash_u32;
+    } else if (key_size == yo_size_of(u64)) {
+        map.hash_proc = yo_impl_map_hash_u64;
+    }
+
+    usize table_capacity = YO_MAP_GROUP_WIDTH;
+    while (yo_impl_map_max_load(table_capacity) < capacity) {
+        table_capacity <<= 1;
+    }
+
+    yo_discard_value(yo_impl_map_rehash(&map, table_capacity));
+    return map;
+}
+
+void yo_destroy_map(yo_Map* map) {
+    if (yo_unlikely(map == NULL)) {
+        return;
+    }
+
+    yo_impl_map_free_table(map);
+    map->slots         = NULL;
+    map->controls      = NULL;
+    map->capacity      = 0;
+    map->count         = 0;
+    map->deleted_count = 0;
+}
+
+void* yo_map_insert(yo_Map* map, void const* key, void const* value) {
+    yo_assert_not_null(map);
+    yo_assert_not_null(key);
+
+    u64 hash = map->hash_proc(key, map->key_size);
+
+    usize idx = (map->capacity != 0) ? yo_impl_map_find(map, key, hash) : 0;
+    if (idx < map->capacity) {
+        u8* existing_value = yo_impl_map_slot(map, idx) + map->value_offset;
+        if (value != NULL) {
+            yo_memory_copy(existing_value, yo_cast(u8 const*, value), map->value_size);
+        }
+        return existing_value;
+    }
+
+    if (map->count + map->deleted_count + 1 > yo_impl_map_max_load(map->capacity)) {
+        // Grow only if the entries take more than half of the maximum load, otherwise getting rid
+        // of the deleted slots is enough.
+        usize new_capacity = map->capacity;
+        if ((map->capacity == 0) || (2 * (map->count + 1) > yo_impl_map_max_load(map->capacity))) {
+            new_capacity = yo_max_value(2 * map->capacity, YO_MAP_GROUP_WIDTH);
+        }
+
+        if (yo_unlikely(yo_impl_map_rehash(map, new_capacity) == YO_STATUS_FAILED)) {
+            return NULL;
+        }
+    }
+
+    idx = yo_impl_map_find_free(map, hash);
+    if (map->controls[idx] == YO_MAP_CONTROL_DELETED) {
+        --map->deleted_count;
+    }
+    yo_impl_map_set_control(map, idx, yo_cast(u8, hash & 0x7F));
+    ++map->count;
+
+    // A null value inserts a zeroed value.
+    u8* slot = yo_impl_map_slot(map, idx);
+    yo_memory_copy(slot, yo_cast(u8 const*, key), map->key_size);
+    if (value != NULL) {
+        yo_memory_copy(slot + map->value_offset, yo_cast(u8 const*, value), map->value_size);
+    } else {
+        yo_memory_set(slot + map->value_offset, map->value_size, 0);
+    }
+
+    return slot + map->value_offset;
+}
+
+void* yo_map_get(yo_Map const* map, void const* key) {
+    yo_assert_not_null(map);
+    yo_assert_not_null(key);
+
+    if (map->count == 0) {
+        return NULL;
+    }
+
+    usize idx = yo_impl_map_find(map, key, map->hash_proc(key, map->key_size));
+    return (idx < map->capacity) ? (yo_impl_map_slot(map, idx) + map->value_offset) : NULL;
+}
+
+bool yo_map_remove(yo_Map* map, void const* key) {
+    yo_assert_not_null(map);
+    yo_assert_not_null(key);
+
+    if (map->count == 0) {
+        return false;
+    }
+
+    usize idx = yo_impl_map_find(map, key, map->hash_proc(key, map->key_size));
+    if (idx == map->capacity) {
+        return false;
+    }
+
+    // If no group containing the slot was ever full, no probe sequence ever went past the slot, and
+    // it can be made empty again instead of deleted.
+    usize idx_before   = (idx - YO_MAP_GROUP_WIDTH) & (map->capacity - 1);
+    u64   empty_after  = yo_impl_map_match_byte(map->controls + idx, YO_MAP_CONTROL_EMPTY);
+    u64   empty_before = yo_impl_map_match_byte(map->controls + idx_before, YO_MAP_CONTROL_EMPTY);
+
+    bool was_never_full = (empty_before != 0) && (empty_after != 0) &&
+                          (yo_impl_map_first_lane(empty_after) + (YO_MAP_GROUP_WIDTH - 1 - yo_impl_map_last_lane(empty_before)) < YO_MAP_GROUP_WIDTH);
+    if (was_never_full) {
+        yo_impl_map_set_control(map, idx, YO_MAP_CONTROL_EMPTY);
+    } else {
+        yo_impl_map_set_control(map, idx, YO_MAP_CONTROL_DELETED);
+        ++map->deleted_count;
+    }
+
+    --map->count;
+    return true;
+}
+
+void yo_map_clear(yo_Map* map) {
+    yo_assert_not_null(map);
+
+    if (map->controls != NULL) {
+        yo_memory_set(map->controls, map->capacity + YO_MAP_GROUP_WIDTH, YO_MAP_CONTROL_EMPTY);
+    }
+    map->count         = 0;
+    map->deleted_count = 0;
+}
+
+usize yo_impl_map_next_full_slot(yo_Map const* map, usize idx) {
+    for (; idx < map->capacity; idx += YO_MAP_GROUP_WIDTH) {
+        u64 full_slots = yo_impl_map_match_full(map->controls + idx);
+        if (full_slots != 0) {
+            // Slots found in the copy of the first group are past the end of the table.
+            return yo_min_value(idx + yo_impl_map_first_lane(full_slots), map->capacity);
+        }
+    }
+    return map->capacity;
+}
+
+u64 yo_map_hash_string(void const* key, usize key_size) {
+    yo_assert(key_size == yo_size_of(yo_String));
+    return yo_hash_string(*yo_cast(yo_String const*, key), 0);
+}
+
+bool yo_map_equal_string(void const* lhs, void const* rhs, usize key_size) {
+    yo_assert(key_size == yo_size_of(yo_String));
+    return yo_string_equal(*yo_cast(yo_String const*, lhs), *yo_cast(yo_String const*, rhs));
+}
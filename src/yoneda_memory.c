@@ -31,21 +31,19 @@
 #include <yoneda_log.h>
 #include <yoneda_math.h>
 
+#include "yoneda_impl_common.h"
+
 #if defined(YO_OS_WINDOWS)
 #    include <Windows.h>
 #elif defined(YO_OS_UNIX)
+#    include <errno.h>
+#    include <stdio.h>
 #    include <sys/mman.h>
+#    include <unistd.h>
 #endif
 
-#if YO_ENABLE_ABORT_AT_MEMORY_ERROR
-#    include <yoneda_log.h>
-#    define yo_impl_return_from_memory_error()                                               \
-        do {                                                                                 \
-            yo_log_fatal("YO_ENABLE_ABORT_AT_MEMORY_ERROR active, aborting the program..."); \
-            yo_abort_program();                                                              \
-        } while (0)
-#else
-#    define yo_impl_return_from_memory_error() return NULL
+#ifndef YO_DEFAULT_HUGE_PAGE_SIZE
+#    define YO_DEFAULT_HUGE_PAGE_SIZE yo_mebibytes(2)
 #endif
 
 // -----------------------------------------------------------------------------
@@ -79,7 +77,7 @@ u8* yo_memory_virtual_alloc(usize size_bytes) {
 #    endif
 #elif defined(YO_OS_UNIX)
     memory = yo_cast(u8*, mmap(NULL, size_bytes, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
-    if (yo_likely(yo_cast(void*, memory) != MAP_FAILED)) {
+    if (yo_unlikely(yo_cast(void*, memory) == MAP_FAILED)) {
         memory = NULL;
 #    if YO_ENABLE_ABORT_AT_MEMORY_ERROR
         yo_log_error_fmt("OS failed to allocate memory due to: %s", strerror(errno));
@@ -107,6 +105,373 @@ void yo_memory_virtual_free(u8* memory, usize size_bytes) {
 #endif
 }
 
+usize yo_memory_page_size(void) {
+    yo_global usize page_size = 0;
+
+    if (yo_unlikely(page_size == 0)) {
+#if defined(YO_OS_WINDOWS)
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        page_size = yo_cast(usize, system_info.dwPageSize);
+#elif defined(YO_OS_UNIX)
+        long result = sysconf(_SC_PAGESIZE);
+        page_size   = (result > 0) ? yo_cast(usize, result) : yo_kibibytes(4);
+#else
+        page_size = yo_kibibytes(4);
+#endif
+    }
+
+    return page_size;
+}
+
+u8* yo_memory_virtual_reserve(usize size_bytes) {
+    u8* memory = NULL;
+
+#if defined(YO_OS_WINDOWS)
+    memory = yo_cast(u8*, VirtualAlloc(NULL, size_bytes, MEM_RESERVE, PAGE_NOACCESS));
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("OS failed to reserve %zu bytes with error code: %lu", size_bytes, GetLastError());
+    }
+#elif defined(YO_OS_UNIX)
+    memory = yo_cast(u8*, mmap(NULL, size_bytes, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0));
+    if (yo_unlikely(yo_cast(void*, memory) == MAP_FAILED)) {
+        memory = NULL;
+        yo_log_error_fmt("OS failed to reserve %zu bytes due to: %s", size_bytes, strerror(errno));
+    }
+#endif
+
+    return memory;
+}
+
+yo_Status yo_memory_virtual_commit(u8* memory, usize size_bytes) {
+    yo_assert_not_null(memory);
+    yo_assert_msg(
+        yo_align_forward(yo_cast(uptr, memory), yo_memory_page_size()) == yo_cast(uptr, memory),
+        "Committed range should start at a page boundary.");
+
+#if defined(YO_OS_WINDOWS)
+    void* result = VirtualAlloc(memory, size_bytes, MEM_COMMIT, PAGE_READWRITE);
+    if (yo_unlikely(result == NULL)) {
+        yo_log_error_fmt("OS failed to commit %zu bytes with error code: %lu", size_bytes, GetLastError());
+        return YO_STATUS_FAILED;
+    }
+#elif defined(YO_OS_UNIX)
+    if (yo_unlikely(mprotect(memory, size_bytes, PROT_READ | PROT_WRITE) == -1)) {
+        yo_log_error_fmt("OS failed to commit %zu bytes due to: %s", size_bytes, strerror(errno));
+        return YO_STATUS_FAILED;
+    }
+#endif
+
+    return YO_STATUS_OK;
+}
+
+yo_Status yo_memory_virtual_decommit(u8* memory, usize size_bytes) {
+    yo_assert_not_null(memory);
+
+#if defined(YO_OS_WINDOWS)
+    if (yo_unlikely(VirtualFree(memory, size_bytes, MEM_DECOMMIT) == FALSE)) {
+        yo_log_error_fmt("OS failed to decommit %zu bytes with error code: %lu", size_bytes, GetLastError());
+        return YO_STATUS_FAILED;
+    }
+#elif defined(YO_OS_UNIX)
+    // Replacing the range with a fresh inaccessible mapping releases both the pages and the commit charge.
+    void* result = mmap(memory, size_bytes, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE | MAP_FIXED, -1, 0);
+    if (yo_unlikely(result == MAP_FAILED)) {
+        yo_log_error_fmt("OS failed to decommit %zu bytes due to: %s", size_bytes, strerror(errno));
+        return YO_STATUS_FAILED;
+    }
+#endif
+
+    return YO_STATUS_OK;
+}
+
+yo_Status yo_memory_virtual_purge(u8* memory, usize size_bytes, bool lazy) {
+    yo_assert_not_null(memory);
+
+#if defined(YO_OS_WINDOWS)
+    if (lazy) {
+        if (yo_unlikely(VirtualAlloc(memory, size_bytes, MEM_RESET, PAGE_READWRITE) == NULL)) {
+            yo_log_error_fmt("OS failed to purge %zu bytes with error code: %lu", size_bytes, GetLastError());
+            return YO_STATUS_FAILED;
+        }
+        return YO_STATUS_OK;
+    }
+
+    if (yo_unlikely(yo_memory_virtual_decommit(memory, size_bytes) == YO_STATUS_FAILED)) {
+        return YO_STATUS_FAILED;
+    }
+    return yo_memory_virtual_commit(memory, size_bytes);
+#elif defined(YO_OS_UNIX)
+    i32 result = 0;
+#    if defined(MADV_FREE)
+    if (lazy) {
+        result = madvise(memory, size_bytes, MADV_FREE);
+    }
+#    else
+    lazy = false;  // Fallback to an eager purge.
+#    endif
+
+    if (!lazy) {
+#    if defined(YO_OS_LINUX)
+        result = madvise(memory, size_bytes, MADV_DONTNEED);
+#    else
+        // Outside of Linux, MADV_DONTNEED doesn't guarantee the pages to be zeroed.
+        void* remapped = mmap(memory, size_bytes, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0);
+        result         = (remapped == MAP_FAILED) ? -1 : 0;
+#    endif
+    }
+
+    if (yo_unlikely(result == -1)) {
+        yo_log_error_fmt("OS failed to purge %zu bytes due to: %s", size_bytes, strerror(errno));
+        return YO_STATUS_FAILED;
+    }
+    return YO_STATUS_OK;
+#endif
+}
+
+usize yo_memory_huge_page_size(void) {
+    yo_global usize huge_page_size = 0;
+
+    if (yo_unlikely(huge_page_size == 0)) {
+        huge_page_size = YO_DEFAULT_HUGE_PAGE_SIZE;
+
+#if defined(YO_OS_WINDOWS)
+        SIZE_T large_page_size = GetLargePageMinimum();
+        if (large_page_size != 0) {
+            huge_page_size = yo_cast(usize, large_page_size);
+        }
+#elif defined(YO_OS_LINUX)
+        FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+        if (file != NULL) {
+            unsigned long long size = 0;
+            if ((fscanf(file, "%llu", &size) == 1) && yo_is_pow_of_two(size)) {
+                huge_page_size = yo_cast(usize, size);
+            }
+            yo_discard_value(fclose(file));
+        }
+#endif
+    }
+
+    return huge_page_size;
+}
+
+#if defined(YO_OS_UNIX)
+/// Map a range of memory whose start is aligned to `alignment` by over-allocating and trimming the
+/// unaligned head and tail of the mapping.
+yo_internal u8* yo_impl_memory_map_aligned(usize size_bytes, usize alignment, i32 protection, i32 map_flags) {
+    usize map_size = size_bytes + alignment;
+    u8*   memory   = yo_cast(u8*, mmap(NULL, map_size, protection, map_flags, -1, 0));
+    if (yo_unlikely(yo_cast(void*, memory) == MAP_FAILED)) {
+        return NULL;
+    }
+
+    u8*   aligned   = yo_cast(u8*, yo_align_forward(yo_cast(uptr, memory), alignment));
+    usize head_size = yo_cast(usize, aligned - memory);
+    usize tail_size = map_size - head_size - size_bytes;
+    if (head_size != 0) {
+        yo_discard_value(munmap(memory, head_size));
+    }
+    if (tail_size != 0) {
+        yo_discard_value(munmap(aligned + size_bytes, tail_size));
+    }
+
+    return aligned;
+}
+
+/// Check whether the system allows transparent huge pages to be used via `madvise`.
+yo_internal bool yo_impl_transparent_huge_pages_enabled(void) {
+    bool  enabled = false;
+    FILE* file    = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (file != NULL) {
+        char mode[128] = {0};
+        if (fgets(mode, yo_size_of(mode), file) != NULL) {
+            enabled = (strstr(mode, "[never]") == NULL);
+        }
+        yo_discard_value(fclose(file));
+    }
+    return enabled;
+}
+
+/// Advise the OS to back a range with transparent huge pages.
+///
+/// Return: The page size that will back the range.
+yo_internal usize yo_impl_memory_advise_huge_pages(u8* memory, usize size_bytes) {
+#    if defined(MADV_HUGEPAGE)
+    if ((madvise(memory, size_bytes, MADV_HUGEPAGE) == 0) && yo_impl_transparent_huge_pages_enabled()) {
+        return yo_memory_huge_page_size();
+    }
+#    else
+    yo_discard_value(memory);
+    yo_discard_value(size_bytes);
+#    endif
+    return yo_memory_page_size();
+}
+#endif
+
+yo_VirtualMemory yo_memory_virtual_alloc_with_flags(usize size_bytes, u32 flags) {
+    if (!(flags & YO_MEMORY_FLAG_HUGE_PAGES)) {
+        usize page_size = yo_memory_page_size();
+        usize size      = yo_align_forward(size_bytes, page_size);
+        u8*   memory    = yo_memory_virtual_alloc(size);
+        return (yo_VirtualMemory){.buf = memory, .size_bytes = (memory != NULL) ? size : 0, .page_size = page_size};
+    }
+
+    usize huge_page_size = yo_memory_huge_page_size();
+    usize size           = yo_align_forward(size_bytes, huge_page_size);
+
+#if defined(YO_OS_WINDOWS)
+    // Requires the SeLockMemoryPrivilege, otherwise the call fails and regular pages are used.
+    u8* memory = yo_cast(u8*, VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+    if (memory != NULL) {
+        return (yo_VirtualMemory){.buf = memory, .size_bytes = size, .page_size = huge_page_size};
+    }
+
+    memory = yo_memory_virtual_alloc(size);
+    return (yo_VirtualMemory){.buf = memory, .size_bytes = (memory != NULL) ? size : 0, .page_size = yo_memory_page_size()};
+#elif defined(YO_OS_UNIX)
+    u8* memory = NULL;
+
+#    if defined(MAP_HUGETLB)
+    // Explicit huge pages are only available if the system has a pool of pre-allocated huge pages.
+    memory = yo_cast(u8*, mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB, -1, 0));
+    if (yo_cast(void*, memory) != MAP_FAILED) {
+        return (yo_VirtualMemory){.buf = memory, .size_bytes = size, .page_size = huge_page_size};
+    }
+#    endif
+
+    // Fallback to transparent huge pages, which requires the range to be aligned to the huge page size.
+    memory = yo_impl_memory_map_aligned(size, huge_page_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE);
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("OS failed to allocate memory due to: %s", strerror(errno));
+#    if YO_ENABLE_ABORT_AT_MEMORY_ERROR
+        yo_abort_program();
+#    endif
+        return yo_make_default(yo_VirtualMemory);
+    }
+
+    usize page_size = yo_impl_memory_advise_huge_pages(memory, size);
+    return (yo_VirtualMemory){.buf = memory, .size_bytes = size, .page_size = page_size};
+#endif
+}
+
+yo_VirtualMemory yo_memory_virtual_reserve_with_flags(usize size_bytes, u32 flags) {
+#if defined(YO_OS_UNIX)
+    if (flags & YO_MEMORY_FLAG_HUGE_PAGES) {
+        usize huge_page_size = yo_memory_huge_page_size();
+        usize size           = yo_align_forward(size_bytes, huge_page_size);
+
+        u8* memory = yo_impl_memory_map_aligned(size, huge_page_size, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE);
+        if (yo_unlikely(memory == NULL)) {
+            yo_log_error_fmt("OS failed to reserve %zu bytes due to: %s", size, strerror(errno));
+            return yo_make_default(yo_VirtualMemory);
+        }
+
+        usize page_size = yo_impl_memory_advise_huge_pages(memory, size);
+        return (yo_VirtualMemory){.buf = memory, .size_bytes = size, .page_size = page_size};
+    }
+#else
+    // Windows large pages can't be committed separately from their reservation.
+    yo_discard_value(flags);
+#endif
+
+    usize page_size = yo_memory_page_size();
+    usize size      = yo_align_forward(size_bytes, page_size);
+    u8*   memory    = yo_memory_virtual_reserve(size);
+    return (yo_VirtualMemory){.buf = memory, .size_bytes = (memory != NULL) ? size : 0, .page_size = page_size};
+}
+
+u8* yo_memory_virtual_alloc_mirrored(usize size_bytes) {
+    u8* memory = NULL;
+
+#if defined(YO_OS_WINDOWS)
+    HANDLE mapping = CreateFileMappingW(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_READWRITE,
+        yo_cast(DWORD, yo_cast(u64, size_bytes) >> 32),
+        yo_cast(DWORD, size_bytes & 0xFFFFFFFF),
+        NULL);
+    if (yo_unlikely(mapping == NULL)) {
+        yo_log_error_fmt("OS failed to create a mapping of %zu bytes with error code: %lu", size_bytes, GetLastError());
+        return NULL;
+    }
+
+    // Find a free range of twice the size and map both views into it. Another thread may take the
+    // range between its release and the mapping of the views, in which case we try again.
+    for (u32 attempt = 0; (memory == NULL) && (attempt < 8); ++attempt) {
+        u8* range = yo_cast(u8*, VirtualAlloc(NULL, 2 * size_bytes, MEM_RESERVE, PAGE_NOACCESS));
+        if (yo_unlikely(range == NULL)) {
+            break;
+        }
+        yo_discard_value(VirtualFree(range, 0, MEM_RELEASE));
+
+        void* first  = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size_bytes, range);
+        void* second = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size_bytes, range + size_bytes);
+        if ((first == range) && (second == range + size_bytes)) {
+            memory = range;
+        } else {
+            if (first != NULL) {
+                yo_discard_value(UnmapViewOfFile(first));
+            }
+            if (second != NULL) {
+                yo_discard_value(UnmapViewOfFile(second));
+            }
+        }
+    }
+
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("OS failed to map %zu bytes twice with error code: %lu", size_bytes, GetLastError());
+    }
+
+    // The views keep the mapping alive.
+    yo_discard_value(CloseHandle(mapping));
+#elif defined(YO_OS_LINUX) && defined(MFD_CLOEXEC)
+    i32 file = memfd_create("yoneda_mirrored_memory", MFD_CLOEXEC);
+    if (yo_unlikely(file == -1)) {
+        yo_log_error_fmt("OS failed to create a memory file due to: %s", strerror(errno));
+        return NULL;
+    }
+
+    if (ftruncate(file, yo_cast(off_t, size_bytes)) == 0) {
+        // Reserve twice the size, then replace each half with a shared mapping of the file.
+        u8* range = yo_cast(u8*, mmap(NULL, 2 * size_bytes, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0));
+        if (yo_cast(void*, range) != MAP_FAILED) {
+            void* first  = mmap(range, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0);
+            void* second = mmap(range + size_bytes, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0);
+            if ((first != MAP_FAILED) && (second != MAP_FAILED)) {
+                memory = range;
+            } else {
+                yo_discard_value(munmap(range, 2 * size_bytes));
+            }
+        }
+    }
+
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("OS failed to map %zu bytes twice due to: %s", size_bytes, strerror(errno));
+    }
+
+    // The mappings keep the file alive.
+    yo_discard_value(close(file));
+#else
+    yo_discard_value(size_bytes);
+#endif
+
+    return memory;
+}
+
+void yo_memory_virtual_free_mirrored(u8* memory, usize size_bytes) {
+#if defined(YO_OS_WINDOWS)
+    if (yo_unlikely((UnmapViewOfFile(memory) == FALSE) || (UnmapViewOfFile(memory + size_bytes) == FALSE))) {
+        yo_log_error_fmt("Failed to unmap mirrored memory with error code: %lu", GetLastError());
+    }
+#elif defined(YO_OS_UNIX)
+    yo_memory_virtual_free(memory, 2 * size_bytes);
+#else
+    yo_discard_value(memory);
+    yo_discard_value(size_bytes);
+#endif
+}
+
 // -----------------------------------------------------------------------------
 // Memory manipulation.
 // -----------------------------------------------------------------------------
@@ -136,7 +501,7 @@ void yo_memory_copy(u8* yo_no_alias dst, u8 const* yo_no_alias src, usize size_b
     yo_discard_value(memcpy(dst, src, size_bytes));
 }
 
-void yo_memory_move(u8* yo_no_alias dst, u8 const* yo_no_alias src, usize size_bytes) {
+void yo_memory_move(u8* dst, u8 const* src, usize size_bytes) {
     if (yo_unlikely(size_bytes == 0)) {
         return;
     }
@@ -161,24 +526,13 @@ usize yo_padding_with_header(
         alignment,
         header_alignment);
 
-    // Calculate the padding necessary for the alignment of the new block of memory.
-    usize padding   = 0;
-    usize mod_align = ptr_addr & (alignment - 1);  // Same as `ptr_addr % alignment`.
-    if (mod_align != 0) {
-        padding += alignment - mod_align;
-    }
-    ptr_addr += padding;
-
-    // Padding necessary for the header alignment.
-    usize mod_header = ptr_addr & (header_alignment - 1);  // Same as `ptr_addr % header_alignment`.
-    if (mod_header != 0) {
-        padding += header_alignment - mod_header;
-    }
+    // The header is placed right before the new block of memory. Since the size of a header is a
+    // multiple of its alignment, aligning the block to the strictest of both alignments also
+    // aligns the header.
+    usize strictest_alignment = yo_max_value(alignment, header_alignment);
+    uptr  block_addr          = yo_align_forward(ptr_addr + header_size, strictest_alignment);
 
-    // The padding should at least contain the header.
-    padding += header_size;
-
-    return padding;
+    return yo_cast(usize, block_addr - ptr_addr);
 }
 
 usize yo_align_forward(uptr ptr_addr, usize alignment) {
@@ -208,7 +562,184 @@ usize yo_align_forward(uptr ptr_addr, usize alignment) {
 
 #define yo_impl_arena_is_empty(arena) (((arena == NULL) || (arena)->capacity == 0) || ((arena)->buf == NULL))
 
-u8* yo_arena_alloc_align(yo_Arena* arena, usize size_bytes, u32 alignment) {
+/// Whether the arena needs to commit more memory in order to be accessible up to `end_offset`.
+#define yo_impl_arena_needs_commit(arena, end_offset) (((arena)->commit_chunk_size != 0) && ((end_offset) > (arena)->committed))
+
+/// Commit enough chunks of memory for the arena to be accessible up to the offset `end_offset`.
+yo_internal yo_Status yo_impl_arena_commit(yo_Arena* arena, usize end_offset) {
+    usize chunk_size    = arena->commit_chunk_size;
+    usize new_committed = yo_min_value(yo_align_forward(end_offset, chunk_size), arena->capacity);
+
+    yo_Status status = yo_memory_virtual_commit(arena->buf + arena->committed, new_committed - arena->committed);
+    if (yo_likely(status == YO_STATUS_OK)) {
+        arena->committed = new_committed;
+    }
+
+    return status;
+}
+
+yo_Arena yo_make_owned_arena_with_flags(usize capacity, u32 memory_flags) {
+    yo_VirtualMemory memory = yo_memory_virtual_alloc_with_flags(capacity, memory_flags);
+    if (yo_unlikely(memory.buf == NULL)) {
+        return yo_make_default(yo_Arena);
+    }
+
+    return (yo_Arena){
+        .buf       = memory.buf,
+        .capacity  = memory.size_bytes,
+        .page_size = memory.page_size,
+        .flags     = YO_ARENA_FLAG_FRESH_MEMORY,
+    };
+}
+
+yo_Arena yo_make_reserved_arena(usize reserve_size, usize commit_chunk_size) {
+    return yo_make_reserved_arena_with_flags(reserve_size, commit_chunk_size, YO_MEMORY_FLAG_NONE);
+}
+
+yo_Arena yo_make_reserved_arena_with_flags(usize reserve_size, usize commit_chunk_size, u32 memory_flags) {
+    yo_VirtualMemory memory = yo_memory_virtual_reserve_with_flags(reserve_size, memory_flags);
+    if (yo_unlikely(memory.buf == NULL)) {
+        return yo_make_default(yo_Arena);
+    }
+
+    // The chunk size is kept as a power of two in order to be used as an alignment. Committing less
+    // than a whole page would also prevent the use of huge pages.
+    usize chunk_size = memory.page_size;
+    while (chunk_size < commit_chunk_size) {
+        chunk_size <<= 1;
+    }
+
+    return (yo_Arena){
+        .buf               = memory.buf,
+        .capacity          = memory.size_bytes,
+        .commit_chunk_size = chunk_size,
+        .page_size         = memory.page_size,
+        .flags             = YO_ARENA_FLAG_FRESH_MEMORY,
+    };
+}
+
+/// Zero the arena memory in the offset range [start_offset, end_offset), skipping the part of the
+/// range that was never handed out, and update the high-water mark of the arena.
+yo_internal void yo_impl_arena_zero_range(yo_Arena* arena, usize start_offset, usize end_offset) {
+    if (!(arena->flags & YO_ARENA_FLAG_FRESH_MEMORY)) {
+        yo_memory_set(arena->buf + start_offset, end_offset - start_offset, 0);
+        return;
+    }
+
+    usize high_water = arena->high_water_offset;
+    if (start_offset < high_water) {
+        yo_memory_set(arena->buf + start_offset, yo_min_value(end_offset, high_water) - start_offset, 0);
+    }
+    if (end_offset > high_water) {
+        arena->high_water_offset = end_offset;
+    }
+}
+
+/// Header placed at the start of each block allocated by a chained arena.
+struct yo_ArenaBlockHeader {
+    /// State of the arena right before spilling into the block.
+    yo_Arena previous;
+};
+
+/// Spill the arena into a new block that can fit an allocation with the given size and alignment.
+yo_internal yo_Status yo_impl_arena_push_block(yo_Arena* arena, usize size_bytes, u32 alignment) {
+    usize header_size  = yo_size_of(struct yo_ArenaBlockHeader);
+    usize min_capacity = header_size + size_bytes + alignment;
+    usize new_capacity = yo_align_forward(yo_max_value(2 * arena->capacity, min_capacity), yo_memory_page_size());
+
+    u8* memory = yo_memory_virtual_alloc(new_capacity);
+    if (yo_unlikely(memory == NULL)) {
+        return YO_STATUS_FAILED;
+    }
+
+    struct yo_ArenaBlockHeader* header = yo_cast(struct yo_ArenaBlockHeader*, memory);
+    header->previous                   = *arena;
+
+    arena->buf                  = memory;
+    arena->capacity             = new_capacity;
+    arena->offset               = header_size;
+    arena->committed            = 0;
+    arena->commit_chunk_size    = 0;
+    arena->high_water_offset    = header_size;
+    arena->page_size            = yo_memory_page_size();
+    arena->trim_resident_offset = new_capacity;
+    arena->flags |= YO_ARENA_FLAG_FRESH_MEMORY | YO_ARENA_FLAG_CHAIN_BLOCK;
+
+    return YO_STATUS_OK;
+}
+
+void yo_impl_arena_release_blocks(yo_Arena* arena, u8 const* target_buf) {
+    while ((arena->flags & YO_ARENA_FLAG_CHAIN_BLOCK) && (arena->buf != target_buf)) {
+        u8*   block          = arena->buf;
+        usize block_capacity = arena->capacity;
+
+        *arena = yo_cast(struct yo_ArenaBlockHeader*, block)->previous;
+        yo_memory_virtual_free(block, block_capacity);
+    }
+
+    yo_assert_msg((target_buf == NULL) || (arena->buf == target_buf), "Checkpoint doesn't belong to the arena.");
+}
+
+void yo_impl_arena_trim(yo_Arena* arena, usize new_offset) {
+    yo_ArenaTrimPolicy const* policy = &arena->trim_policy;
+
+    // Memory currently backed by physical pages. Reserved arenas are trimmed in whole commit chunks,
+    // otherwise in whole pages, which avoids splitting huge pages.
+    bool  is_reserved = (arena->commit_chunk_size != 0);
+    usize granularity = is_reserved ? arena->commit_chunk_size : arena->page_size;
+    usize usage       = yo_max_value(arena->offset, new_offset);
+
+    // Lazily released pages become resident again once the arena hands them out.
+    arena->trim_resident_offset = yo_max_value(arena->trim_resident_offset, yo_align_forward(usage, granularity));
+
+    usize resident = is_reserved ? arena->committed : yo_align_forward(arena->high_water_offset, arena->page_size);
+    resident       = yo_min_value(resident, arena->trim_resident_offset);
+
+    usize target = yo_align_forward(yo_max_value(policy->retain_bytes, usage), granularity);
+    if ((target >= resident) || (resident - target < policy->threshold_bytes)) {
+        arena->trim_streak      = 0;
+        arena->trim_streak_peak = 0;
+        return;
+    }
+
+    arena->trim_streak_peak = yo_max_value(arena->trim_streak_peak, target);
+    if (++arena->trim_streak < policy->delay) {
+        return;
+    }
+
+    target                  = arena->trim_streak_peak;
+    arena->trim_streak      = 0;
+    arena->trim_streak_peak = 0;
+
+    if (policy->lazy) {
+        // Lazily purged pages may still hold their previous contents, so the high-water mark stays.
+        if (yo_likely(yo_memory_virtual_purge(arena->buf + target, resident - target, true) == YO_STATUS_OK)) {
+            arena->trim_resident_offset = target;
+        }
+        return;
+    }
+
+    yo_Status status = is_reserved ? yo_memory_virtual_decommit(arena->buf + target, resident - target)
+                                   : yo_memory_virtual_purge(arena->buf + target, resident - target, false);
+    if (yo_unlikely(status == YO_STATUS_FAILED)) {
+        return;
+    }
+
+    if (is_reserved) {
+        arena->committed = target;
+    }
+    arena->high_water_offset = yo_min_value(arena->high_water_offset, target);
+
+#if defined(YO_OS_UNIX)
+    // Releasing the pages may replace the mapping, which loses its transparent huge page advice.
+    if (arena->page_size > yo_memory_page_size()) {
+        yo_discard_value(yo_impl_memory_advise_huge_pages(arena->buf + target, resident - target));
+    }
+#endif
+}
+
+/// Bump the arena offset, without touching the contents of the new block.
+yo_internal u8* yo_impl_arena_bump(yo_Arena* arena, usize size_bytes, u32 alignment) {
     if (yo_unlikely(size_bytes == 0)) {
         return NULL;
     }
@@ -221,15 +752,66 @@ u8* yo_arena_alloc_align(yo_Arena* arena, usize size_bytes, u32 alignment) {
     uptr memory_addr    = yo_cast(uptr, arena->buf);
     uptr new_block_addr = yo_align_forward(memory_addr + arena->offset, alignment);
     if (yo_unlikely(new_block_addr + size_bytes > arena->capacity + memory_addr)) {
-        yo_impl_arena_report_out_of_memory(arena, size_bytes, alignment);
-        yo_impl_return_from_memory_error();
+        bool spilled = (arena->flags & YO_ARENA_FLAG_CHAINED) &&
+                       (yo_impl_arena_push_block(arena, size_bytes, alignment) == YO_STATUS_OK);
+        if (!spilled) {
+            yo_impl_arena_report_out_of_memory(arena, size_bytes, alignment);
+            yo_impl_return_from_memory_error();
+        }
+
+        memory_addr    = yo_cast(uptr, arena->buf);
+        new_block_addr = yo_align_forward(memory_addr + arena->offset, alignment);
     }
 
     // Commit the new block of memory.
-    arena->offset = yo_cast(usize, size_bytes + new_block_addr - memory_addr);
+    usize new_offset = yo_cast(usize, size_bytes + new_block_addr - memory_addr);
+    if (yo_unlikely(yo_impl_arena_needs_commit(arena, new_offset))) {
+        if (yo_unlikely(yo_impl_arena_commit(arena, new_offset) == YO_STATUS_FAILED)) {
+            yo_impl_arena_report_out_of_memory(arena, size_bytes, alignment);
+            yo_impl_return_from_memory_error();
+        }
+    }
+    arena->offset = new_offset;
+
+    return yo_cast(u8*, new_block_addr);
+}
+
+u8* yo_arena_alloc_align(yo_Arena* arena, usize size_bytes, u32 alignment) {
+    u8* new_block = yo_impl_arena_bump(arena, size_bytes, alignment);
+
+    if (yo_likely(new_block != NULL)) {
+        usize end_offset = arena->offset;
+        yo_impl_arena_zero_range(arena, end_offset - size_bytes, end_offset);
+    }
+
+    return new_block;
+}
+
+u8* yo_arena_alloc_uninit_align(yo_Arena* arena, usize size_bytes, u32 alignment) {
+    u8* new_block = yo_impl_arena_bump(arena, size_bytes, alignment);
+
+    if (yo_likely(new_block != NULL) && (arena->offset > arena->high_water_offset)) {
+        arena->high_water_offset = arena->offset;
+    }
+
+    return new_block;
+}
+
+/// Allocate a new block and copy old memory. Only the part that isn't copied over needs zeroing.
+yo_internal u8* yo_impl_arena_realloc_copy(
+    yo_Arena* arena,
+    u8*       block,
+    usize     current_size_bytes,
+    usize     new_size_bytes,
+    u32       alignment) {
+    u8* new_block = yo_arena_alloc_uninit_align(arena, new_size_bytes, alignment);
+
+    if (yo_likely(new_block != NULL)) {
+        usize copy_size = yo_min_value(current_size_bytes, new_size_bytes);
+        yo_memory_move(new_block, block, copy_size);
+        yo_memory_set(new_block + copy_size, new_size_bytes - copy_size, 0);
+    }
 
-    u8* new_block = yo_cast(u8*, new_block_addr);
-    yo_memory_set(new_block, size_bytes, 0);
     return new_block;
 }
 
@@ -255,8 +837,13 @@ u8* yo_arena_realloc_align(
 
     uptr block_addr = yo_cast(uptr, block);
 
-    // Check if the block lies within the allocator's memory.
+    // Check if the block lies within the allocator's memory. Blocks of chained arenas may live in
+    // one of the previous blocks of the chain, in which case they can only be copied.
     if (yo_unlikely((block_addr < memory_addr) || (block_addr >= memory_end))) {
+        if (arena->flags & YO_ARENA_FLAG_CHAIN_BLOCK) {
+            return yo_impl_arena_realloc_copy(arena, block, current_size_bytes, new_size_bytes, alignment);
+        }
+
         yo_log_error("Pointer outside of arena domain.");
         yo_impl_return_from_memory_error();
     }
@@ -277,8 +864,12 @@ u8* yo_arena_realloc_align(
 
     // If the block is the last allocated, just bump the offset.
     if (block_addr == free_memory_addr - current_size_bytes) {
-        // Check if there is enough space.
+        // Check if there is enough space. Chained arenas can still copy the block to a new block.
         if (yo_unlikely(block_addr + new_size_bytes > memory_end)) {
+            if (arena->flags & YO_ARENA_FLAG_CHAINED) {
+                return yo_impl_arena_realloc_copy(arena, block, current_size_bytes, new_size_bytes, alignment);
+            }
+
             yo_log_error_fmt(
                 "Unable to reallocate block from %zu bytes to %zu bytes.",
                 current_size_bytes,
@@ -286,13 +877,343 @@ u8* yo_arena_realloc_align(
             yo_impl_return_from_memory_error();
         }
 
-        arena->offset = yo_cast(usize, yo_cast(isize, memory_offset) + yo_cast(isize, new_size_bytes - current_size_bytes));
+        usize new_offset = yo_cast(usize, yo_cast(isize, memory_offset) + yo_cast(isize, new_size_bytes - current_size_bytes));
+        if (yo_unlikely(yo_impl_arena_needs_commit(arena, new_offset))) {
+            if (yo_unlikely(yo_impl_arena_commit(arena, new_offset) == YO_STATUS_FAILED)) {
+                yo_impl_return_from_memory_error();
+            }
+        }
+
+        arena->offset = new_offset;
+        if (new_offset > memory_offset) {
+            yo_impl_arena_zero_range(arena, memory_offset, new_offset);
+        }
+
         return block;
     }
 
-    // Allocate a new block and copy old memory.
-    u8* new_block = yo_arena_alloc_align(arena, new_size_bytes, alignment);
-    yo_memory_move(new_block, block, yo_min_value(current_size_bytes, new_size_bytes));
+    return yo_impl_arena_realloc_copy(arena, block, current_size_bytes, new_size_bytes, alignment);
+}
+
+// -----------------------------------------------------------------------------
+// Thread-local scratch arenas.
+// -----------------------------------------------------------------------------
+
+yo_global yo_thread_local yo_Arena yo_impl_scratch_arenas[YO_SCRATCH_ARENA_COUNT];
+
+yo_Scratch yo_scratch_begin(yo_Arena* const* conflicts, usize conflict_count) {
+    yo_assert_msg((conflicts != NULL) || (conflict_count == 0), "Missing conflicting arenas.");
+
+    yo_Arena* scratch_arena = NULL;
+    for (u32 idx = 0; idx < YO_SCRATCH_ARENA_COUNT; ++idx) {
+        yo_Arena* candidate = &yo_impl_scratch_arenas[idx];
+
+        bool has_conflict = false;
+        for (usize conflict_idx = 0; conflict_idx < conflict_count; ++conflict_idx) {
+            if (conflicts[conflict_idx] == candidate) {
+                has_conflict = true;
+                break;
+            }
+        }
+
+        if (!has_conflict) {
+            scratch_arena = candidate;
+            break;
+        }
+    }
+    if (yo_unlikely(scratch_arena == NULL)) {
+        yo_log_fatal_fmt("All %d scratch arenas of the thread are in conflict.", YO_SCRATCH_ARENA_COUNT);
+        yo_abort_program();
+    }
+
+    if (yo_unlikely(scratch_arena->buf == NULL)) {
+        *scratch_arena = yo_make_reserved_arena(YO_SCRATCH_ARENA_RESERVE_SIZE, yo_kibibytes(64));
+        if (yo_unlikely(scratch_arena->buf == NULL)) {
+            yo_log_error("Unable to reserve memory for a scratch arena.");
+            return (yo_Scratch){.arena = scratch_arena, .checkpoint = yo_make_arena_checkpoint(scratch_arena)};
+        }
+
+        // Temporary spikes shouldn't keep memory resident for the whole lifetime of the thread.
+        yo_arena_set_trim_policy(
+            scratch_arena,
+            (yo_ArenaTrimPolicy){
+                .retain_bytes    = yo_mebibytes(1),
+                .threshold_bytes = yo_mebibytes(4),
+                .delay           = 8,
+                .lazy            = true,
+            });
+    }
+
+    return (yo_Scratch){
+        .arena      = scratch_arena,
+        .checkpoint = yo_make_arena_checkpoint(scratch_arena),
+    };
+}
+
+void yo_scratch_thread_release(void) {
+    for (u32 idx = 0; idx < YO_SCRATCH_ARENA_COUNT; ++idx) {
+        yo_Arena* arena = &yo_impl_scratch_arenas[idx];
+        if (arena->buf != NULL) {
+            yo_destroy_owned_arena(arena);
+            *arena = yo_make_default(yo_Arena);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Allocator interface.
+// -----------------------------------------------------------------------------
+
+u8* yo_impl_arena_allocator_alloc(void* context, usize size_bytes, u32 alignment) {
+    return yo_arena_alloc_align(yo_cast(yo_Arena*, context), size_bytes, alignment);
+}
+
+u8* yo_impl_arena_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    return yo_arena_realloc_align(yo_cast(yo_Arena*, context), block, current_size_bytes, new_size_bytes, alignment);
+}
+
+void yo_impl_arena_allocator_free(void* context, void* block, usize size_bytes) {
+    // Arena memory is only released in bulk.
+    yo_discard_value(context);
+    yo_discard_value(block);
+    yo_discard_value(size_bytes);
+}
+
+u8* yo_impl_tracking_allocator_alloc(void* context, usize size_bytes, u32 alignment) {
+    yo_TrackingAllocator* tracker = yo_cast(yo_TrackingAllocator*, context);
+
+    u8* block = yo_allocator_alloc_align(tracker->parent, size_bytes, alignment);
+    if (yo_likely(block != NULL)) {
+        tracker->live_bytes += size_bytes;
+        tracker->peak_bytes = yo_max_value(tracker->peak_bytes, tracker->live_bytes);
+        tracker->alloc_count += 1;
+    }
+
+    return block;
+}
+
+u8* yo_impl_tracking_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    yo_TrackingAllocator* tracker = yo_cast(yo_TrackingAllocator*, context);
+    yo_assert_msg(tracker->live_bytes >= current_size_bytes, "Resizing a block that wasn't allocated by the tracker.");
+
+    u8* new_block = yo_allocator_resize_align(tracker->parent, block, current_size_bytes, new_size_bytes, alignment);
+    if (yo_likely(new_block != NULL)) {
+        tracker->live_bytes = tracker->live_bytes - current_size_bytes + new_size_bytes;
+        tracker->peak_bytes = yo_max_value(tracker->peak_bytes, tracker->live_bytes);
+    }
 
     return new_block;
 }
+
+void yo_impl_tracking_allocator_free(void* context, void* block, usize size_bytes) {
+    yo_TrackingAllocator* tracker = yo_cast(yo_TrackingAllocator*, context);
+    yo_assert_msg(tracker->live_bytes >= size_bytes, "Freeing a block that wasn't allocated by the tracker.");
+
+    yo_allocator_free(tracker->parent, block, size_bytes);
+    tracker->live_bytes -= size_bytes;
+    tracker->free_count += 1;
+}
+
+// -----------------------------------------------------------------------------
+// Growable arrays.
+// -----------------------------------------------------------------------------
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+/// Offset from the start of the array block to its first element. The header immediately precedes
+/// the elements, which are kept aligned.
+yo_internal yo_inline usize yo_impl_dynarray_header_offset(u32 element_alignment) {
+    return yo_align_forward(yo_size_of(yo_DynArrayHeader), yo_max_value(element_alignment, yo_align_of(yo_DynArrayHeader)));
+}
+
+yo_internal yo_inline u32 yo_impl_dynarray_block_alignment(u32 element_alignment) {
+    return yo_max_value(element_alignment, yo_cast(u32, yo_align_of(yo_DynArrayHeader)));
+}
+
+yo_DynArray(u8) yo_impl_make_dynarray(yo_Arena* arena, usize element_capacity, usize element_size, u32 element_alignment) {
+    yo_assert_not_null(arena);
+
+    usize header_offset = yo_impl_dynarray_header_offset(element_alignment);
+    u8*   memory        = yo_arena_alloc_align(arena, header_offset + element_size * element_capacity, yo_impl_dynarray_block_alignment(element_alignment));
+    if (yo_unlikely(memory == NULL)) {
+        return NULL;
+    }
+
+    memory += header_offset;
+
+    yo_DynArrayHeader* header = yo_impl_dynarray_header(memory);
+    header->element_capacity  = element_capacity;
+    header->element_count     = 0;
+    header->arena             = arena;
+    header->element_alignment = element_alignment;
+
+    return memory;
+}
+
+void* yo_impl_dynarray_reserve(void* array, usize element_capacity, usize element_size) {
+    void* memory = yo_impl_dynarray_try_reserve(array, element_capacity, element_size);
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_fatal_fmt("Unable to grow the array to a capacity of %zu elements.", element_capacity);
+        yo_abort_program();
+    }
+    return memory;
+}
+
+void* yo_impl_dynarray_try_reserve(void* array, usize element_capacity, usize element_size) {
+    yo_DynArrayHeader* header = yo_impl_dynarray_header(array);
+    if (element_capacity <= header->element_capacity) {
+        return array;
+    }
+
+    // The arena extends the block in place if it's the last allocation, and copies it otherwise.
+    usize header_offset = yo_impl_dynarray_header_offset(header->element_alignment);
+    u8*   memory        = yo_arena_realloc_align(
+        header->arena,
+        yo_cast(u8*, array) - header_offset,
+        header_offset + element_size * header->element_capacity,
+        header_offset + element_size * element_capacity,
+        yo_impl_dynarray_block_alignment(header->element_alignment));
+    if (yo_unlikely(memory == NULL)) {
+        return NULL;
+    }
+
+    memory += header_offset;
+    yo_impl_dynarray_header(memory)->element_capacity = element_capacity;
+
+    return memory;
+}
+
+void yo_impl_dynarray_shrink_to_fit(void* array, usize element_size) {
+    if (array == NULL) {
+        return;
+    }
+
+    yo_DynArrayHeader* header = yo_impl_dynarray_header(array);
+    yo_Arena*          arena  = header->arena;
+
+    // Shrinking any other allocation would require copying the array to a new block.
+    u8* array_end = yo_cast(u8*, array) + element_size * header->element_capacity;
+    if ((header->element_count == header->element_capacity) || (array_end != arena->buf + arena->offset)) {
+        return;
+    }
+
+    usize header_offset = yo_impl_dynarray_header_offset(header->element_alignment);
+    yo_discard_value(yo_arena_realloc_align(
+        arena,
+        yo_cast(u8*, array) - header_offset,
+        header_offset + element_size * header->element_capacity,
+        header_offset + element_size * header->element_count,
+        yo_impl_dynarray_block_alignment(header->element_alignment)));
+    header->element_capacity = header->element_count;
+}
+
+#if defined(YO_COMPILER_CLANG)
+#    pragma clang diagnostic pop
+#endif
+
+// -----------------------------------------------------------------------------
+// Lock-free single-producer/single-consumer ring buffer.
+// -----------------------------------------------------------------------------
+
+yo_SpscRing yo_make_spsc_ring_align(yo_Arena* arena, usize element_size, u32 alignment, usize capacity) {
+    yo_assert_not_null(arena);
+    yo_assert_msg(element_size != 0, "Ring elements should have a non-zero size.");
+
+    usize ring_capacity = 1;
+    while (ring_capacity < capacity) {
+        ring_capacity <<= 1;
+    }
+
+    u8* buf = yo_arena_alloc_align(arena, element_size * ring_capacity, alignment);
+    if (yo_unlikely(buf == NULL)) {
+        yo_log_error_fmt("Unable to allocate a ring of %zu elements of %zu bytes.", ring_capacity, element_size);
+        return yo_make_default(yo_SpscRing);
+    }
+
+    return (yo_SpscRing){
+        .buf          = buf,
+        .element_size = element_size,
+        .capacity     = ring_capacity,
+    };
+}
+
+/// Copy elements into the ring starting at a given counter value, splitting the copy at the end of
+/// the ring memory.
+yo_internal void yo_impl_spsc_ring_write(yo_SpscRing* ring, usize position, u8 const* elements, usize count) {
+    usize slot       = position & (ring->capacity - 1);
+    usize first_span = yo_min_value(count, ring->capacity - slot);
+    yo_memory_copy(ring->buf + slot * ring->element_size, elements, first_span * ring->element_size);
+    if (first_span < count) {
+        yo_memory_copy(ring->buf, elements + first_span * ring->element_size, (count - first_span) * ring->element_size);
+    }
+}
+
+yo_internal void yo_impl_spsc_ring_read(yo_SpscRing const* ring, usize position, u8* elements, usize count) {
+    usize slot       = position & (ring->capacity - 1);
+    usize first_span = yo_min_value(count, ring->capacity - slot);
+    yo_memory_copy(elements, ring->buf + slot * ring->element_size, first_span * ring->element_size);
+    if (first_span < count) {
+        yo_memory_copy(elements + first_span * ring->element_size, ring->buf, (count - first_span) * ring->element_size);
+    }
+}
+
+usize yo_spsc_ring_push_bulk(yo_SpscRing* ring, void const* elements, usize count) {
+    yo_assert_not_null(ring);
+
+    // The producer is the only writer of the tail.
+    usize tail = yo_atomic_load_usize(&ring->tail, YO_MEMORY_ORDER_RELAXED);
+
+    usize free_count = ring->capacity - (tail - ring->cached_head);
+    if (free_count < count) {
+        ring->cached_head = yo_atomic_load_usize(&ring->head, YO_MEMORY_ORDER_ACQUIRE);
+        free_count        = ring->capacity - (tail - ring->cached_head);
+    }
+
+    count = yo_min_value(count, free_count);
+    if (count != 0) {
+        yo_impl_spsc_ring_write(ring, tail, yo_cast(u8 const*, elements), count);
+        yo_atomic_store_usize(&ring->tail, tail + count, YO_MEMORY_ORDER_RELEASE);
+    }
+
+    return count;
+}
+
+usize yo_spsc_ring_pop_bulk(yo_SpscRing* ring, void* elements, usize max_count) {
+    yo_assert_not_null(ring);
+
+    // The consumer is the only writer of the head.
+    usize head = yo_atomic_load_usize(&ring->head, YO_MEMORY_ORDER_RELAXED);
+
+    usize available = ring->cached_tail - head;
+    if (available < max_count) {
+        ring->cached_tail = yo_atomic_load_usize(&ring->tail, YO_MEMORY_ORDER_ACQUIRE);
+        available         = ring->cached_tail - head;
+    }
+
+    usize count = yo_min_value(max_count, available);
+    if (count != 0) {
+        yo_impl_spsc_ring_read(ring, head, yo_cast(u8*, elements), count);
+        yo_atomic_store_usize(&ring->head, head + count, YO_MEMORY_ORDER_RELEASE);
+    }
+
+    return count;
+}
+
+bool yo_spsc_ring_try_push(yo_SpscRing* ring, void const* element) {
+    return yo_spsc_ring_push_bulk(ring, element, 1) == 1;
+}
+
+bool yo_spsc_ring_try_pop(yo_SpscRing* ring, void* element) {
+    return yo_spsc_ring_pop_bulk(ring, element, 1) == 1;
+}
+
+usize yo_spsc_ring_count(yo_SpscRing const* ring) {
+    yo_assert_not_null(ring);
+
+    usize head = yo_atomic_load_usize(&ring->head, YO_MEMORY_ORDER_ACQUIRE);
+    usize tail = yo_atomic_load_usize(&ring->tail, YO_MEMORY_ORDER_ACQUIRE);
+    return tail - head;
+}
@@ -0,0 +1,144 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the fixed-size object pool allocator.
+/// File name: yoneda_pool.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_pool.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+yo_Pool yo_make_pool_align(yo_Arena* arena, usize slot_size, u32 alignment, usize capacity) {
+    yo_assert_not_null(arena);
+
+    // Free slots store a pointer to the next free slot.
+    usize slot_alignment = yo_max_value(yo_cast(usize, alignment), yo_align_of(yo_PoolFreeSlot));
+    slot_size            = yo_align_forward(yo_max_value(slot_size, yo_size_of(yo_PoolFreeSlot)), slot_alignment);
+
+    // Slots are zeroed when handed out, there's no need to touch the whole block right away.
+    u8* slots = yo_arena_alloc_uninit_align(arena, slot_size * capacity, yo_cast(u32, slot_alignment));
+    if (yo_unlikely(slots == NULL)) {
+        yo_log_error_fmt("Unable to allocate a pool of %zu slots of %zu bytes.", capacity, slot_size);
+        return yo_make_default(yo_Pool);
+    }
+
+    return (yo_Pool){
+        .slots     = slots,
+        .slot_size = slot_size,
+        .capacity  = capacity,
+    };
+}
+
+u8* yo_pool_alloc_slot(yo_Pool* pool) {
+    yo_assert_not_null(pool);
+
+    u8* slot = yo_cast(u8*, pool->free_list);
+    if (slot != NULL) {
+        pool->free_list = pool->free_list->next;
+    } else if (yo_likely(pool->bump_count < pool->capacity)) {
+        slot = pool->slots + pool->bump_count * pool->slot_size;
+        ++pool->bump_count;
+    } else {
+        yo_log_error_fmt("Pool unable to allocate a new slot, all %zu slots are in use.", pool->capacity);
+        yo_impl_return_from_memory_error();
+    }
+
+    pool->live_count += 1;
+    pool->peak_count = yo_max_value(pool->peak_count, pool->live_count);
+
+    yo_memory_set(slot, pool->slot_size, 0);
+    return slot;
+}
+
+void yo_pool_free_slot(yo_Pool* pool, void* slot) {
+    yo_assert_not_null(pool);
+    if (slot == NULL) {
+        return;
+    }
+
+#if YO_ENABLE_BOUNDS_CHECK
+    usize offset = yo_cast(usize, yo_cast(u8*, slot) - pool->slots);
+    yo_assert_msg(
+        (yo_cast(u8*, slot) >= pool->slots) && (offset < pool->bump_count * pool->slot_size) && (offset % pool->slot_size == 0),
+        "Slot doesn't belong to the pool.");
+#endif
+    yo_assert_msg(pool->live_count != 0, "Freeing a slot of a pool without live slots.");
+
+    yo_PoolFreeSlot* free_slot = yo_cast(yo_PoolFreeSlot*, slot);
+    free_slot->next            = pool->free_list;
+    pool->free_list            = free_slot;
+    pool->live_count -= 1;
+}
+
+void yo_pool_clear(yo_Pool* pool) {
+    yo_assert_not_null(pool);
+
+    pool->free_list  = NULL;
+    pool->bump_count = 0;
+    pool->live_count = 0;
+}
+
+yo_PoolStats yo_pool_stats(yo_Pool const* pool) {
+    yo_assert_not_null(pool);
+
+    return (yo_PoolStats){
+        .slot_size  = pool->slot_size,
+        .capacity   = pool->capacity,
+        .live_count = pool->live_count,
+        .peak_count = pool->peak_count,
+        .free_count = pool->capacity - pool->live_count,
+        .occupancy  = (pool->capacity != 0) ? yo_cast(f32, pool->live_count) / yo_cast(f32, pool->capacity) : 0.0f,
+    };
+}
+
+u8* yo_impl_pool_allocator_alloc(void* context, usize size_bytes, u32 alignment) {
+    yo_Pool* pool = yo_cast(yo_Pool*, context);
+    if (yo_unlikely((size_bytes > pool->slot_size) || (yo_cast(uptr, pool->slots) % alignment != 0) || (pool->slot_size % alignment != 0))) {
+        yo_log_error_fmt("Pool with slots of %zu bytes can't allocate %zu bytes with alignment %u.", pool->slot_size, size_bytes, alignment);
+        yo_impl_return_from_memory_error();
+    }
+
+    return yo_pool_alloc_slot(pool);
+}
+
+u8* yo_impl_pool_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    yo_Pool* pool = yo_cast(yo_Pool*, context);
+    yo_discard_value(alignment);
+
+    if (yo_unlikely(new_size_bytes > pool->slot_size)) {
+        yo_log_error_fmt("Unable to resize a pool slot of %zu bytes to %zu bytes.", pool->slot_size, new_size_bytes);
+        yo_impl_return_from_memory_error();
+    }
+
+    if (new_size_bytes > current_size_bytes) {
+        yo_memory_set(block + current_size_bytes, new_size_bytes - current_size_bytes, 0);
+    }
+    return block;
+}
+
+void yo_impl_pool_allocator_free(void* context, void* block, usize size_bytes) {
+    yo_discard_value(size_bytes);
+    yo_pool_free_slot(yo_cast(yo_Pool*, context), block);
+}
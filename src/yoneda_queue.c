@@ -0,0 +1,203 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the bounded lock-free multi-producer/multi-consumer queue.
+/// File name: yoneda_queue.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_queue.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_log.h>
+#include <yoneda_thread.h>
+
+#include "yoneda_impl_common.h"
+
+#define yo_impl_mpmc_queue_cell(queue, position) ((queue)->cells + ((position) & ((queue)->capacity - 1)) * (queue)->cell_size)
+#define yo_impl_mpmc_queue_cell_sequence(cell)   yo_cast(usize volatile*, cell)
+
+yo_MpmcQueue yo_make_mpmc_queue_align(yo_Arena* arena, usize element_size, u32 alignment, usize capacity) {
+    yo_assert_not_null(arena);
+    yo_assert_msg(element_size != 0, "Queue elements should have a non-zero size.");
+
+    // The sequence numbers can only tell a full queue from an empty one with at least two cells.
+    usize queue_capacity = 2;
+    while (queue_capacity < capacity) {
+        queue_capacity <<= 1;
+    }
+
+    u32   cell_alignment = yo_max_value(alignment, yo_cast(u32, yo_align_of(usize)));
+    usize element_offset = yo_align_forward(yo_size_of(usize), alignment);
+    usize cell_size      = yo_align_forward(element_offset + element_size, cell_alignment);
+
+    u8* cells = yo_arena_alloc_align(arena, cell_size * queue_capacity, cell_alignment);
+    if (yo_unlikely(cells == NULL)) {
+        yo_log_error_fmt("Unable to allocate a queue of %zu elements of %zu bytes.", queue_capacity, element_size);
+        return yo_make_default(yo_MpmcQueue);
+    }
+
+    // Each cell starts ready to be written by the producer of its own position.
+    for (usize idx = 0; idx < queue_capacity; ++idx) {
+        *yo_impl_mpmc_queue_cell_sequence(cells + idx * cell_size) = idx;
+    }
+
+    return (yo_MpmcQueue){
+        .cells          = cells,
+        .cell_size      = cell_size,
+        .element_offset = element_offset,
+        .element_size   = element_size,
+        .capacity       = queue_capacity,
+    };
+}
+
+/// Wake a thread sleeping on the given waiters, if there is any.
+///
+/// The fence pairs with the one made by sleeping threads after registering themselves: either the
+/// sleeper sees the change made to the queue, or this call sees the sleeper.
+yo_internal yo_inline void yo_impl_mpmc_queue_notify(yo_MpmcQueueWaiters* waiters) {
+    yo_atomic_thread_fence(YO_MEMORY_ORDER_SEQ_CST);
+    if (yo_atomic_load_u32(&waiters->sleeper_count, YO_MEMORY_ORDER_RELAXED) != 0) {
+        yo_discard_value(yo_atomic_fetch_add_u32(&waiters->epoch, 1, YO_MEMORY_ORDER_RELEASE));
+        yo_futex_wake_one(&waiters->epoch);
+    }
+}
+
+yo_internal bool yo_impl_mpmc_queue_try_push(yo_MpmcQueue* queue, void const* element) {
+    usize position = yo_atomic_load_usize(&queue->enqueue_position, YO_MEMORY_ORDER_RELAXED);
+    u8*   cell     = NULL;
+
+    for (;;) {
+        cell           = yo_impl_mpmc_queue_cell(queue, position);
+        usize sequence = yo_atomic_load_usize(yo_impl_mpmc_queue_cell_sequence(cell), YO_MEMORY_ORDER_ACQUIRE);
+        isize distance = yo_cast(isize, sequence - position);
+
+        if (distance == 0) {
+            // The cell is free, try to claim the position. On failure, the position is reloaded.
+            if (yo_atomic_compare_exchange_usize(&queue->enqueue_position, &position, position + 1, YO_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+        } else if (distance < 0) {
+            // The cell still holds the element pushed one lap ago.
+            return false;
+        } else {
+            // Another producer claimed the position.
+            position = yo_atomic_load_usize(&queue->enqueue_position, YO_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    yo_memory_copy(cell + queue->element_offset, yo_cast(u8 const*, element), queue->element_size);
+    yo_atomic_store_usize(yo_impl_mpmc_queue_cell_sequence(cell), position + 1, YO_MEMORY_ORDER_RELEASE);
+    return true;
+}
+
+yo_internal bool yo_impl_mpmc_queue_try_pop(yo_MpmcQueue* queue, void* element) {
+    usize position = yo_atomic_load_usize(&queue->dequeue_position, YO_MEMORY_ORDER_RELAXED);
+    u8*   cell     = NULL;
+
+    for (;;) {
+        cell           = yo_impl_mpmc_queue_cell(queue, position);
+        usize sequence = yo_atomic_load_usize(yo_impl_mpmc_queue_cell_sequence(cell), YO_MEMORY_ORDER_ACQUIRE);
+        isize distance = yo_cast(isize, sequence - (position + 1));
+
+        if (distance == 0) {
+            if (yo_atomic_compare_exchange_usize(&queue->dequeue_position, &position, position + 1, YO_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+        } else if (distance < 0) {
+            // The producer of the position didn't publish its element yet.
+            return false;
+        } else {
+            position = yo_atomic_load_usize(&queue->dequeue_position, YO_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    yo_memory_copy(yo_cast(u8*, element), cell + queue->element_offset, queue->element_size);
+
+    // Hand the cell over to the producer of the next lap.
+    yo_atomic_store_usize(yo_impl_mpmc_queue_cell_sequence(cell), position + queue->capacity, YO_MEMORY_ORDER_RELEASE);
+    return true;
+}
+
+bool yo_mpmc_queue_try_push(yo_MpmcQueue* queue, void const* element) {
+    yo_assert_not_null(queue);
+
+    if (!yo_impl_mpmc_queue_try_push(queue, element)) {
+        return false;
+    }
+
+    yo_impl_mpmc_queue_notify(&queue->not_empty);
+    return true;
+}
+
+bool yo_mpmc_queue_try_pop(yo_MpmcQueue* queue, void* element) {
+    yo_assert_not_null(queue);
+
+    if (!yo_impl_mpmc_queue_try_pop(queue, element)) {
+        return false;
+    }
+
+    yo_impl_mpmc_queue_notify(&queue->not_full);
+    return true;
+}
+
+/// Block until the given queue operation succeeds, spinning for a while before sleeping.
+#define yo_impl_mpmc_queue_wait_for(try_operation, queue, element, waiters)                                   \
+    do {                                                                                                      \
+        bool yo_var_done = false;                                                                             \
+        for (u32 yo_var_spin = 0; !yo_var_done && (yo_var_spin < YO_MPMC_QUEUE_SPIN_COUNT); ++yo_var_spin) {  \
+            yo_var_done = try_operation(queue, element);                                                      \
+            if (!yo_var_done) {                                                                               \
+                yo_cpu_relax();                                                                               \
+            }                                                                                                 \
+        }                                                                                                     \
+        while (!yo_var_done) {                                                                                \
+            yo_discard_value(yo_atomic_fetch_add_u32(&(waiters)->sleeper_count, 1, YO_MEMORY_ORDER_RELAXED)); \
+            yo_atomic_thread_fence(YO_MEMORY_ORDER_SEQ_CST);                                                  \
+            u32 yo_var_epoch = yo_atomic_load_u32(&(waiters)->epoch, YO_MEMORY_ORDER_ACQUIRE);                \
+            yo_var_done      = try_operation(queue, element);                                                 \
+            if (!yo_var_done) {                                                                               \
+                yo_futex_wait(&(waiters)->epoch, yo_var_epoch);                                               \
+            }                                                                                                 \
+            yo_discard_value(yo_atomic_fetch_sub_u32(&(waiters)->sleeper_count, 1, YO_MEMORY_ORDER_RELAXED)); \
+        }                                                                                                     \
+    } while (0)
+
+void yo_mpmc_queue_push(yo_MpmcQueue* queue, void const* element) {
+    yo_assert_not_null(queue);
+
+    yo_impl_mpmc_queue_wait_for(yo_impl_mpmc_queue_try_push, queue, element, &queue->not_full);
+    yo_impl_mpmc_queue_notify(&queue->not_empty);
+}
+
+void yo_mpmc_queue_pop(yo_MpmcQueue* queue, void* element) {
+    yo_assert_not_null(queue);
+
+    yo_impl_mpmc_queue_wait_for(yo_impl_mpmc_queue_try_pop, queue, element, &queue->not_empty);
+    yo_impl_mpmc_queue_notify(&queue->not_full);
+}
+
+usize yo_mpmc_queue_count(yo_MpmcQueue const* queue) {
+    yo_assert_not_null(queue);
+
+    usize dequeue_position = yo_atomic_load_usize(&queue->dequeue_position, YO_MEMORY_ORDER_ACQUIRE);
+    usize enqueue_position = yo_atomic_load_usize(&queue->enqueue_position, YO_MEMORY_ORDER_ACQUIRE);
+    return (enqueue_position > dequeue_position) ? (enqueue_position - dequeue_position) : 0;
+}
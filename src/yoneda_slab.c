@@ -0,0 +1,382 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the size-class slab allocator.
+/// File name: yoneda_slab.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_slab.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_bit.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+yo_global usize const yo_impl_slab_class_sizes[YO_SLAB_CLASS_COUNT] = {
+    16,   32,   48,   64,   80,   96,   112,  128,  160,  192,  224,  256,  320,  384,  448,  512,
+    640,  768,  896,  1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192,
+};
+
+/// Header stored at the start of each slab.
+struct yo_SlabHeader {
+    u32 class_index;
+};
+yo_type_alias(yo_SlabHeader, struct yo_SlabHeader);
+
+/// Header stored right before the memory of an allocation larger than YO_SLAB_MAX_SIZE.
+struct yo_SlabLargeHeader {
+    u8*   mapping;
+    usize mapping_size;
+};
+yo_type_alias(yo_SlabLargeHeader, struct yo_SlabLargeHeader);
+
+/// Free objects of a size class cached by a thread, linked through their first word.
+struct yo_SlabCacheBin {
+    u8* free_list;
+    u32 count;
+};
+yo_type_alias(yo_SlabCacheBin, struct yo_SlabCacheBin);
+
+struct yo_SlabCache {
+    yo_SlabHeap*    heap;
+    yo_SlabCacheBin bins[YO_SLAB_CLASS_COUNT];
+};
+yo_type_alias(yo_SlabCache, struct yo_SlabCache);
+
+yo_global yo_thread_local yo_SlabCache yo_impl_slab_thread_cache;
+
+#define yo_impl_slab_next(object) (*yo_cast(u8**, object))
+
+yo_internal yo_inline u32 yo_impl_slab_class_index(usize size_bytes) {
+    yo_assert((size_bytes != 0) && (size_bytes <= YO_SLAB_MAX_SIZE));
+
+    if (size_bytes <= 128) {
+        return yo_cast(u32, (size_bytes + 15) / 16) - 1;
+    }
+
+    // Four classes for each range (2^k, 2^(k + 1)].
+    usize size_minus_one = size_bytes - 1;
+    u32   power          = yo_u64_msb_index(size_minus_one);
+    u32   subclass       = yo_cast(u32, (size_minus_one - (yo_cast(usize, 1) << power)) >> (power - 2));
+    return 8 + (power - 7) * 4 + subclass;
+}
+
+/// Detach the first `count` objects of a free list, returning the last detached object.
+yo_internal u8* yo_impl_slab_list_split(u8* head, u32 count) {
+    u8* tail = head;
+    for (u32 idx = 1; idx < count; ++idx) {
+        tail = yo_impl_slab_next(tail);
+    }
+    return tail;
+}
+
+/// Return a list of objects to the shared state of a size class.
+yo_internal void yo_impl_slab_release_batch(yo_SlabClass* slab_class, u8* head, u8* tail, u32 count) {
+    yo_spin_lock_acquire(&slab_class->lock);
+    yo_impl_slab_next(tail) = slab_class->free_list;
+    slab_class->free_list   = head;
+    slab_class->free_count += count;
+    yo_spin_lock_release(&slab_class->lock);
+}
+
+/// Carve a new slab for a size class.
+///
+/// Note: Should be called with the lock of the class acquired.
+yo_internal bool yo_impl_slab_push_slab(yo_SlabHeap* heap, u32 class_index) {
+    usize slab_index = yo_atomic_fetch_add_usize(&heap->slab_count, 1, YO_MEMORY_ORDER_RELAXED);
+    if (yo_unlikely(slab_index >= heap->slab_capacity)) {
+        yo_atomic_fetch_sub_usize(&heap->slab_count, 1, YO_MEMORY_ORDER_RELAXED);
+        yo_log_error_fmt("Slab heap exhausted its reservation of %zu slabs.", heap->slab_capacity);
+        return false;
+    }
+
+    u8* slab = heap->slabs + slab_index * YO_SLAB_SIZE;
+    if (yo_unlikely(yo_memory_virtual_commit(slab, YO_SLAB_SIZE) != YO_STATUS_OK)) {
+        // Give the slab back, unless another class already took the next one. In that case the slab
+        // is left unused, since lowering the count would hand out the slab of the other class.
+        usize expected_count = slab_index + 1;
+        yo_discard_value(yo_atomic_compare_exchange_usize(&heap->slab_count, &expected_count, slab_index, YO_MEMORY_ORDER_RELAXED));
+        yo_log_error("Unable to commit memory for a new slab.");
+        return false;
+    }
+
+    yo_cast(yo_SlabHeader*, slab)->class_index = class_index;
+
+    usize         object_size  = yo_impl_slab_class_sizes[class_index];
+    usize         object_count = (YO_SLAB_SIZE - YO_SLAB_HEADER_SIZE) / object_size;
+    yo_SlabClass* slab_class   = &heap->classes[class_index];
+    slab_class->carve_cursor   = slab + YO_SLAB_HEADER_SIZE;
+    slab_class->carve_end      = slab_class->carve_cursor + object_count * object_size;
+    return true;
+}
+
+/// Fill an empty thread cache bin with a batch of objects.
+yo_internal bool yo_impl_slab_refill(yo_SlabHeap* heap, yo_SlabCacheBin* bin, u32 class_index) {
+    yo_SlabClass* slab_class  = &heap->classes[class_index];
+    usize         object_size = yo_impl_slab_class_sizes[class_index];
+    u32           batch_count = slab_class->batch_count;
+
+    yo_spin_lock_acquire(&slab_class->lock);
+
+    // Prefer recycled objects, whose memory is likely to be hot.
+    u32 taken = 0;
+    if (slab_class->free_list != NULL) {
+        taken    = yo_cast(u32, yo_min_value(slab_class->free_count, yo_cast(usize, batch_count)));
+        u8* tail = yo_impl_slab_list_split(slab_class->free_list, taken);
+
+        bin->free_list          = slab_class->free_list;
+        slab_class->free_list   = yo_impl_slab_next(tail);
+        yo_impl_slab_next(tail) = NULL;
+        slab_class->free_count -= taken;
+    }
+
+    while (taken < batch_count) {
+        if ((slab_class->carve_cursor == slab_class->carve_end) && !yo_impl_slab_push_slab(heap, class_index)) {
+            break;
+        }
+
+        u8* object                = slab_class->carve_cursor;
+        slab_class->carve_cursor  = object + object_size;
+        yo_impl_slab_next(object) = bin->free_list;
+        bin->free_list            = object;
+        ++taken;
+    }
+
+    yo_spin_lock_release(&slab_class->lock);
+
+    bin->count = taken;
+    return taken != 0;
+}
+
+/// Bind the thread cache to a heap, flushing the objects cached for another heap.
+yo_internal yo_inline yo_SlabCache* yo_impl_slab_thread_cache_for(yo_SlabHeap* heap) {
+    yo_SlabCache* cache = &yo_impl_slab_thread_cache;
+    if (yo_unlikely(cache->heap != heap)) {
+        yo_slab_thread_flush();
+        cache->heap = heap;
+    }
+    return cache;
+}
+
+yo_internal u8* yo_impl_slab_alloc_large(yo_SlabHeap* heap, usize size_bytes, u32 alignment) {
+    usize page_size = yo_memory_page_size();
+    yo_assert_fmt(alignment <= page_size, "Alignment (%u) larger than the page size isn't supported.", alignment);
+
+    usize header_offset = yo_align_forward(yo_size_of(yo_SlabLargeHeader), alignment);
+    usize mapping_size  = yo_align_forward(header_offset + size_bytes, page_size);
+    u8*   mapping       = yo_memory_virtual_alloc(mapping_size);
+    if (yo_unlikely(mapping == NULL)) {
+        yo_log_error_fmt("Slab heap unable to map %zu bytes for a large allocation.", size_bytes);
+        yo_impl_return_from_memory_error();
+    }
+
+    u8*                 block  = mapping + header_offset;
+    yo_SlabLargeHeader* header = yo_cast(yo_SlabLargeHeader*, block - yo_size_of(yo_SlabLargeHeader));
+    header->mapping            = mapping;
+    header->mapping_size       = mapping_size;
+
+    yo_atomic_fetch_add_usize(&heap->large_bytes, mapping_size, YO_MEMORY_ORDER_RELAXED);
+    return block;
+}
+
+yo_SlabHeap yo_make_slab_heap(usize reserve_size) {
+    // Reserve an extra slab so that the slabs can be aligned to their size.
+    usize slab_capacity = yo_align_forward(reserve_size, YO_SLAB_SIZE) / YO_SLAB_SIZE;
+    usize total_size    = (slab_capacity + 1) * YO_SLAB_SIZE;
+    u8*   reserve       = yo_memory_virtual_reserve(total_size);
+    if (yo_unlikely(reserve == NULL)) {
+        yo_log_error_fmt("Unable to reserve %zu bytes for a slab heap.", total_size);
+        return yo_make_default(yo_SlabHeap);
+    }
+
+    yo_SlabHeap heap = {
+        .reserve       = reserve,
+        .reserve_size  = total_size,
+        .slabs         = yo_cast(u8*, yo_align_forward(yo_cast(uptr, reserve), YO_SLAB_SIZE)),
+        .slab_capacity = slab_capacity,
+    };
+    for (u32 idx = 0; idx < YO_SLAB_CLASS_COUNT; ++idx) {
+        // Exchange around 16KiB of objects at once, bounded to a reasonable number of objects.
+        usize batch_count             = yo_kibibytes(16) / yo_impl_slab_class_sizes[idx];
+        heap.classes[idx].batch_count = yo_cast(u32, yo_clamp_value(batch_count, 4, 64));
+    }
+
+    return heap;
+}
+
+void yo_destroy_slab_heap(yo_SlabHeap* heap) {
+    yo_assert_not_null(heap);
+
+    if (yo_impl_slab_thread_cache.heap == heap) {
+        yo_impl_slab_thread_cache = yo_make_default(yo_SlabCache);
+    }
+    if (heap->reserve != NULL) {
+        yo_memory_virtual_free(heap->reserve, heap->reserve_size);
+    }
+    *heap = yo_make_default(yo_SlabHeap);
+}
+
+u8* yo_slab_alloc_align(yo_SlabHeap* heap, usize size_bytes, u32 alignment) {
+    yo_assert_not_null(heap);
+    yo_assert_fmt(yo_is_pow_of_two(alignment), "Expected alignment (%u) to be a power of two.", alignment);
+
+    if (yo_unlikely(size_bytes == 0)) {
+        return NULL;
+    }
+
+    // Class sizes are multiples of any alignment up to YO_SLAB_MAX_ALIGNMENT once the size is
+    // rounded to the alignment, and objects are laid out right after the slab header.
+    usize aligned_size = yo_align_forward(size_bytes, alignment);
+    if ((aligned_size > YO_SLAB_MAX_SIZE) || (alignment > YO_SLAB_MAX_ALIGNMENT)) {
+        return yo_impl_slab_alloc_large(heap, size_bytes, alignment);
+    }
+
+    u32              class_index = yo_impl_slab_class_index(aligned_size);
+    yo_SlabCacheBin* bin         = &yo_impl_slab_thread_cache_for(heap)->bins[class_index];
+    if (yo_unlikely((bin->free_list == NULL) && !yo_impl_slab_refill(heap, bin, class_index))) {
+        yo_log_error_fmt("Slab heap unable to allocate %zu bytes.", size_bytes);
+        yo_impl_return_from_memory_error();
+    }
+
+    u8* object     = bin->free_list;
+    bin->free_list = yo_impl_slab_next(object);
+    bin->count -= 1;
+
+    yo_memory_set(object, yo_impl_slab_class_sizes[class_index], 0);
+    return object;
+}
+
+u8* yo_slab_realloc_align(yo_SlabHeap* heap, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    yo_assert_not_null(heap);
+
+    if (block == NULL) {
+        return yo_slab_alloc_align(heap, new_size_bytes, alignment);
+    }
+    if (new_size_bytes == 0) {
+        yo_slab_free(heap, block);
+        return NULL;
+    }
+
+    // Objects can grow up to the size of their class.
+    usize aligned_size   = yo_align_forward(new_size_bytes, alignment);
+    bool  is_slab_object =
+        (yo_cast(uptr, block) >= yo_cast(uptr, heap->slabs)) && (yo_cast(uptr, block) < yo_cast(uptr, heap->slabs) + heap->slab_capacity * YO_SLAB_SIZE);
+    if (is_slab_object && (aligned_size <= YO_SLAB_MAX_SIZE) && (yo_cast(uptr, block) % alignment == 0) &&
+        (yo_impl_slab_class_index(aligned_size) == yo_impl_slab_class_index(yo_max_value(current_size_bytes, 1)))) {
+        if (new_size_bytes > current_size_bytes) {
+            yo_memory_set(block + current_size_bytes, new_size_bytes - current_size_bytes, 0);
+        }
+        return block;
+    }
+
+    u8* new_block = yo_slab_alloc_align(heap, new_size_bytes, alignment);
+    if (yo_likely(new_block != NULL)) {
+        yo_memory_copy(new_block, block, yo_min_value(current_size_bytes, new_size_bytes));
+        yo_slab_free(heap, block);
+    }
+    return new_block;
+}
+
+void yo_slab_free(yo_SlabHeap* heap, void* block) {
+    yo_assert_not_null(heap);
+    if (block == NULL) {
+        return;
+    }
+
+    // Blocks outside of the slab range are large allocations.
+    uptr block_addr = yo_cast(uptr, block);
+    uptr slabs_addr = yo_cast(uptr, heap->slabs);
+    if ((block_addr < slabs_addr) || (block_addr >= slabs_addr + heap->slab_capacity * YO_SLAB_SIZE)) {
+        yo_SlabLargeHeader* header = yo_cast(yo_SlabLargeHeader*, block_addr - yo_size_of(yo_SlabLargeHeader));
+        yo_atomic_fetch_sub_usize(&heap->large_bytes, header->mapping_size, YO_MEMORY_ORDER_RELAXED);
+        yo_memory_virtual_free(header->mapping, header->mapping_size);
+        return;
+    }
+
+    u8* slab        = yo_cast(u8*, block_addr - ((block_addr - slabs_addr) & (YO_SLAB_SIZE - 1)));
+    u32 class_index = yo_cast(yo_SlabHeader*, slab)->class_index;
+    yo_assert_msg(
+        ((block_addr - yo_cast(uptr, slab) - YO_SLAB_HEADER_SIZE) % yo_impl_slab_class_sizes[class_index]) == 0,
+        "Block doesn't point to the start of a slab object.");
+
+    yo_SlabCacheBin* bin     = &yo_impl_slab_thread_cache_for(heap)->bins[class_index];
+    yo_impl_slab_next(block) = bin->free_list;
+    bin->free_list           = yo_cast(u8*, block);
+    bin->count += 1;
+
+    // Keep a batch cached for future allocations and return the excess to the heap.
+    yo_SlabClass* slab_class = &heap->classes[class_index];
+    if (yo_unlikely(bin->count >= 2 * slab_class->batch_count)) {
+        u8* head       = bin->free_list;
+        u8* tail       = yo_impl_slab_list_split(head, slab_class->batch_count);
+        bin->free_list = yo_impl_slab_next(tail);
+        bin->count -= slab_class->batch_count;
+        yo_impl_slab_release_batch(slab_class, head, tail, slab_class->batch_count);
+    }
+}
+
+void yo_slab_thread_flush(void) {
+    yo_SlabCache* cache = &yo_impl_slab_thread_cache;
+    if (cache->heap == NULL) {
+        return;
+    }
+
+    for (u32 idx = 0; idx < YO_SLAB_CLASS_COUNT; ++idx) {
+        yo_SlabCacheBin* bin = &cache->bins[idx];
+        if (bin->count != 0) {
+            u8* tail = yo_impl_slab_list_split(bin->free_list, bin->count);
+            yo_impl_slab_release_batch(&cache->heap->classes[idx], bin->free_list, tail, bin->count);
+        }
+    }
+    *cache = yo_make_default(yo_SlabCache);
+}
+
+yo_SlabStats yo_slab_stats(yo_SlabHeap const* heap) {
+    yo_assert_not_null(heap);
+
+    usize slab_count = yo_atomic_load_usize(&heap->slab_count, YO_MEMORY_ORDER_RELAXED);
+    return (yo_SlabStats){
+        .slab_count    = slab_count,
+        .slab_capacity = heap->slab_capacity,
+        .slab_bytes    = slab_count * YO_SLAB_SIZE,
+        .large_bytes   = yo_atomic_load_usize(&heap->large_bytes, YO_MEMORY_ORDER_RELAXED),
+    };
+}
+
+usize yo_slab_class_size(usize size_bytes) {
+    return ((size_bytes != 0) && (size_bytes <= YO_SLAB_MAX_SIZE))
+               ? yo_impl_slab_class_sizes[yo_impl_slab_class_index(size_bytes)]
+               : size_bytes;
+}
+
+u8* yo_impl_slab_allocator_alloc(void* context, usize size_bytes, u32 alignment) {
+    return yo_slab_alloc_align(yo_cast(yo_SlabHeap*, context), size_bytes, alignment);
+}
+
+u8* yo_impl_slab_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    return yo_slab_realloc_align(yo_cast(yo_SlabHeap*, context), block, current_size_bytes, new_size_bytes, alignment);
+}
+
+void yo_impl_slab_allocator_free(void* context, void* block, usize size_bytes) {
+    yo_discard_value(size_bytes);
+    yo_slab_free(yo_cast(yo_SlabHeap*, context), block);
+}
@@ -0,0 +1,173 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the slot map with generational handles.
+/// File name: yoneda_slot_map.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_slot_map.h>
+
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+yo_internal yo_inline usize yo_impl_slot_map_header_offset(u32 element_alignment) {
+    return yo_align_forward(yo_size_of(yo_SlotMapHeader), yo_max_value(element_alignment, yo_align_of(yo_SlotMapHeader)));
+}
+
+yo_internal yo_inline yo_SlotMapHeader* yo_impl_slot_map_header_const(void const* map) {
+    return yo_impl_slot_map_header(yo_cast(void*, map));
+}
+
+/// Get the position of the element of a handle in the dense array, if the handle is valid.
+yo_internal yo_inline u32 yo_impl_slot_map_find(yo_SlotMapHeader const* header, yo_SlotHandle handle) {
+    if (yo_unlikely(handle.index >= header->slot_count)) {
+        return YO_SLOT_MAP_INVALID_INDEX;
+    }
+
+    // Free slots have even generations, which no handle carries.
+    yo_SlotMapSlot slot = header->slots[handle.index];
+    return (slot.generation == handle.generation) ? slot.index : YO_SLOT_MAP_INVALID_INDEX;
+}
+
+/// Free the slot of a removed element. The generation of a slot wraps around to zero once exhausted,
+/// and reusing the slot would then revive the handles of its first elements, so such slots are
+/// retired instead of going back to the list of free slots.
+yo_internal yo_inline void yo_impl_slot_map_release_slot(yo_SlotMapHeader* header, u32 slot_index) {
+    yo_SlotMapSlot* slot = header->slots + slot_index;
+    slot->generation += 1;
+    if (yo_unlikely(slot->generation == 0)) {
+        slot->index = YO_SLOT_MAP_INVALID_INDEX;
+        return;
+    }
+
+    slot->index       = header->free_slot;
+    header->free_slot = slot_index;
+}
+
+yo_SlotMap(u8) yo_impl_make_slot_map(yo_Arena* arena, usize element_capacity, usize element_size, u32 element_alignment) {
+    yo_assert_not_null(arena);
+    yo_assert_msg(element_capacity < YO_SLOT_MAP_INVALID_INDEX, "Slot map capacity doesn't fit the handle index.");
+
+    usize           header_offset = yo_impl_slot_map_header_offset(element_alignment);
+    u32             alignment     = yo_max_value(element_alignment, yo_cast(u32, yo_align_of(yo_SlotMapHeader)));
+    u8*             memory        = yo_arena_alloc_align(arena, header_offset + element_size * element_capacity, alignment);
+    yo_SlotMapSlot* slots         = yo_arena_alloc(arena, yo_SlotMapSlot, element_capacity);
+    u32*            dense_slots   = yo_arena_alloc(arena, u32, element_capacity);
+    if (yo_unlikely((memory == NULL) || (((slots == NULL) || (dense_slots == NULL)) && (element_capacity != 0)))) {
+        return NULL;
+    }
+
+    memory += header_offset;
+
+    yo_SlotMapHeader* header = yo_impl_slot_map_header(memory);
+    header->element_capacity = element_capacity;
+    header->element_count    = 0;
+    header->slots            = slots;
+    header->dense_slots      = dense_slots;
+    header->slot_count       = 0;
+    header->free_slot        = YO_SLOT_MAP_INVALID_INDEX;
+
+    return memory;
+}
+
+yo_SlotHandle yo_impl_slot_map_insert(void* map, void const* element, usize element_size) {
+    yo_assert_not_null(element);
+
+    yo_SlotMapHeader* header = yo_impl_slot_map_header(map);
+    if (yo_unlikely(header->element_count == header->element_capacity)) {
+        yo_log_error_fmt("Cannot insert a new element into a full slot map with capacity %zu.", header->element_capacity);
+        return yo_slot_handle_invalid();
+    }
+
+    // Reuse a free slot, or take a slot that was never used.
+    u32 slot_index = header->free_slot;
+    if (slot_index != YO_SLOT_MAP_INVALID_INDEX) {
+        header->free_slot = header->slots[slot_index].index;
+    } else if (yo_unlikely(header->slot_count == header->element_capacity)) {
+        yo_log_error("Cannot insert a new element into a slot map whose remaining slots were all retired.");
+        return yo_slot_handle_invalid();
+    } else {
+        slot_index = header->slot_count++;
+    }
+
+    u32             dense_index = yo_cast(u32, header->element_count++);
+    yo_SlotMapSlot* slot        = header->slots + slot_index;
+    slot->index                 = dense_index;
+    slot->generation += 1;
+
+    header->dense_slots[dense_index] = slot_index;
+    yo_memory_copy(yo_cast(u8*, map) + dense_index * element_size, yo_cast(u8 const*, element), element_size);
+
+    return (yo_SlotHandle){.index = slot_index, .generation = slot->generation};
+}
+
+void* yo_impl_slot_map_get(void* map, yo_SlotHandle handle, usize element_size) {
+    u32 dense_index = yo_impl_slot_map_find(yo_impl_slot_map_header(map), handle);
+    if (dense_index == YO_SLOT_MAP_INVALID_INDEX) {
+        return NULL;
+    }
+    return yo_cast(u8*, map) + dense_index * element_size;
+}
+
+bool yo_impl_slot_map_remove(void* map, yo_SlotHandle handle, usize element_size) {
+    yo_SlotMapHeader* header      = yo_impl_slot_map_header(map);
+    u32               dense_index = yo_impl_slot_map_find(header, handle);
+    if (dense_index == YO_SLOT_MAP_INVALID_INDEX) {
+        return false;
+    }
+
+    // Move the last element into the position of the removed one, keeping the elements packed.
+    u32 last_index = yo_cast(u32, --header->element_count);
+    if (dense_index != last_index) {
+        u8* elements = yo_cast(u8*, map);
+        yo_memory_copy(elements + dense_index * element_size, elements + last_index * element_size, element_size);
+
+        u32 moved_slot                   = header->dense_slots[last_index];
+        header->dense_slots[dense_index] = moved_slot;
+        header->slots[moved_slot].index  = dense_index;
+    }
+
+    yo_impl_slot_map_release_slot(header, handle.index);
+    return true;
+}
+
+bool yo_slot_map_contains(void const* map, yo_SlotHandle handle) {
+    return yo_impl_slot_map_find(yo_impl_slot_map_header_const(map), handle) != YO_SLOT_MAP_INVALID_INDEX;
+}
+
+yo_SlotHandle yo_slot_map_handle_at(void const* map, usize idx) {
+    yo_SlotMapHeader const* header = yo_impl_slot_map_header_const(map);
+    yo_assert_fmt(idx < header->element_count, "Index %zu out of bounds.", idx);
+
+    u32 slot_index = header->dense_slots[idx];
+    return (yo_SlotHandle){.index = slot_index, .generation = header->slots[slot_index].generation};
+}
+
+void yo_slot_map_clear(void* map) {
+    yo_SlotMapHeader* header = yo_impl_slot_map_header(map);
+
+    // Free the slots of all elements, in their dense order.
+    for (usize idx = 0; idx < header->element_count; ++idx) {
+        yo_impl_slot_map_release_slot(header, header->dense_slots[idx]);
+    }
+    header->element_count = 0;
+}
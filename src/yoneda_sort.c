@@ -0,0 +1,180 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the sorting algorithms.
+/// File name: yoneda_sort.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_sort.h>
+
+#include <string.h>
+#include <yoneda_assert.h>
+#include <yoneda_atomic.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+// -----------------------------------------------------------------------------
+// Radix sort.
+// -----------------------------------------------------------------------------
+
+#define YO_RADIX_DIGIT_BITS   8
+#define YO_RADIX_BUCKET_COUNT 256
+
+// Radix keys, mapping each element to an unsigned integer with the same ordering.
+
+#define yo_impl_radix_key_u32(value)       (value)
+#define yo_impl_radix_key_u64(value)       (value)
+#define yo_impl_radix_key_i32(value)       (yo_cast(u32, value) ^ 0x80000000U)
+#define yo_impl_radix_key_f32(value)       yo_impl_radix_key_from_f32(value)
+#define yo_impl_radix_key_key_index(value) ((value).key)
+
+yo_internal yo_inline u32 yo_impl_radix_key_from_f32(f32 value) {
+    u32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    // Flip all bits of negative numbers, so that larger magnitudes come first, and only the sign
+    // bit of positive numbers, so that they come after all negative numbers.
+    u32 mask = yo_cast(u32, -yo_cast(i32, bits >> 31)) | 0x80000000U;
+    return bits ^ mask;
+}
+
+/// Generate the radix sort of elements of type `T` whose keys are of the unsigned integer type
+/// `KeyType`, given by the key function `key_of`.
+#define yo_impl_define_radix_sort(Name, T, KeyType, key_of)                                       \
+    yo_internal void yo_impl_insertion_sort_##Name(T* values, usize count) {                      \
+        for (usize idx = 1; idx < count; ++idx) {                                                 \
+            T       value = values[idx];                                                          \
+            KeyType key   = key_of(value);                                                        \
+            usize   jdx   = idx;                                                                  \
+            for (; (jdx > 0) && (key_of(values[jdx - 1]) > key); --jdx) {                         \
+                values[jdx] = values[jdx - 1];                                                    \
+            }                                                                                     \
+            values[jdx] = value;                                                                  \
+        }                                                                                         \
+    }                                                                                             \
+                                                                                                  \
+    bool yo_radix_sort_##Name(T* values, usize count) {                                           \
+        if (count <= YO_RADIX_SORT_INSERTION_THRESHOLD) {                                         \
+            yo_impl_insertion_sort_##Name(values, count);                                         \
+            return true;                                                                          \
+        }                                                                                         \
+        yo_assert_not_null(values);                                                               \
+                                                                                                  \
+        usize const digit_count = yo_size_of(KeyType);                                            \
+                                                                                                  \
+        /* Count the histograms of all digits at once. */                                         \
+        usize histograms[yo_size_of(KeyType)][YO_RADIX_BUCKET_COUNT] = {0};                       \
+        for (usize idx = 0; idx < count; ++idx) {                                                 \
+            KeyType key = key_of(values[idx]);                                                    \
+            for (usize digit = 0; digit < digit_count; ++digit) {                                 \
+                ++histograms[digit][(key >> (digit * YO_RADIX_DIGIT_BITS)) & 0xFF];               \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        yo_Scratch scratch = yo_scratch_begin(NULL, 0);                                           \
+        T*         buffer  = yo_arena_alloc_uninit(scratch.arena, T, count);                      \
+        if (yo_unlikely(buffer == NULL)) {                                                        \
+            yo_scratch_end(scratch);                                                              \
+            return false;                                                                         \
+        }                                                                                         \
+                                                                                                  \
+        T* src = values;                                                                          \
+        T* dst = buffer;                                                                          \
+        for (usize digit = 0; digit < digit_count; ++digit) {                                     \
+            usize*    histogram = histograms[digit];                                              \
+            u32 const shift     = yo_cast(u32, digit * YO_RADIX_DIGIT_BITS);                      \
+                                                                                                  \
+            /* A digit shared by all elements leaves their order unchanged. */                    \
+            if (histogram[(key_of(src[0]) >> shift) & 0xFF] == count) {                           \
+                continue;                                                                         \
+            }                                                                                     \
+                                                                                                  \
+            /* Turn the histogram into the starting offset of each bucket. */                     \
+            usize offset = 0;                                                                     \
+            for (usize bucket = 0; bucket < YO_RADIX_BUCKET_COUNT; ++bucket) {                    \
+                usize bucket_count = histogram[bucket];                                           \
+                histogram[bucket]  = offset;                                                      \
+                offset += bucket_count;                                                           \
+            }                                                                                     \
+                                                                                                  \
+            for (usize idx = 0; idx < count; ++idx) {                                             \
+                T value                                           = src[idx];                     \
+                dst[histogram[(key_of(value) >> shift) & 0xFF]++] = value;                        \
+            }                                                                                     \
+                                                                                                  \
+            T* swap = src;                                                                        \
+            src     = dst;                                                                        \
+            dst     = swap;                                                                       \
+        }                                                                                         \
+                                                                                                  \
+        if (src != values) {                                                                      \
+            yo_memory_copy(yo_cast(u8*, values), yo_cast(u8 const*, src), count * yo_size_of(T)); \
+        }                                                                                         \
+                                                                                                  \
+        yo_scratch_end(scratch);                                                                  \
+        return true;                                                                              \
+    }
+
+yo_impl_define_radix_sort(u32, u32, u32, yo_impl_radix_key_u32)
+yo_impl_define_radix_sort(u64, u64, u64, yo_impl_radix_key_u64)
+yo_impl_define_radix_sort(i32, i32, u32, yo_impl_radix_key_i32)
+yo_impl_define_radix_sort(f32, f32, u32, yo_impl_radix_key_f32)
+yo_impl_define_radix_sort(key_index, yo_KeyIndex, u32, yo_impl_radix_key_key_index)
+
+// -----------------------------------------------------------------------------
+// Parallel sort.
+// -----------------------------------------------------------------------------
+
+void yo_impl_parallel_sort_run(yo_ParallelSortContext* context, yo_ThreadProc* worker) {
+    yo_assert_not_null(context);
+    yo_assert(context->thread_count <= YO_PARALLEL_SORT_MAX_THREAD_COUNT);
+
+    // The same threads run every phase of the sort, synchronizing through the barrier of the context.
+    yo_Thread           threads[YO_PARALLEL_SORT_MAX_THREAD_COUNT];
+    yo_ParallelSortTask tasks[YO_PARALLEL_SORT_MAX_THREAD_COUNT];
+    u32                 thread_count = 1;
+    tasks[0]                         = (yo_ParallelSortTask){.context = context, .thread_index = 0};
+    while (thread_count < context->thread_count) {
+        tasks[thread_count] = (yo_ParallelSortTask){.context = context, .thread_index = thread_count};
+        if (yo_unlikely(!yo_thread_spawn(&threads[thread_count], worker, &tasks[thread_count]))) {
+            break;
+        }
+        ++thread_count;
+    }
+
+    context->thread_count = thread_count;
+    context->barrier      = yo_make_barrier(thread_count);
+    yo_atomic_store_u32(&context->started, 1, YO_MEMORY_ORDER_RELEASE);
+    yo_futex_wake_all(&context->started);
+
+    worker(&tasks[0]);
+
+    for (u32 idx = 1; idx < thread_count; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+}
+
+void yo_impl_parallel_sort_wait_start(yo_ParallelSortContext* context) {
+    while (yo_atomic_load_u32(&context->started, YO_MEMORY_ORDER_ACQUIRE) == 0) {
+        yo_futex_wait(&context->started, 0);
+    }
+}
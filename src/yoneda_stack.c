@@ -0,0 +1,134 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the LIFO stack allocator.
+/// File name: yoneda_stack.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_stack.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+#define yo_impl_stack_header_of(block) (yo_cast(yo_StackHeader*, block) - 1)
+
+yo_Stack yo_make_stack(yo_Arena* arena, usize capacity) {
+    yo_assert_not_null(arena);
+
+    // Blocks are zeroed when pushed, there's no need to touch the memory right away.
+    u8* memory = yo_arena_alloc_uninit_align(arena, capacity, yo_align_of(yo_StackHeader));
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("Unable to allocate a stack with %zu bytes of capacity.", capacity);
+        return yo_make_default(yo_Stack);
+    }
+
+    return (yo_Stack){.buf = memory, .capacity = capacity};
+}
+
+u8* yo_stack_push_align(yo_Stack* stack, usize size_bytes, u32 alignment) {
+    yo_assert_not_null(stack);
+    if (yo_unlikely(size_bytes == 0)) {
+        return NULL;
+    }
+
+    uptr  free_addr = yo_cast(uptr, stack->buf) + stack->offset;
+    usize padding   = yo_padding_with_header(free_addr, alignment, yo_size_of(yo_StackHeader), yo_align_of(yo_StackHeader));
+    if (yo_unlikely(stack->offset + padding + size_bytes > stack->capacity)) {
+        yo_log_error_fmt(
+            "Stack unable to allocate %zu bytes (with %u bytes of alignment) of memory."
+            " The allocator has only %zu bytes remaining.",
+            size_bytes,
+            alignment,
+            stack->capacity - stack->offset);
+        yo_impl_return_from_memory_error();
+    }
+
+    usize block_offset = stack->offset + padding;
+    u8*   block        = stack->buf + block_offset;
+
+    yo_StackHeader* header  = yo_impl_stack_header_of(block);
+    header->padding         = padding;
+    header->capacity        = size_bytes;
+    header->previous_offset = stack->top_offset;
+
+    stack->offset     = block_offset + size_bytes;
+    stack->top_offset = block_offset;
+
+    yo_memory_set(block, size_bytes, 0);
+    return block;
+}
+
+u8* yo_stack_realloc_align(yo_Stack* stack, u8* block, usize new_size_bytes, u32 alignment) {
+    yo_assert_not_null(stack);
+    yo_assert_msg(new_size_bytes != 0, "Don't use realloc to free blocks of memory.");
+    yo_assert_msg(block != NULL, "Don't use realloc to allocate new memory.");
+
+    yo_StackHeader* header       = yo_impl_stack_header_of(block);
+    usize           current_size = header->capacity;
+
+    // The top block can be resized in-place, as long as it already satisfies the requested alignment.
+    bool is_aligned = (yo_align_forward(yo_cast(uptr, block), alignment) == yo_cast(uptr, block));
+    if ((block == yo_stack_top(stack)) && is_aligned) {
+        if (yo_unlikely(stack->top_offset + new_size_bytes > stack->capacity)) {
+            yo_log_error_fmt("Unable to resize the top block of the stack from %zu bytes to %zu bytes.", current_size, new_size_bytes);
+            yo_impl_return_from_memory_error();
+        }
+
+        if (new_size_bytes > current_size) {
+            yo_memory_set(block + current_size, new_size_bytes - current_size, 0);
+        }
+        header->capacity = new_size_bytes;
+        stack->offset    = stack->top_offset + new_size_bytes;
+        return block;
+    }
+
+    u8* new_block = yo_stack_push_align(stack, new_size_bytes, alignment);
+    if (yo_likely(new_block != NULL)) {
+        yo_memory_copy(new_block, block, yo_min_value(current_size, new_size_bytes));
+    }
+
+    return new_block;
+}
+
+yo_Status yo_stack_pop_block(yo_Stack* stack, void const* block) {
+    yo_assert_not_null(stack);
+
+    if (yo_unlikely((block == NULL) || (yo_cast(u8 const*, block) != yo_stack_top(stack)))) {
+        yo_log_error("Unable to pop a block that isn't at the top of the stack.");
+        return YO_STATUS_FAILED;
+    }
+
+    yo_stack_pop_top(stack);
+    return YO_STATUS_OK;
+}
+
+void yo_stack_pop_top(yo_Stack* stack) {
+    yo_assert_not_null(stack);
+    if (stack->top_offset == 0) {
+        return;
+    }
+
+    yo_StackHeader const* header = yo_impl_stack_header_of(stack->buf + stack->top_offset);
+    stack->offset                = stack->top_offset - header->padding;
+    stack->top_offset            = header->previous_offset;
+}
@@ -61,8 +61,8 @@ yo_inline bool yo_has_read_permission(yo_FileFlag flag) {
            (flag == YO_FILE_FLAG_WRITE_EXTENDED);
 }
 
-// @TODO: improve error handling.
-yo_FileReadResult yo_read_file(yo_Arena* arena, cstring file_name, yo_FileFlag flag) {
+/// Open a file and get its size in bytes.
+yo_internal yo_FileStatus yo_impl_file_open_with_size(cstring file_name, yo_FileFlag flag, FILE** file_handle_out, usize* buf_size_out) {
     yo_FileStatus status = YO_FILE_STATUS_NONE;
 
     // Open file.
@@ -96,6 +96,17 @@ yo_FileReadResult yo_read_file(yo_Arena* arena, cstring file_name, yo_FileFlag f
         }
     }
 
+    *file_handle_out = file_handle;
+    *buf_size_out    = buf_size;
+    return status;
+}
+
+// @TODO: improve error handling.
+yo_FileReadResult yo_read_file(yo_Arena* arena, cstring file_name, yo_FileFlag flag) {
+    FILE*         file_handle;
+    usize         buf_size;
+    yo_FileStatus status = yo_impl_file_open_with_size(file_name, flag, &file_handle, &buf_size);
+
     yo_ArenaCheckpoint arena_checkpoint = yo_make_arena_checkpoint(arena);
 
     // Allocate target buffer.
@@ -103,7 +114,8 @@ yo_FileReadResult yo_read_file(yo_Arena* arena, cstring file_name, yo_FileFlag f
     if (yo_likely(status == YO_FILE_STATUS_NONE)) {
         yo_assert_msg(arena != NULL, "Invalid arena.");
 
-        buf = yo_arena_alloc(arena, u8, buf_size);
+        // The whole buffer is overwritten by the file contents, no need to zero it beforehand.
+        buf = yo_arena_alloc_uninit(arena, u8, buf_size);
         if (yo_unlikely(buf == NULL)) {
             status |= YO_FILE_STATUS_OUT_OF_MEMORY;
         }
@@ -135,6 +147,48 @@ yo_FileReadResult yo_read_file(yo_Arena* arena, cstring file_name, yo_FileFlag f
     };
 }
 
+yo_FileReadResult yo_read_file_with_allocator(yo_Allocator const* allocator, cstring file_name, yo_FileFlag flag) {
+    FILE*         file_handle;
+    usize         buf_size;
+    yo_FileStatus status = yo_impl_file_open_with_size(file_name, flag, &file_handle, &buf_size);
+
+    // Allocate target buffer.
+    u8* buf = NULL;
+    if (yo_likely(status == YO_FILE_STATUS_NONE)) {
+        yo_assert_msg(allocator != NULL, "Invalid allocator.");
+
+        buf = yo_allocator_alloc(allocator, u8, buf_size);
+        if (yo_unlikely(buf == NULL)) {
+            status |= YO_FILE_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    // Read file content to the target buffer.
+    if (yo_likely(status == YO_FILE_STATUS_NONE)) {
+        usize read_count = fread(buf, yo_size_of(u8), buf_size, file_handle);
+
+        if (yo_unlikely(read_count != buf_size)) {
+            yo_allocator_free(allocator, buf, buf_size);
+
+            buf      = NULL;
+            buf_size = 0;
+            status |= YO_FILE_STATUS_FAILED_TO_READ;
+        }
+    }
+
+    if (yo_likely(!(status & YO_FILE_STATUS_FAILED_TO_OPEN))) {
+        if (yo_unlikely(fclose(file_handle) == EOF)) {
+            status |= YO_FILE_STATUS_FAILED_TO_CLOSE;
+        }
+    }
+
+    return (yo_FileReadResult){
+        .buf      = buf,
+        .buf_size = buf_size,
+        .status   = status,
+    };
+}
+
 yo_DynString yo_read_stdin(yo_Arena* arena, u32 initial_buf_size, u32 read_chunk_size) {
     yo_ArenaCheckpoint arena_checkpoint = yo_make_arena_checkpoint(arena);
 
@@ -229,3 +283,138 @@ yo_DynString yo_absolute_path(yo_Arena* arena, cstring file_path) {
 
     return abs_path;
 }
+
+// -----------------------------------------------------------------------------
+// Stream ring buffer.
+// -----------------------------------------------------------------------------
+
+yo_StreamRing yo_make_stream_ring(usize capacity) {
+    usize ring_capacity = YO_STREAM_RING_MIN_CAPACITY;
+    while (ring_capacity < capacity) {
+        ring_capacity <<= 1;
+    }
+
+    bool mirrored = true;
+    u8*  buf      = yo_memory_virtual_alloc_mirrored(ring_capacity);
+    if (buf == NULL) {
+        // Fallback to a single mapping, splitting the spans at the wrap point.
+        mirrored = false;
+        buf      = yo_memory_virtual_alloc(ring_capacity);
+    }
+
+    if (yo_unlikely(buf == NULL)) {
+        yo_log_error_fmt("Unable to allocate a stream ring of %zu bytes.", ring_capacity);
+        return yo_make_default(yo_StreamRing);
+    }
+
+    return (yo_StreamRing){.buf = buf, .capacity = ring_capacity, .mirrored = mirrored};
+}
+
+void yo_destroy_stream_ring(yo_StreamRing* ring) {
+    if (yo_unlikely((ring == NULL) || (ring->buf == NULL))) {
+        return;
+    }
+
+    if (ring->mirrored) {
+        yo_memory_virtual_free_mirrored(ring->buf, ring->capacity);
+    } else {
+        yo_memory_virtual_free(ring->buf, ring->capacity);
+    }
+    *ring = yo_make_default(yo_StreamRing);
+}
+
+/// Get the number of contiguous bytes starting at a given offset of the ring memory.
+yo_internal yo_inline usize yo_impl_stream_ring_span(yo_StreamRing const* ring, usize offset, usize size_bytes) {
+    return ring->mirrored ? size_bytes : yo_min_value(size_bytes, ring->capacity - offset);
+}
+
+usize yo_stream_ring_write(yo_StreamRing* ring, u8 const* data, usize size_bytes) {
+    yo_assert_not_null(ring);
+
+    usize size_written = yo_min_value(size_bytes, ring->capacity - (ring->tail - ring->head));
+    usize offset       = ring->tail & (ring->capacity - 1);
+    usize first_span   = yo_impl_stream_ring_span(ring, offset, size_written);
+    yo_memory_copy(ring->buf + offset, data, first_span);
+    yo_memory_copy(ring->buf, data + first_span, size_written - first_span);
+
+    ring->tail += size_written;
+    return size_written;
+}
+
+usize yo_stream_ring_read(yo_StreamRing* ring, u8* data, usize size_bytes) {
+    yo_assert_not_null(ring);
+
+    usize size_read  = yo_min_value(size_bytes, ring->tail - ring->head);
+    usize offset     = ring->head & (ring->capacity - 1);
+    usize first_span = yo_impl_stream_ring_span(ring, offset, size_read);
+    yo_memory_copy(data, ring->buf + offset, first_span);
+    yo_memory_copy(data + first_span, ring->buf, size_read - first_span);
+
+    ring->head += size_read;
+    return size_read;
+}
+
+yo_String yo_stream_ring_peek(yo_StreamRing const* ring) {
+    yo_assert_not_null(ring);
+
+    usize offset = ring->head & (ring->capacity - 1);
+    return (yo_String){
+        .buf    = yo_cast(char const*, ring->buf + offset),
+        .length = yo_impl_stream_ring_span(ring, offset, ring->tail - ring->head),
+    };
+}
+
+void yo_stream_ring_consume(yo_StreamRing* ring, usize size_bytes) {
+    yo_assert_not_null(ring);
+    yo_assert_fmt(size_bytes <= ring->tail - ring->head, "Unable to consume %zu bytes from the stream ring.", size_bytes);
+
+    ring->head += size_bytes;
+}
+
+u8* yo_stream_ring_write_span(yo_StreamRing* ring, usize* span_size) {
+    yo_assert_not_null(ring);
+    yo_assert_not_null(span_size);
+
+    usize offset = ring->tail & (ring->capacity - 1);
+    *span_size   = yo_impl_stream_ring_span(ring, offset, ring->capacity - (ring->tail - ring->head));
+    return ring->buf + offset;
+}
+
+void yo_stream_ring_commit(yo_StreamRing* ring, usize size_bytes) {
+    yo_assert_not_null(ring);
+    yo_assert_fmt(size_bytes <= ring->capacity - (ring->tail - ring->head), "Unable to commit %zu bytes to the stream ring.", size_bytes);
+
+    ring->tail += size_bytes;
+}
+
+isize yo_stream_ring_read_stdin(yo_StreamRing* ring) {
+    usize span_size = 0;
+    u8*   span      = yo_stream_ring_write_span(ring, &span_size);
+    if (span_size == 0) {
+        return 0;
+    }
+
+#if defined(YO_OS_WINDOWS)
+    HANDLE handle_stdin = GetStdHandle(STD_INPUT_HANDLE);
+    if (handle_stdin == INVALID_HANDLE_VALUE) {
+        yo_log_error("Unable to acquire the handle to the stdin stream.");
+        return -1;
+    }
+
+    DWORD bytes_read = 0;
+    BOOL  success    = ReadFile(handle_stdin, span, yo_cast(DWORD, yo_min_value(span_size, yo_cast(usize, MAXDWORD))), &bytes_read, NULL);
+    if (yo_unlikely(!success)) {
+        yo_log_error("Unable to read from the stdin stream.");
+        return -1;
+    }
+#else
+    isize bytes_read = read(STDIN_FILENO, span, span_size);
+    if (yo_unlikely(bytes_read == -1)) {
+        yo_log_error("Unable to read from the stdin stream.");
+        return -1;
+    }
+#endif
+
+    ring->tail += yo_cast(usize, bytes_read);
+    return yo_cast(isize, bytes_read);
+}
@@ -55,7 +55,9 @@ bool yo_cstring_equal(cstring lhs, cstring rhs) {
 
 yo_Status yo_dynstring_resize(yo_DynString* dstring, usize new_capacity) {
     char* new_buf;
-    if (dstring->capacity == 0) {
+    if (dstring->allocator != NULL) {
+        new_buf = yo_allocator_resize(dstring->allocator, char, dstring->buf, dstring->capacity, new_capacity);
+    } else if (dstring->capacity == 0) {
         new_buf = yo_arena_alloc(dstring->arena, char, new_capacity);
     } else {
         new_buf = yo_arena_realloc(dstring->arena, char, dstring->buf, dstring->capacity, new_capacity);
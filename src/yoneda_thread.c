@@ -0,0 +1,199 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the threads and thread synchronization primitives.
+/// File name: yoneda_thread.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_thread.h>
+
+#if defined(YO_OS_WINDOWS)
+#    include <Windows.h>
+#    if defined(YO_COMPILER_MSVC)
+#        pragma comment(lib, "Synchronization.lib")
+#    endif
+#elif defined(YO_OS_LINUX)
+#    include <limits.h>
+#    include <linux/futex.h>
+#    include <pthread.h>
+#    include <sched.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#else
+#    include <pthread.h>
+#    include <sched.h>
+#    include <unistd.h>
+#endif
+
+#include <string.h>
+#include <yoneda_assert.h>
+#include <yoneda_atomic.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+// -----------------------------------------------------------------------------
+// Threads.
+// -----------------------------------------------------------------------------
+
+#if defined(YO_OS_WINDOWS)
+yo_internal DWORD WINAPI yo_impl_thread_entry(LPVOID parameter) {
+    yo_Thread* thread = yo_cast(yo_Thread*, parameter);
+    thread->proc(thread->user_data);
+    return 0;
+}
+#else
+yo_internal void* yo_impl_thread_entry(void* parameter) {
+    yo_Thread* thread = yo_cast(yo_Thread*, parameter);
+    thread->proc(thread->user_data);
+    return NULL;
+}
+#endif
+
+bool yo_thread_spawn(yo_Thread* thread, yo_ThreadProc* proc, void* user_data) {
+    yo_assert_not_null(thread);
+    yo_assert_not_null(proc);
+
+    thread->proc      = proc;
+    thread->user_data = user_data;
+
+#if defined(YO_OS_WINDOWS)
+    HANDLE handle = CreateThread(NULL, 0, yo_impl_thread_entry, thread, 0, NULL);
+    if (yo_unlikely(handle == NULL)) {
+        yo_log_error_fmt("Unable to create thread, error code: %lu.", GetLastError());
+        return false;
+    }
+    thread->handle = yo_cast(uptr, handle);
+#else
+    pthread_t handle;
+    i32       result = pthread_create(&handle, NULL, yo_impl_thread_entry, thread);
+    if (yo_unlikely(result != 0)) {
+        yo_log_error_fmt("Unable to create thread, error code: %d.", result);
+        return false;
+    }
+
+    // The handle type is opaque, but pointer-sized on all supported platforms.
+    yo_constexpr_assert(sizeof(pthread_t) <= sizeof(uptr));
+    thread->handle = 0;
+    memcpy(&thread->handle, &handle, sizeof(handle));
+#endif
+
+    return true;
+}
+
+void yo_thread_join(yo_Thread* thread) {
+    yo_assert_not_null(thread);
+
+#if defined(YO_OS_WINDOWS)
+    HANDLE handle = yo_cast(HANDLE, thread->handle);
+    yo_discard_value(WaitForSingleObject(handle, INFINITE));
+    yo_discard_value(CloseHandle(handle));
+#else
+    pthread_t handle;
+    memcpy(&handle, &thread->handle, sizeof(handle));
+    yo_discard_value(pthread_join(handle, NULL));
+#endif
+}
+
+u32 yo_thread_hardware_count(void) {
+#if defined(YO_OS_WINDOWS)
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return yo_max_value(yo_cast(u32, system_info.dwNumberOfProcessors), 1U);
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? yo_cast(u32, count) : 1U;
+#endif
+}
+
+void yo_thread_yield(void) {
+#if defined(YO_OS_WINDOWS)
+    yo_discard_value(SwitchToThread());
+#else
+    yo_discard_value(sched_yield());
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Futex.
+// -----------------------------------------------------------------------------
+
+void yo_futex_wait(u32 volatile* address, u32 expected_value) {
+#if defined(YO_OS_WINDOWS)
+    yo_discard_value(WaitOnAddress(address, &expected_value, yo_size_of(u32), INFINITE));
+#elif defined(YO_OS_LINUX)
+    // Interruptions and value mismatches are reported as errors, both of which are just a wake up
+    // for the caller.
+    yo_discard_value(syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected_value, NULL, NULL, 0));
+#else
+    if (*address == expected_value) {
+        yo_discard_value(sched_yield());
+    }
+#endif
+}
+
+void yo_futex_wake_one(u32 volatile* address) {
+#if defined(YO_OS_WINDOWS)
+    WakeByAddressSingle(yo_cast(PVOID, address));
+#elif defined(YO_OS_LINUX)
+    yo_discard_value(syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0));
+#else
+    yo_discard_value(address);
+#endif
+}
+
+void yo_futex_wake_all(u32 volatile* address) {
+#if defined(YO_OS_WINDOWS)
+    WakeByAddressAll(yo_cast(PVOID, address));
+#elif defined(YO_OS_LINUX)
+    yo_discard_value(syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0));
+#else
+    yo_discard_value(address);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Barrier.
+// -----------------------------------------------------------------------------
+
+yo_Barrier yo_make_barrier(u32 thread_count) {
+    yo_assert(thread_count >= 1);
+    return (yo_Barrier){.thread_count = thread_count};
+}
+
+bool yo_barrier_wait(yo_Barrier* barrier) {
+    yo_assert_not_null(barrier);
+
+    // The phase can't advance before the calling thread arrives, so it's safe to read it first.
+    u32 phase = yo_atomic_load_u32(&barrier->phase, YO_MEMORY_ORDER_ACQUIRE);
+    if (yo_atomic_fetch_add_u32(&barrier->arrived_count, 1, YO_MEMORY_ORDER_ACQ_REL) + 1 == barrier->thread_count) {
+        // Reset the count before releasing the other threads into the next phase.
+        yo_atomic_store_u32(&barrier->arrived_count, 0, YO_MEMORY_ORDER_RELAXED);
+        yo_discard_value(yo_atomic_fetch_add_u32(&barrier->phase, 1, YO_MEMORY_ORDER_RELEASE));
+        yo_futex_wake_all(&barrier->phase);
+        return true;
+    }
+
+    while (yo_atomic_load_u32(&barrier->phase, YO_MEMORY_ORDER_ACQUIRE) == phase) {
+        yo_futex_wait(&barrier->phase, phase);
+    }
+    return false;
+}
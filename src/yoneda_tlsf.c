@@ -0,0 +1,604 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Implementation of the two-level segregated fit allocator.
+/// File name: yoneda_tlsf.c
+/// Author: Luiz G. Mugnaini A. <luizmugnaini@gmail.com>
+
+#include <yoneda_tlsf.h>
+
+#include <yoneda_assert.h>
+#include <yoneda_bit.h>
+#include <yoneda_log.h>
+
+#include "yoneda_impl_common.h"
+
+// -----------------------------------------------------------------------------
+// Block layout.
+//
+// The payload of a block starts right after its size word, and the header of the next physical
+// block starts at the last word of the payload, so that the `prev_physical` field of the next block
+// overlaps with the payload and is only written once the block is freed.
+// -----------------------------------------------------------------------------
+
+#define YO_TLSF_BLOCK_FREE_BIT      (yo_cast(usize, 1) << 0)
+#define YO_TLSF_BLOCK_PREV_FREE_BIT (yo_cast(usize, 1) << 1)
+
+/// Overhead of an allocated block: only the size word is kept.
+#define YO_TLSF_BLOCK_OVERHEAD     yo_size_of(usize)
+/// Offset from the start of the block header to its payload.
+#define YO_TLSF_BLOCK_START_OFFSET (yo_size_of(yo_TlsfBlock*) + yo_size_of(usize))
+/// A free block must be able to store its header, except for the overlapping `prev_physical` field.
+#define YO_TLSF_BLOCK_SIZE_MIN     (yo_size_of(yo_TlsfBlock) - yo_size_of(yo_TlsfBlock*))
+#define YO_TLSF_BLOCK_SIZE_MAX     (yo_cast(usize, 1) << YO_TLSF_FL_INDEX_MAX)
+/// Overhead of a pool: the size word of the first block and the zero-sized sentinel block.
+#define YO_TLSF_POOL_OVERHEAD      (2 * YO_TLSF_BLOCK_OVERHEAD)
+
+yo_internal yo_inline usize yo_impl_tlsf_block_size(yo_TlsfBlock const* block) {
+    return block->size & ~(YO_TLSF_BLOCK_FREE_BIT | YO_TLSF_BLOCK_PREV_FREE_BIT);
+}
+
+yo_internal yo_inline void yo_impl_tlsf_block_set_size(yo_TlsfBlock* block, usize size) {
+    block->size = size | (block->size & (YO_TLSF_BLOCK_FREE_BIT | YO_TLSF_BLOCK_PREV_FREE_BIT));
+}
+
+yo_internal yo_inline bool yo_impl_tlsf_block_is_last(yo_TlsfBlock const* block) {
+    return yo_impl_tlsf_block_size(block) == 0;
+}
+
+yo_internal yo_inline bool yo_impl_tlsf_block_is_free(yo_TlsfBlock const* block) {
+    return (block->size & YO_TLSF_BLOCK_FREE_BIT) != 0;
+}
+
+yo_internal yo_inline void yo_impl_tlsf_block_set_free(yo_TlsfBlock* block, bool is_free) {
+    block->size = is_free ? (block->size | YO_TLSF_BLOCK_FREE_BIT) : (block->size & ~YO_TLSF_BLOCK_FREE_BIT);
+}
+
+yo_internal yo_inline bool yo_impl_tlsf_block_is_prev_free(yo_TlsfBlock const* block) {
+    return (block->size & YO_TLSF_BLOCK_PREV_FREE_BIT) != 0;
+}
+
+yo_internal yo_inline void yo_impl_tlsf_block_set_prev_free(yo_TlsfBlock* block, bool is_free) {
+    block->size = is_free ? (block->size | YO_TLSF_BLOCK_PREV_FREE_BIT) : (block->size & ~YO_TLSF_BLOCK_PREV_FREE_BIT);
+}
+
+yo_internal yo_inline yo_TlsfBlock* yo_impl_tlsf_block_from_ptr(void const* ptr) {
+    return yo_cast(yo_TlsfBlock*, yo_cast(uptr, ptr) - YO_TLSF_BLOCK_START_OFFSET);
+}
+
+yo_internal yo_inline u8* yo_impl_tlsf_block_to_ptr(yo_TlsfBlock const* block) {
+    return yo_cast(u8*, yo_cast(uptr, block) + YO_TLSF_BLOCK_START_OFFSET);
+}
+
+/// Get the block header located at a given offset from a pointer, the offset may be negative.
+yo_internal yo_inline yo_TlsfBlock* yo_impl_tlsf_offset_to_block(void const* ptr, isize offset) {
+    return yo_cast(yo_TlsfBlock*, yo_cast(uptr, ptr) + yo_cast(uptr, offset));
+}
+
+yo_internal yo_inline yo_TlsfBlock* yo_impl_tlsf_block_prev(yo_TlsfBlock const* block) {
+    yo_assert_msg(yo_impl_tlsf_block_is_prev_free(block), "Previous physical block must be free.");
+    return block->prev_physical;
+}
+
+yo_internal yo_inline yo_TlsfBlock* yo_impl_tlsf_block_next(yo_TlsfBlock const* block) {
+    yo_assert_msg(!yo_impl_tlsf_block_is_last(block), "The sentinel block has no next physical block.");
+    return yo_impl_tlsf_offset_to_block(
+        yo_impl_tlsf_block_to_ptr(block),
+        yo_cast(isize, yo_impl_tlsf_block_size(block) - YO_TLSF_BLOCK_OVERHEAD));
+}
+
+/// Link the next physical block back to the given block.
+yo_internal yo_inline yo_TlsfBlock* yo_impl_tlsf_block_link_next(yo_TlsfBlock* block) {
+    yo_TlsfBlock* next  = yo_impl_tlsf_block_next(block);
+    next->prev_physical = block;
+    return next;
+}
+
+yo_internal yo_inline void yo_impl_tlsf_block_mark_as_free(yo_TlsfBlock* block) {
+    yo_TlsfBlock* next = yo_impl_tlsf_block_link_next(block);
+    yo_impl_tlsf_block_set_prev_free(next, true);
+    yo_impl_tlsf_block_set_free(block, true);
+}
+
+yo_internal yo_inline void yo_impl_tlsf_block_mark_as_used(yo_TlsfBlock* block) {
+    yo_TlsfBlock* next = yo_impl_tlsf_block_next(block);
+    yo_impl_tlsf_block_set_prev_free(next, false);
+    yo_impl_tlsf_block_set_free(block, false);
+}
+
+/// Round a requested size up to the allocation granularity, or zero if the request is too large.
+yo_internal yo_inline usize yo_impl_tlsf_adjust_request_size(usize size_bytes, usize alignment) {
+    if (size_bytes == 0) {
+        return 0;
+    }
+
+    usize aligned_size = yo_align_forward(size_bytes, alignment);
+    return (aligned_size < YO_TLSF_BLOCK_SIZE_MAX) ? yo_max_value(aligned_size, YO_TLSF_BLOCK_SIZE_MIN) : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Size class mapping.
+// -----------------------------------------------------------------------------
+
+/// Compute the class containing blocks of a given size.
+yo_internal yo_inline void yo_impl_tlsf_mapping_insert(usize size, u32* fl_index, u32* sl_index) {
+    if (size < YO_TLSF_SMALL_BLOCK_SIZE) {
+        *fl_index = 0;
+        *sl_index = yo_cast(u32, size) / (YO_TLSF_SMALL_BLOCK_SIZE / YO_TLSF_SL_INDEX_COUNT);
+    } else {
+        u32 fl    = yo_u64_msb_index(size);
+        *sl_index = yo_cast(u32, size >> (fl - YO_TLSF_SL_INDEX_COUNT_LOG2)) ^ (1u << YO_TLSF_SL_INDEX_COUNT_LOG2);
+        *fl_index = fl - (YO_TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+/// Compute the first class whose blocks are all large enough to fit a given size.
+yo_internal yo_inline void yo_impl_tlsf_mapping_search(usize size, u32* fl_index, u32* sl_index) {
+    if (size >= YO_TLSF_SMALL_BLOCK_SIZE) {
+        size += (yo_cast(usize, 1) << (yo_u64_msb_index(size) - YO_TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    yo_impl_tlsf_mapping_insert(size, fl_index, sl_index);
+}
+
+/// Find a non-empty class at least as large as the given one, updating the class indices.
+yo_internal yo_TlsfBlock* yo_impl_tlsf_search_suitable_block(yo_Tlsf* tlsf, u32* fl_index, u32* sl_index) {
+    u32 fl = *fl_index;
+    u32 sl = *sl_index;
+
+    u32 sl_map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        // No block in the first level class is large enough, search the next non-empty one.
+        u64 fl_map = (fl + 1 < YO_TLSF_FL_INDEX_COUNT) ? (tlsf->fl_bitmap & (~yo_cast(u64, 0) << (fl + 1))) : 0;
+        if (fl_map == 0) {
+            return NULL;
+        }
+
+        fl     = yo_u64_lsb_index(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    yo_assert_msg(sl_map != 0, "Second level bitmap is inconsistent with the first level bitmap.");
+    sl = yo_u32_lsb_index(sl_map);
+
+    *fl_index = fl;
+    *sl_index = sl;
+    return tlsf->blocks[fl][sl];
+}
+
+// -----------------------------------------------------------------------------
+// Free lists.
+// -----------------------------------------------------------------------------
+
+yo_internal void yo_impl_tlsf_remove_free_block(yo_Tlsf* tlsf, yo_TlsfBlock* block, u32 fl, u32 sl) {
+    yo_TlsfBlock* prev = block->prev_free;
+    yo_TlsfBlock* next = block->next_free;
+    next->prev_free    = prev;
+    prev->next_free    = next;
+
+    if (tlsf->blocks[fl][sl] == block) {
+        tlsf->blocks[fl][sl] = next;
+
+        if (next == &tlsf->null_block) {
+            tlsf->sl_bitmap[fl] &= ~(1u << sl);
+            if (tlsf->sl_bitmap[fl] == 0) {
+                tlsf->fl_bitmap &= ~(yo_cast(u64, 1) << fl);
+            }
+        }
+    }
+}
+
+yo_internal void yo_impl_tlsf_insert_free_block(yo_Tlsf* tlsf, yo_TlsfBlock* block, u32 fl, u32 sl) {
+    yo_TlsfBlock* current = tlsf->blocks[fl][sl];
+    block->next_free      = current;
+    block->prev_free      = &tlsf->null_block;
+    current->prev_free    = block;
+
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= yo_cast(u64, 1) << fl;
+    tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+yo_internal void yo_impl_tlsf_block_remove(yo_Tlsf* tlsf, yo_TlsfBlock* block) {
+    u32 fl, sl;
+    yo_impl_tlsf_mapping_insert(yo_impl_tlsf_block_size(block), &fl, &sl);
+    yo_impl_tlsf_remove_free_block(tlsf, block, fl, sl);
+}
+
+yo_internal void yo_impl_tlsf_block_insert(yo_Tlsf* tlsf, yo_TlsfBlock* block) {
+    u32 fl, sl;
+    yo_impl_tlsf_mapping_insert(yo_impl_tlsf_block_size(block), &fl, &sl);
+    yo_impl_tlsf_insert_free_block(tlsf, block, fl, sl);
+}
+
+// -----------------------------------------------------------------------------
+// Splitting and merging of blocks.
+// -----------------------------------------------------------------------------
+
+yo_internal yo_inline bool yo_impl_tlsf_block_can_split(yo_TlsfBlock const* block, usize size) {
+    return yo_impl_tlsf_block_size(block) >= yo_size_of(yo_TlsfBlock) + size;
+}
+
+/// Split a block in two, returning the free remainder past the first `size` bytes.
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_split(yo_TlsfBlock* block, usize size) {
+    yo_TlsfBlock* remaining      = yo_impl_tlsf_offset_to_block(yo_impl_tlsf_block_to_ptr(block), yo_cast(isize, size - YO_TLSF_BLOCK_OVERHEAD));
+    usize         remaining_size = yo_impl_tlsf_block_size(block) - (size + YO_TLSF_BLOCK_OVERHEAD);
+    yo_assert_msg(remaining_size >= YO_TLSF_BLOCK_SIZE_MIN, "Block split with a remainder that is too small.");
+
+    remaining->size = remaining_size;
+    yo_impl_tlsf_block_set_size(block, size);
+    yo_impl_tlsf_block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/// Absorb a free block into its previous physical block.
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_absorb(yo_TlsfBlock* prev, yo_TlsfBlock* block) {
+    yo_assert_msg(!yo_impl_tlsf_block_is_last(prev), "The sentinel block can't absorb other blocks.");
+
+    prev->size += yo_impl_tlsf_block_size(block) + YO_TLSF_BLOCK_OVERHEAD;
+    yo_impl_tlsf_block_link_next(prev);
+    return prev;
+}
+
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_merge_prev(yo_Tlsf* tlsf, yo_TlsfBlock* block) {
+    if (yo_impl_tlsf_block_is_prev_free(block)) {
+        yo_TlsfBlock* prev = yo_impl_tlsf_block_prev(block);
+        yo_impl_tlsf_block_remove(tlsf, prev);
+        block = yo_impl_tlsf_block_absorb(prev, block);
+    }
+    return block;
+}
+
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_merge_next(yo_Tlsf* tlsf, yo_TlsfBlock* block) {
+    yo_TlsfBlock* next = yo_impl_tlsf_block_next(block);
+    if (yo_impl_tlsf_block_is_free(next)) {
+        yo_impl_tlsf_block_remove(tlsf, next);
+        block = yo_impl_tlsf_block_absorb(block, next);
+    }
+    return block;
+}
+
+/// Trim the trailing excess of a free block, returning it to the free lists.
+yo_internal void yo_impl_tlsf_block_trim_free(yo_Tlsf* tlsf, yo_TlsfBlock* block, usize size) {
+    yo_assert_msg(yo_impl_tlsf_block_is_free(block), "Expected a free block.");
+
+    if (yo_impl_tlsf_block_can_split(block, size)) {
+        yo_TlsfBlock* remaining = yo_impl_tlsf_block_split(block, size);
+        yo_impl_tlsf_block_link_next(block);
+        yo_impl_tlsf_block_set_prev_free(remaining, true);
+        yo_impl_tlsf_block_insert(tlsf, remaining);
+    }
+}
+
+/// Trim the trailing excess of a used block, merging it with the next block if free.
+yo_internal void yo_impl_tlsf_block_trim_used(yo_Tlsf* tlsf, yo_TlsfBlock* block, usize size) {
+    yo_assert_msg(!yo_impl_tlsf_block_is_free(block), "Expected a used block.");
+
+    if (yo_impl_tlsf_block_can_split(block, size)) {
+        yo_TlsfBlock* remaining = yo_impl_tlsf_block_split(block, size);
+        yo_impl_tlsf_block_set_prev_free(remaining, false);
+
+        remaining = yo_impl_tlsf_block_merge_next(tlsf, remaining);
+        yo_impl_tlsf_block_insert(tlsf, remaining);
+    }
+}
+
+/// Trim the leading `size` bytes of a free block, returning them to the free lists.
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_trim_free_leading(yo_Tlsf* tlsf, yo_TlsfBlock* block, usize size) {
+    yo_TlsfBlock* remaining = block;
+    if (yo_impl_tlsf_block_can_split(block, size)) {
+        remaining = yo_impl_tlsf_block_split(block, size - YO_TLSF_BLOCK_OVERHEAD);
+        yo_impl_tlsf_block_set_prev_free(remaining, true);
+
+        yo_impl_tlsf_block_link_next(block);
+        yo_impl_tlsf_block_insert(tlsf, block);
+    }
+    return remaining;
+}
+
+yo_internal yo_TlsfBlock* yo_impl_tlsf_block_locate_free(yo_Tlsf* tlsf, usize size) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    u32 fl, sl;
+    yo_impl_tlsf_mapping_search(size, &fl, &sl);
+    if (yo_unlikely(fl >= YO_TLSF_FL_INDEX_COUNT)) {
+        return NULL;
+    }
+
+    yo_TlsfBlock* block = yo_impl_tlsf_search_suitable_block(tlsf, &fl, &sl);
+    if ((block == NULL) || (block == &tlsf->null_block)) {
+        return NULL;
+    }
+
+    yo_assert_msg(yo_impl_tlsf_block_size(block) >= size, "Free list contains a block that is too small.");
+    yo_impl_tlsf_remove_free_block(tlsf, block, fl, sl);
+    return block;
+}
+
+/// Mark a free block as used, trimming its excess and zeroing its payload.
+yo_internal u8* yo_impl_tlsf_block_prepare_used(yo_Tlsf* tlsf, yo_TlsfBlock* block, usize size) {
+    yo_impl_tlsf_block_trim_free(tlsf, block, size);
+    yo_impl_tlsf_block_mark_as_used(block);
+
+    usize block_size = yo_impl_tlsf_block_size(block);
+    tlsf->used_bytes += block_size + YO_TLSF_BLOCK_OVERHEAD;
+    tlsf->peak_used_bytes = yo_max_value(tlsf->peak_used_bytes, tlsf->used_bytes);
+
+    u8* ptr = yo_impl_tlsf_block_to_ptr(block);
+    yo_memory_set(ptr, block_size, 0);
+    return ptr;
+}
+
+#define yo_impl_tlsf_report_out_of_memory(tlsf, requested_size, requested_alignment)              \
+    do {                                                                                          \
+        yo_log_error_fmt(                                                                         \
+            "TLSF allocator unable to allocate %zu bytes (with %u bytes of alignment) of memory." \
+            " The allocator has %zu bytes free.",                                                 \
+            requested_size,                                                                       \
+            requested_alignment,                                                                  \
+            (tlsf)->capacity - (tlsf)->used_bytes);                                               \
+    } while (0)
+
+// -----------------------------------------------------------------------------
+// Public API.
+// -----------------------------------------------------------------------------
+
+yo_Tlsf* yo_make_tlsf_in_memory(u8* memory, usize size_bytes) {
+    yo_assert_not_null(memory);
+    yo_assert_msg((yo_cast(uptr, memory) % YO_TLSF_ALIGN_SIZE) == 0, "TLSF memory must be aligned to YO_TLSF_ALIGN_SIZE.");
+
+    usize control_size = yo_align_forward(yo_size_of(yo_Tlsf), YO_TLSF_ALIGN_SIZE);
+    if (yo_unlikely(size_bytes < control_size + YO_TLSF_POOL_OVERHEAD + YO_TLSF_BLOCK_SIZE_MIN)) {
+        yo_log_error_fmt("Memory block of %zu bytes is too small for a TLSF allocator.", size_bytes);
+        return NULL;
+    }
+
+    yo_Tlsf* tlsf              = yo_cast(yo_Tlsf*, memory);
+    tlsf->null_block           = yo_make_default(yo_TlsfBlock);
+    tlsf->null_block.next_free = &tlsf->null_block;
+    tlsf->null_block.prev_free = &tlsf->null_block;
+    tlsf->fl_bitmap            = 0;
+    tlsf->capacity             = 0;
+    tlsf->used_bytes           = 0;
+    tlsf->peak_used_bytes      = 0;
+    for (u32 fl = 0; fl < YO_TLSF_FL_INDEX_COUNT; ++fl) {
+        tlsf->sl_bitmap[fl] = 0;
+        for (u32 sl = 0; sl < YO_TLSF_SL_INDEX_COUNT; ++sl) {
+            tlsf->blocks[fl][sl] = &tlsf->null_block;
+        }
+    }
+
+    if (yo_unlikely(yo_tlsf_add_pool(tlsf, memory + control_size, size_bytes - control_size) != YO_STATUS_OK)) {
+        return NULL;
+    }
+    return tlsf;
+}
+
+yo_Tlsf* yo_make_tlsf(yo_Arena* arena, usize size_bytes) {
+    yo_assert_not_null(arena);
+
+    // Blocks are zeroed when handed out, there's no need to touch the whole memory right away.
+    u8* memory = yo_arena_alloc_uninit_align(arena, size_bytes, yo_cast(u32, yo_align_of(yo_Tlsf)));
+    if (yo_unlikely(memory == NULL)) {
+        yo_log_error_fmt("Unable to allocate %zu bytes for a TLSF allocator.", size_bytes);
+        return NULL;
+    }
+
+    return yo_make_tlsf_in_memory(memory, size_bytes);
+}
+
+yo_Status yo_tlsf_add_pool(yo_Tlsf* tlsf, u8* memory, usize size_bytes) {
+    yo_assert_not_null(tlsf);
+    yo_assert_not_null(memory);
+    yo_assert_msg((yo_cast(uptr, memory) % YO_TLSF_ALIGN_SIZE) == 0, "TLSF pools must be aligned to YO_TLSF_ALIGN_SIZE.");
+
+    if (yo_unlikely(size_bytes < YO_TLSF_POOL_OVERHEAD + YO_TLSF_BLOCK_SIZE_MIN)) {
+        yo_log_error_fmt("Pool of %zu bytes is too small for the TLSF allocator.", size_bytes);
+        return YO_STATUS_FAILED;
+    }
+
+    usize pool_bytes = (size_bytes - YO_TLSF_POOL_OVERHEAD) & ~(yo_cast(usize, YO_TLSF_ALIGN_SIZE) - 1);
+    if (yo_unlikely(pool_bytes >= YO_TLSF_BLOCK_SIZE_MAX)) {
+        yo_log_error_fmt("Pool of %zu bytes exceeds the maximum block size of the TLSF allocator.", size_bytes);
+        return YO_STATUS_FAILED;
+    }
+
+    // The `prev_physical` field of the first block lies outside of the pool, but it is never
+    // accessed since the block has no previous block.
+    yo_TlsfBlock* block = yo_impl_tlsf_offset_to_block(memory, -yo_cast(isize, YO_TLSF_BLOCK_OVERHEAD));
+    block->size         = pool_bytes;
+    yo_impl_tlsf_block_set_free(block, true);
+    yo_impl_tlsf_block_set_prev_free(block, false);
+    yo_impl_tlsf_block_insert(tlsf, block);
+
+    // Zero-sized sentinel block marking the end of the pool.
+    yo_TlsfBlock* sentinel = yo_impl_tlsf_block_link_next(block);
+    sentinel->size         = 0;
+    yo_impl_tlsf_block_set_free(sentinel, false);
+    yo_impl_tlsf_block_set_prev_free(sentinel, true);
+
+    tlsf->capacity += pool_bytes + YO_TLSF_BLOCK_OVERHEAD;
+    return YO_STATUS_OK;
+}
+
+u8* yo_tlsf_alloc_align(yo_Tlsf* tlsf, usize size_bytes, u32 alignment) {
+    yo_assert_not_null(tlsf);
+    yo_assert_fmt(yo_is_pow_of_two(alignment), "Expected alignment (%u) to be a power of two.", alignment);
+
+    if (yo_unlikely(size_bytes == 0)) {
+        return NULL;
+    }
+
+    usize adjusted_size = yo_impl_tlsf_adjust_request_size(size_bytes, YO_TLSF_ALIGN_SIZE);
+    if (alignment <= YO_TLSF_ALIGN_SIZE) {
+        yo_TlsfBlock* block = yo_impl_tlsf_block_locate_free(tlsf, adjusted_size);
+        if (yo_unlikely(block == NULL)) {
+            yo_impl_tlsf_report_out_of_memory(tlsf, size_bytes, alignment);
+            yo_impl_return_from_memory_error();
+        }
+        return yo_impl_tlsf_block_prepare_used(tlsf, block, adjusted_size);
+    }
+
+    // Over-allocate so that there is room for an aligned payload. If the payload isn't already
+    // aligned, the gap preceding it must fit a free block that is returned to the free lists.
+    usize         gap_minimum   = yo_size_of(yo_TlsfBlock);
+    usize         size_with_gap = yo_impl_tlsf_adjust_request_size(adjusted_size + alignment + gap_minimum, alignment);
+    yo_TlsfBlock* block         = yo_impl_tlsf_block_locate_free(tlsf, size_with_gap);
+    if (yo_unlikely(block == NULL)) {
+        yo_impl_tlsf_report_out_of_memory(tlsf, size_bytes, alignment);
+        yo_impl_return_from_memory_error();
+    }
+
+    uptr  ptr     = yo_cast(uptr, yo_impl_tlsf_block_to_ptr(block));
+    uptr  aligned = yo_align_forward(ptr, alignment);
+    usize gap     = aligned - ptr;
+    if ((gap != 0) && (gap < gap_minimum)) {
+        usize offset = yo_max_value(gap_minimum - gap, yo_cast(usize, alignment));
+        aligned      = yo_align_forward(aligned + offset, alignment);
+        gap          = aligned - ptr;
+    }
+
+    if (gap != 0) {
+        block = yo_impl_tlsf_block_trim_free_leading(tlsf, block, gap);
+    }
+    return yo_impl_tlsf_block_prepare_used(tlsf, block, adjusted_size);
+}
+
+u8* yo_tlsf_realloc_align(yo_Tlsf* tlsf, u8* block, usize new_size_bytes, u32 alignment) {
+    yo_assert_not_null(tlsf);
+
+    if (block == NULL) {
+        return yo_tlsf_alloc_align(tlsf, new_size_bytes, alignment);
+    }
+    if (new_size_bytes == 0) {
+        yo_tlsf_free(tlsf, block);
+        return NULL;
+    }
+
+    yo_TlsfBlock* header        = yo_impl_tlsf_block_from_ptr(block);
+    yo_TlsfBlock* next          = yo_impl_tlsf_block_next(header);
+    usize         current_size  = yo_impl_tlsf_block_size(header);
+    usize         combined_size = current_size + yo_impl_tlsf_block_size(next) + YO_TLSF_BLOCK_OVERHEAD;
+    usize         adjusted_size = yo_impl_tlsf_adjust_request_size(new_size_bytes, YO_TLSF_ALIGN_SIZE);
+    yo_assert_msg(!yo_impl_tlsf_block_is_free(header), "Reallocating a block that was already freed.");
+
+    bool is_aligned = (yo_cast(uptr, block) % alignment) == 0;
+    if (yo_unlikely(adjusted_size == 0)) {
+        yo_impl_tlsf_report_out_of_memory(tlsf, new_size_bytes, alignment);
+        yo_impl_return_from_memory_error();
+    }
+
+    // Move the block if it can't be grown in place.
+    if (!is_aligned || ((adjusted_size > current_size) && (!yo_impl_tlsf_block_is_free(next) || (adjusted_size > combined_size)))) {
+        u8* new_block = yo_tlsf_alloc_align(tlsf, new_size_bytes, alignment);
+        if (yo_likely(new_block != NULL)) {
+            yo_memory_copy(new_block, block, yo_min_value(current_size, new_size_bytes));
+            yo_tlsf_free(tlsf, block);
+        }
+        return new_block;
+    }
+
+    tlsf->used_bytes -= current_size + YO_TLSF_BLOCK_OVERHEAD;
+    if (adjusted_size > current_size) {
+        yo_impl_tlsf_block_merge_next(tlsf, header);
+        yo_impl_tlsf_block_mark_as_used(header);
+    }
+    yo_impl_tlsf_block_trim_used(tlsf, header, adjusted_size);
+
+    usize new_size = yo_impl_tlsf_block_size(header);
+    tlsf->used_bytes += new_size + YO_TLSF_BLOCK_OVERHEAD;
+    tlsf->peak_used_bytes = yo_max_value(tlsf->peak_used_bytes, tlsf->used_bytes);
+
+    if (new_size > current_size) {
+        yo_memory_set(block + current_size, new_size - current_size, 0);
+    }
+    return block;
+}
+
+void yo_tlsf_free(yo_Tlsf* tlsf, void* block) {
+    yo_assert_not_null(tlsf);
+    if (block == NULL) {
+        return;
+    }
+
+    yo_TlsfBlock* header = yo_impl_tlsf_block_from_ptr(block);
+    yo_assert_msg(!yo_impl_tlsf_block_is_free(header), "Block was already freed.");
+
+    tlsf->used_bytes -= yo_impl_tlsf_block_size(header) + YO_TLSF_BLOCK_OVERHEAD;
+
+    yo_impl_tlsf_block_mark_as_free(header);
+    header = yo_impl_tlsf_block_merge_prev(tlsf, header);
+    header = yo_impl_tlsf_block_merge_next(tlsf, header);
+    yo_impl_tlsf_block_insert(tlsf, header);
+}
+
+usize yo_tlsf_block_size(void const* block) {
+    return (block != NULL) ? yo_impl_tlsf_block_size(yo_impl_tlsf_block_from_ptr(block)) : 0;
+}
+
+yo_TlsfStats yo_tlsf_stats(yo_Tlsf const* tlsf) {
+    yo_assert_not_null(tlsf);
+
+    usize free_block_count = 0;
+    for (u32 fl = 0; fl < YO_TLSF_FL_INDEX_COUNT; ++fl) {
+        for (u32 sl = 0; sl < YO_TLSF_SL_INDEX_COUNT; ++sl) {
+            for (yo_TlsfBlock const* block = tlsf->blocks[fl][sl]; block != &tlsf->null_block; block = block->next_free) {
+                ++free_block_count;
+            }
+        }
+    }
+
+    // The largest free block lives in the highest non-empty class.
+    usize largest_free_block = 0;
+    if (tlsf->fl_bitmap != 0) {
+        u32 fl = yo_u64_msb_index(tlsf->fl_bitmap);
+        u32 sl = yo_u32_msb_index(tlsf->sl_bitmap[fl]);
+        for (yo_TlsfBlock const* block = tlsf->blocks[fl][sl]; block != &tlsf->null_block; block = block->next_free) {
+            largest_free_block = yo_max_value(largest_free_block, yo_impl_tlsf_block_size(block));
+        }
+    }
+
+    usize free_bytes = tlsf->capacity - tlsf->used_bytes;
+    return (yo_TlsfStats){
+        .capacity           = tlsf->capacity,
+        .used_bytes         = tlsf->used_bytes,
+        .peak_used_bytes    = tlsf->peak_used_bytes,
+        .free_bytes         = free_bytes,
+        .free_block_count   = free_block_count,
+        .largest_free_block = largest_free_block,
+        .fragmentation      = (free_bytes != 0) ? 1.0f - yo_cast(f32, largest_free_block + YO_TLSF_BLOCK_OVERHEAD) / yo_cast(f32, free_bytes) : 0.0f,
+    };
+}
+
+u8* yo_impl_tlsf_allocator_alloc(void* context, usize size_bytes, u32 alignment) {
+    return yo_tlsf_alloc_align(yo_cast(yo_Tlsf*, context), size_bytes, alignment);
+}
+
+u8* yo_impl_tlsf_allocator_resize(void* context, u8* block, usize current_size_bytes, usize new_size_bytes, u32 alignment) {
+    yo_discard_value(current_size_bytes);
+    return yo_tlsf_realloc_align(yo_cast(yo_Tlsf*, context), block, new_size_bytes, alignment);
+}
+
+void yo_impl_tlsf_allocator_free(void* context, void* block, usize size_bytes) {
+    yo_discard_value(size_bytes);
+    yo_tlsf_free(yo_cast(yo_Tlsf*, context), block);
+}
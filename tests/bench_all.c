@@ -0,0 +1,45 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Single compilation unit for the whole suite of benchmarks for the Yoneda library.
+/// File name: bench_all.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+// Source for the whole Yoneda library.
+#include "../src/yoneda_all.c"
+
+// Prevent benchmarks from defining a `main` function.
+#define YO_BENCH_NO_MAIN
+
+// -----------------------------------------------------------------------------
+// - Invoke all library benchmarks -
+// -----------------------------------------------------------------------------
+
+#include "bench_queue.c"
+#include "bench_slab.c"
+#include "bench_sort.c"
+
+int main(void) {
+    bench_queue();
+    bench_slab();
+    bench_sort();
+    return 0;
+}
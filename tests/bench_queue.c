@@ -0,0 +1,113 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Throughput benchmarks of the multi-producer/multi-consumer queue.
+/// File name: bench_queue.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_queue.h>
+#include <yoneda_thread.h>
+#include <yoneda_time.h>
+
+#include <stdio.h>
+
+#define YO_BENCH_QUEUE_MAX_THREAD_COUNT 64
+#define YO_BENCH_QUEUE_CAPACITY         1024
+#define YO_BENCH_QUEUE_ELEMENT_COUNT    (1U << 20)
+
+struct yo_BenchQueueTask {
+    yo_MpmcQueue* queue;
+    u32           element_count;
+};
+yo_type_alias(yo_BenchQueueTask, struct yo_BenchQueueTask);
+
+yo_internal void yo_bench_queue_produce(void* user_data) {
+    yo_BenchQueueTask* task = yo_cast(yo_BenchQueueTask*, user_data);
+    for (u64 idx = 0; idx < task->element_count; ++idx) {
+        yo_mpmc_queue_push(task->queue, &idx);
+    }
+}
+
+yo_internal void yo_bench_queue_consume(void* user_data) {
+    yo_BenchQueueTask* task = yo_cast(yo_BenchQueueTask*, user_data);
+    for (u32 idx = 0; idx < task->element_count; ++idx) {
+        u64 element = 0;
+        yo_mpmc_queue_pop(task->queue, &element);
+    }
+}
+
+/// Move a fixed number of elements through the queue with half of the threads pushing and the
+/// other half popping, and return the throughput in millions of elements per second.
+yo_internal f64 yo_bench_queue_run(yo_MpmcQueue* queue, u32 thread_count) {
+    u32 producer_count = yo_max_value(thread_count / 2, 1U);
+    u32 consumer_count = yo_max_value(thread_count - producer_count, 1U);
+    u32 element_count  = YO_BENCH_QUEUE_ELEMENT_COUNT / (producer_count * consumer_count) * (producer_count * consumer_count);
+
+    f64 start = yo_current_time_in_seconds();
+    if (thread_count == 1) {
+        // A single thread alternates between filling and draining the queue.
+        yo_BenchQueueTask task = {.queue = queue, .element_count = YO_BENCH_QUEUE_CAPACITY};
+        for (u32 offset = 0; offset < element_count; offset += YO_BENCH_QUEUE_CAPACITY) {
+            yo_bench_queue_produce(&task);
+            yo_bench_queue_consume(&task);
+        }
+    } else {
+        yo_Thread         threads[YO_BENCH_QUEUE_MAX_THREAD_COUNT];
+        yo_BenchQueueTask tasks[YO_BENCH_QUEUE_MAX_THREAD_COUNT];
+        for (u32 idx = 0; idx < thread_count; ++idx) {
+            bool is_producer = (idx < producer_count);
+
+            tasks[idx].queue         = queue;
+            tasks[idx].element_count = element_count / (is_producer ? producer_count : consumer_count);
+            yo_assert(yo_thread_spawn(&threads[idx], is_producer ? yo_bench_queue_produce : yo_bench_queue_consume, &tasks[idx]));
+        }
+        for (u32 idx = 0; idx < thread_count; ++idx) {
+            yo_thread_join(&threads[idx]);
+        }
+    }
+    f64 elapsed = yo_current_time_in_seconds() - start;
+
+    yo_assert(yo_mpmc_queue_count(queue) == 0);
+    return yo_cast(f64, element_count) / elapsed / 1e6;
+}
+
+yo_internal void bench_queue(void) {
+    yo_Arena     arena = yo_make_owned_arena(yo_mebibytes(1));
+    yo_MpmcQueue queue = yo_make_mpmc_queue(&arena, u64, YO_BENCH_QUEUE_CAPACITY);
+
+    printf("MPMC queue throughput, millions of u64 elements per second (%u hardware threads):\n", yo_thread_hardware_count());
+    printf("    %8s %10s\n", "threads", "Melem/s");
+    for (u32 thread_count = 1; thread_count <= YO_BENCH_QUEUE_MAX_THREAD_COUNT; thread_count *= 2) {
+        printf("    %8u %10.2f\n", thread_count, yo_bench_queue_run(&queue, thread_count));
+    }
+
+    yo_destroy_owned_arena(&arena);
+}
+
+#if !defined(YO_BENCH_NO_MAIN)
+int main(void) {
+    bench_queue();
+    return 0;
+}
+#endif
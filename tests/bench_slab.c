@@ -0,0 +1,132 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Benchmarks of the slab heap against the allocator of the C library.
+/// File name: bench_slab.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_core.h>
+#include <yoneda_slab.h>
+#include <yoneda_thread.h>
+#include <yoneda_time.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define YO_BENCH_SLAB_MAX_THREAD_COUNT 64
+#define YO_BENCH_SLAB_BATCH_COUNT      4096
+#define YO_BENCH_SLAB_ROUND_COUNT      256
+
+struct yo_BenchSlabTask {
+    yo_SlabHeap* heap;
+    u64          seed;
+    u8*          blocks[YO_BENCH_SLAB_BATCH_COUNT];
+};
+yo_type_alias(yo_BenchSlabTask, struct yo_BenchSlabTask);
+
+yo_internal u64 yo_bench_slab_random(u64* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/// Allocate batches of small objects of mixed sizes and free them in a scrambled order, which is
+/// the typical workload of allocation-heavy programs. Uses `malloc` if the task has no heap.
+yo_internal void yo_bench_slab_churn(void* user_data) {
+    yo_BenchSlabTask* task = yo_cast(yo_BenchSlabTask*, user_data);
+
+    for (u32 round = 0; round < YO_BENCH_SLAB_ROUND_COUNT; ++round) {
+        for (u32 idx = 0; idx < YO_BENCH_SLAB_BATCH_COUNT; ++idx) {
+            usize size_bytes     = 16 + yo_bench_slab_random(&task->seed) % 1024;
+            task->blocks[idx]    = (task->heap != NULL) ? yo_slab_alloc_align(task->heap, size_bytes, 16) : yo_cast(u8*, malloc(size_bytes));
+            task->blocks[idx][0] = yo_cast(u8, idx);
+        }
+
+        u32 stride = 2 * yo_cast(u32, yo_bench_slab_random(&task->seed) % (YO_BENCH_SLAB_BATCH_COUNT / 2)) + 1;
+        for (u32 idx = 0; idx < YO_BENCH_SLAB_BATCH_COUNT; ++idx) {
+            u8* block = task->blocks[(idx * stride) % YO_BENCH_SLAB_BATCH_COUNT];
+            if (task->heap != NULL) {
+                yo_slab_free(task->heap, block);
+            } else {
+                free(block);
+            }
+        }
+    }
+
+    if (task->heap != NULL) {
+        yo_slab_thread_flush();
+    }
+}
+
+/// Run the churn workload in `thread_count` threads and return the average time per allocation
+/// and free pair, in nanoseconds.
+yo_internal f64 yo_bench_slab_run(yo_SlabHeap* heap, u32 thread_count) {
+    yo_Thread         threads[YO_BENCH_SLAB_MAX_THREAD_COUNT];
+    bool              spawned[YO_BENCH_SLAB_MAX_THREAD_COUNT] = {0};
+    yo_BenchSlabTask* tasks                                   = yo_cast(yo_BenchSlabTask*, calloc(thread_count, yo_size_of(yo_BenchSlabTask)));
+
+    f64 start = yo_current_time_in_seconds();
+    for (u32 idx = 0; idx < thread_count; ++idx) {
+        tasks[idx].heap = heap;
+        tasks[idx].seed = 0x9E3779B97F4A7C15ULL * (idx + 1);
+        if (idx != 0) {
+            spawned[idx] = yo_thread_spawn(&threads[idx], yo_bench_slab_churn, &tasks[idx]);
+        }
+    }
+    for (u32 idx = 0; idx < thread_count; ++idx) {
+        if (!spawned[idx]) {
+            yo_bench_slab_churn(&tasks[idx]);
+        }
+    }
+    for (u32 idx = 1; idx < thread_count; ++idx) {
+        if (spawned[idx]) {
+            yo_thread_join(&threads[idx]);
+        }
+    }
+    f64 elapsed = yo_current_time_in_seconds() - start;
+
+    free(tasks);
+    f64 pair_count = yo_cast(f64, thread_count) * YO_BENCH_SLAB_ROUND_COUNT * YO_BENCH_SLAB_BATCH_COUNT;
+    return 1e9 * elapsed / pair_count;
+}
+
+yo_internal void bench_slab(void) {
+    u32 max_thread_count = yo_min_value(2 * yo_thread_hardware_count(), YO_BENCH_SLAB_MAX_THREAD_COUNT);
+
+    printf("Slab heap vs. malloc, ns per alloc/free pair of 16-1040 bytes:\n");
+    printf("    %8s %10s %10s\n", "threads", "slab", "malloc");
+    for (u32 thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        yo_SlabHeap heap    = yo_make_slab_heap(yo_gibibytes(4ULL));
+        f64         slab_ns = yo_bench_slab_run(&heap, thread_count);
+        f64         libc_ns = yo_bench_slab_run(NULL, thread_count);
+        yo_destroy_slab_heap(&heap);
+
+        printf("    %8u %10.2f %10.2f\n", thread_count, slab_ns, libc_ns);
+    }
+}
+
+#if !defined(YO_BENCH_NO_MAIN)
+int main(void) {
+    bench_slab();
+    return 0;
+}
+#endif
@@ -0,0 +1,115 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Benchmarks of the sorting algorithms against the `qsort` of the C library.
+/// File name: bench_sort.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_sort.h>
+#include <yoneda_thread.h>
+#include <yoneda_time.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define YO_BENCH_SORT_ELEMENT_COUNT 2000000
+#define YO_BENCH_SORT_ROUND_COUNT   5
+
+#define yo_bench_sort_u64_is_less(lhs, rhs) (*(lhs) < *(rhs))
+yo_define_sort(yo_bench_sort_u64, u64, yo_bench_sort_u64_is_less)
+yo_define_parallel_sort(yo_bench_sort_u64, u64, yo_bench_sort_u64_is_less)
+
+yo_internal int yo_bench_sort_u64_compare(void const* lhs, void const* rhs) {
+    u64 lhs_value = *yo_cast(u64 const*, lhs);
+    u64 rhs_value = *yo_cast(u64 const*, rhs);
+    return (lhs_value > rhs_value) - (lhs_value < rhs_value);
+}
+
+yo_internal void yo_bench_sort_fill(u64* values, usize count, u64 seed) {
+    for (usize idx = 0; idx < count; ++idx) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        values[idx] = seed;
+    }
+}
+
+yo_internal void yo_bench_sort_check(u64 const* values, usize count) {
+    for (usize idx = 1; idx < count; ++idx) {
+        if (values[idx] < values[idx - 1]) {
+            printf("    unsorted output at index %zu\n", idx);
+            return;
+        }
+    }
+}
+
+/// Sort freshly shuffled values with each algorithm and return the average time per sort, in
+/// milliseconds. The algorithm is 0 for `qsort`, 1 for the unstable sort, 2 for the stable sort,
+/// 3 for the radix sort and 4 for the parallel sort with `thread_count` threads.
+yo_internal f64 yo_bench_sort_run(yo_Arena* arena, u64* values, usize count, u32 algorithm, u32 thread_count) {
+    f64 elapsed = 0.0;
+    for (u32 round = 0; round < YO_BENCH_SORT_ROUND_COUNT; ++round) {
+        yo_bench_sort_fill(values, count, 0x9E3779B97F4A7C15ULL * (round + 1));
+
+        f64 start = yo_current_time_in_seconds();
+        switch (algorithm) {
+            case 0:  qsort(values, count, yo_size_of(u64), yo_bench_sort_u64_compare); break;
+            case 1:  yo_bench_sort_u64_sort(values, count); break;
+            case 2:  yo_bench_sort_u64_stable_sort(values, count, arena); break;
+            case 3:  yo_radix_sort_u64(values, count); break;
+            default: yo_bench_sort_u64_parallel_sort(values, count, thread_count, arena); break;
+        }
+        elapsed += yo_current_time_in_seconds() - start;
+
+        yo_bench_sort_check(values, count);
+    }
+    return 1e3 * elapsed / YO_BENCH_SORT_ROUND_COUNT;
+}
+
+yo_internal void bench_sort(void) {
+    usize    count  = YO_BENCH_SORT_ELEMENT_COUNT;
+    yo_Arena arena  = yo_make_owned_arena(3 * count * yo_size_of(u64));
+    u64*     values = yo_arena_alloc_uninit(&arena, u64, count);
+
+    char const* names[] = {"qsort", "sort", "stable_sort", "radix_sort"};
+    printf("Sorting %zu random u64 values, ms per sort:\n", count);
+    for (u32 algorithm = 0; algorithm < yo_count_of(names); ++algorithm) {
+        printf("    %12s %10.2f\n", names[algorithm], yo_bench_sort_run(&arena, values, count, algorithm, 1));
+    }
+
+    u32 max_thread_count = yo_min_value(2 * yo_thread_hardware_count(), YO_PARALLEL_SORT_MAX_THREAD_COUNT);
+    printf("Parallel sort of the same values, ms per sort (%u hardware threads):\n", yo_thread_hardware_count());
+    printf("    %8s %10s\n", "threads", "ms");
+    for (u32 thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        printf("    %8u %10.2f\n", thread_count, yo_bench_sort_run(&arena, values, count, 4, thread_count));
+    }
+
+    yo_destroy_owned_arena(&arena);
+}
+
+#if !defined(YO_BENCH_NO_MAIN)
+int main(void) {
+    bench_sort();
+    return 0;
+}
+#endif
@@ -34,8 +34,26 @@
 // -----------------------------------------------------------------------------
 
 #include "test_memory.c"
+#include "test_thread.c"
+#include "test_queue.c"
+#include "test_map.c"
+#include "test_hash.c"
+#include "test_interner.c"
+#include "test_sort.c"
+#include "test_bitset.c"
+#include "test_slot_map.c"
+#include "test_soa.c"
 
 int main(void) {
     test_memory();
+    test_thread();
+    test_queue();
+    test_map();
+    test_hash();
+    test_interner();
+    test_sort();
+    test_bitset();
+    test_slot_map();
+    test_soa();
     return 0;
 }
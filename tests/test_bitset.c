@@ -0,0 +1,89 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding bitsets.
+/// File name: test_bitset.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_bitset.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void bitset_combines_and_searches_bits(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    // A bit count that isn't a multiple of the word size exercises the cleared tail bits.
+    usize     bit_count = 1000;
+    yo_Bitset evens     = yo_make_bitset(&arena, bit_count);
+    yo_Bitset thirds    = yo_make_bitset(&arena, bit_count);
+    for (usize idx = 0; idx < bit_count; ++idx) {
+        if (idx % 2 == 0) {
+            yo_bitset_set(&evens, idx);
+        }
+        if (idx % 3 == 0) {
+            yo_bitset_set(&thirds, idx);
+        }
+    }
+    yo_assert((yo_bitset_count(&evens) == 500) && (yo_bitset_count(&thirds) == 334));
+    yo_assert((yo_bitset_rank(&evens, 0) == 0) && (yo_bitset_rank(&evens, 129) == 65) && (yo_bitset_rank(&evens, bit_count) == 500));
+
+    yo_Bitset sixths = yo_make_bitset(&arena, bit_count);
+    yo_bitset_or(&sixths, &evens);
+    yo_bitset_and(&sixths, &thirds);
+    usize expected = 0;
+    yo_bitset_for_each_set(idx, &sixths) {
+        yo_assert(idx == expected);
+        expected += 6;
+    }
+    yo_assert(expected == 1002);
+
+    // Evens that aren't multiples of three, and the symmetric difference of both sets.
+    yo_bitset_and_not(&evens, &thirds);
+    yo_assert((yo_bitset_count(&evens) == 333) && !yo_bitset_test(&evens, 6) && yo_bitset_test(&evens, 8));
+    yo_bitset_xor(&evens, &sixths);
+    yo_assert(yo_bitset_count(&evens) == 500);
+
+    yo_Bitset all = yo_make_bitset(&arena, bit_count);
+    yo_assert(yo_bitset_find_next_set(&all, 0) == bit_count);
+    yo_bitset_set_all(&all);
+    yo_assert((yo_bitset_count(&all) == bit_count) && (yo_bitset_find_next_unset(&all, 0) == bit_count));
+    yo_bitset_clear(&all, 700);
+    yo_assert((yo_bitset_find_next_unset(&all, 3) == 700) && (yo_bitset_find_next_set(&all, 700) == 701));
+    yo_bitset_clear_all(&all);
+    yo_assert((yo_bitset_count(&all) == 0) && (yo_bitset_find_next_unset(&all, 999) == 999));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_bitset(void) {
+    bitset_combines_and_searches_bits();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_bitset();
+    return 0;
+}
+#endif
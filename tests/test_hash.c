@@ -0,0 +1,77 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the hash functions.
+/// File name: test_hash.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_hash.h>
+#include <yoneda_memory.h>
+#include <yoneda_string.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void hash_streams_match_one_shot(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(8));
+
+    // Cover short inputs, long inputs, and inputs spanning multiple blocks of stripes.
+    usize data_size = 3000;
+    u8*   data      = yo_arena_alloc(&arena, u8, data_size);
+    for (usize idx = 0; idx < data_size; ++idx) {
+        data[idx] = yo_cast(u8, yo_hash_u32(yo_cast(u32, idx)));
+    }
+
+    usize sizes[] = {0, 3, 16, 17, 256, 257, 1024, 1089, 3000};
+    for (usize idx = 0; idx < yo_count_of(sizes); ++idx) {
+        usize      size     = sizes[idx];
+        u64        hash     = yo_hash_bytes(data, size, 7);
+        yo_Hash128 hash_128 = yo_hash128_bytes(data, size, 7);
+        yo_assert((hash == hash_128.low) && (hash != yo_hash_bytes(data, size, 8)));
+
+        // Feed the stream in uneven pieces.
+        yo_HashState state = yo_make_hash_state(7);
+        for (usize offset = 0, piece = 1; offset < size; offset += piece, piece = piece * 3 + 1) {
+            yo_hash_state_update(&state, data + offset, yo_min_value(piece, size - offset));
+        }
+        yo_Hash128 digest_128 = yo_hash_state_digest128(&state);
+        yo_assert((yo_hash_state_digest(&state) == hash) && (digest_128.low == hash_128.low) && (digest_128.high == hash_128.high));
+    }
+
+    yo_String str = yo_make_string("yoneda");
+    yo_assert(yo_hash_string(str, 0) == yo_hash_bytes("yoneda", 6, 0));
+    yo_assert(yo_hash_u64(1) != yo_hash_u64(2));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_hash(void) {
+    hash_streams_match_one_shot();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_hash();
+    return 0;
+}
+#endif
@@ -0,0 +1,107 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the string interner.
+/// File name: test_interner.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_interner.h>
+#include <yoneda_memory.h>
+#include <yoneda_string.h>
+
+#include <stdio.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void string_interner_dedups_strings(void) {
+    yo_Arena    arena    = yo_make_owned_arena(yo_kibibytes(16));
+    yo_Interner interner = yo_make_interner(&arena, 4, yo_mebibytes(1));
+
+    // Intern from a scratch buffer so that the interned copies can't alias the input.
+    char name[16];
+    for (u32 idx = 0; idx < 64; ++idx) {
+        i32 length = snprintf(name, sizeof(name), "symbol_%u", idx);
+        yo_assert(yo_interner_intern(&interner, (yo_String){.buf = name, .length = yo_cast(usize, length)}) == idx);
+    }
+    yo_assert(yo_interner_count(&interner) == 64);
+
+    yo_String str = yo_make_string("symbol_42");
+    yo_assert((yo_interner_intern(&interner, str) == 42) && (yo_interner_count(&interner) == 64));
+    yo_assert(yo_string_equal(yo_interner_string(&interner, 42), str));
+    yo_assert(yo_interner_string(&interner, 42).buf != str.buf);
+    yo_assert(yo_interner_string(&interner, 7).buf[8] == 0);
+
+    yo_String empty    = yo_make_string("");
+    u32       empty_id = yo_interner_intern(&interner, empty);
+    yo_assert((empty_id == 64) && (yo_interner_find(&interner, empty) == empty_id));
+
+    // Frozen interners only resolve strings that were already interned.
+    yo_interner_freeze(&interner);
+    yo_String unknown = yo_make_string("unknown");
+    yo_assert(yo_interner_intern(&interner, unknown) == YO_INTERNER_INVALID_ID);
+    yo_assert((yo_interner_find(&interner, unknown) == YO_INTERNER_INVALID_ID) && (yo_interner_intern(&interner, str) == 42));
+
+    yo_destroy_interner(&interner);
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void string_interner_packs_strings_in_its_pool(void) {
+    yo_Arena    arena    = yo_make_owned_arena(yo_kibibytes(16));
+    yo_Interner interner = yo_make_interner(&arena, 64, yo_kibibytes(64));
+
+    // Within the capacity, interning only takes memory from the pool, where the copies are packed.
+    usize     offset = arena.offset;
+    yo_String first  = yo_interner_string(&interner, yo_interner_intern(&interner, yo_make_string("alpha")));
+    yo_String second = yo_interner_string(&interner, yo_interner_intern(&interner, yo_make_string("beta")));
+    yo_assert((second.buf == first.buf + first.length + 1) && (first.buf[first.length] == 0));
+    for (u32 idx = 0; idx < 62; ++idx) {
+        char name[16];
+        i32  length = snprintf(name, sizeof(name), "name_%u", idx);
+        yo_assert(yo_interner_intern(&interner, (yo_String){.buf = name, .length = yo_cast(usize, length)}) == idx + 2);
+    }
+    yo_assert(arena.offset == offset);
+
+    // Past the capacity, the strings table is the last allocation of the arena and grows in place.
+    yo_String* strings = interner.strings;
+    yo_assert(yo_interner_intern(&interner, yo_make_string("gamma")) == 64);
+    yo_assert((interner.strings == strings) && yo_string_equal(yo_interner_string(&interner, 0), yo_make_string("alpha")));
+
+    yo_destroy_interner(&interner);
+    yo_assert(yo_interner_intern(&interner, yo_make_string("delta")) == YO_INTERNER_INVALID_ID);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_interner(void) {
+    string_interner_dedups_strings();
+    string_interner_packs_strings_in_its_pool();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_interner();
+    return 0;
+}
+#endif
@@ -0,0 +1,92 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the hash map.
+/// File name: test_map.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_map.h>
+#include <yoneda_memory.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_define_map(yo_TestU64Map, u64, u32)
+
+yo_internal void map_grows_and_removes_entries(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(256));
+
+    yo_TestU64Map map = yo_TestU64Map_make(&arena, 4);
+    yo_assert(map.raw.capacity == YO_MAP_GROUP_WIDTH);
+
+    for (u64 key = 0; key < 1000; ++key) {
+        yo_assert(yo_TestU64Map_insert(&map, key * 7919, yo_cast(u32, key)) != NULL);
+    }
+    yo_assert((map.raw.count == 1000) && (map.raw.capacity == 2048));
+    yo_assert((*yo_TestU64Map_get(&map, 999 * 7919) == 999) && (yo_TestU64Map_get(&map, 1) == NULL));
+
+    // Overwriting keeps a single entry.
+    *yo_TestU64Map_insert(&map, 0, 0) = 42;
+    yo_assert((map.raw.count == 1000) && (*yo_TestU64Map_get(&map, 0) == 42));
+
+    for (u64 key = 0; key < 1000; key += 2) {
+        yo_assert(yo_TestU64Map_remove(&map, key * 7919));
+    }
+    yo_assert(!yo_TestU64Map_remove(&map, 0) && (map.raw.count == 500));
+
+    usize visited = 0;
+    yo_map_for_each_slot(idx, &map.raw) {
+        yo_assert((*yo_map_key_at(&map.raw, u64, idx) / 7919) % 2 == 1);
+        yo_assert(*yo_map_value_at(&map.raw, u32, idx) == *yo_map_key_at(&map.raw, u64, idx) / 7919);
+        ++visited;
+    }
+    yo_assert(visited == 500);
+
+    // Allocator-backed maps release their previous tables as they grow.
+    yo_Allocator         arena_allocator = yo_arena_allocator(&arena);
+    yo_TrackingAllocator tracker         = yo_make_tracking_allocator(&arena_allocator);
+    yo_Allocator         allocator       = yo_tracking_allocator(&tracker);
+
+    yo_Map tracked_map = yo_make_map_with_allocator(&allocator, u32, u32, 0);
+    for (u32 key = 0; key < 100; ++key) {
+        yo_discard_value(yo_map_insert(&tracked_map, &key, &key));
+    }
+    u32 key = 77;
+    yo_assert((*yo_cast(u32*, yo_map_get(&tracked_map, &key)) == 77) && (tracker.free_count == tracker.alloc_count - 1));
+
+    yo_destroy_map(&tracked_map);
+    yo_assert(tracker.live_bytes == 0);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_map(void) {
+    map_grows_and_removes_entries();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_map();
+    return 0;
+}
+#endif
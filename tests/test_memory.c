@@ -24,7 +24,16 @@
 /// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
 
 #include <yoneda_assert.h>
+#include <yoneda_concurrent_arena.h>
 #include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_pool.h>
+#include <yoneda_slab.h>
+#include <yoneda_stack.h>
+#include <yoneda_streams.h>
+#include <yoneda_string.h>
+#include <yoneda_thread.h>
+#include <yoneda_tlsf.h>
 
 #include <stdio.h>
 
@@ -68,9 +77,790 @@ yo_internal void offset_check(void) {
     test_passed();
 }
 
+yo_internal void reserved_arena_commits_on_demand(void) {
+    usize     page_size = yo_memory_page_size();
+    yo_Arena  arena     = yo_make_reserved_arena(yo_gibibytes(1ULL), 4 * page_size);
+    u8* const base      = arena.buf;
+    yo_assert(base != NULL);
+    yo_assert(arena.committed == 0);
+
+    // The first allocation commits a single chunk.
+    u8* first = yo_arena_alloc(&arena, u8, 16);
+    yo_assert(first == base);
+    yo_assert(arena.committed == 4 * page_size);
+
+    // Crossing the commit boundary commits enough chunks without moving the memory.
+    u8* second = yo_arena_alloc(&arena, u8, 9 * page_size);
+    yo_assert(arena.buf == base);
+    yo_assert(arena.committed == 12 * page_size);
+    second[9 * page_size - 1] = 0xAB;
+    yo_assert(first[0] == 0);
+
+    // Growing the last allocation in-place also commits memory.
+    u8* grown = yo_arena_realloc(&arena, u8, second, 9 * page_size, 20 * page_size);
+    yo_assert(grown == second);
+    yo_assert(arena.committed == 24 * page_size);
+    grown[20 * page_size - 1] = 0xCD;
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void arena_zeroes_only_touched_memory(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(64));
+    yo_assert(arena.buf != NULL);
+    yo_assert(arena.flags & YO_ARENA_FLAG_FRESH_MEMORY);
+
+    u8* block = yo_arena_alloc_uninit(&arena, u8, 256);
+    yo_assert(arena.high_water_offset == 256);
+    yo_memory_set(block, 256, 0xFF);
+
+    // Reused memory still has to be zeroed on allocation.
+    yo_arena_clear(&arena);
+    u32* values = yo_arena_alloc(&arena, u32, 128);
+    yo_assert(yo_cast(u8*, values) == block);
+    yo_assert(arena.high_water_offset == 512);
+    for (usize idx = 0; idx < 128; ++idx) {
+        yo_assert(values[idx] == 0);
+    }
+
+    // Growing the last block in-place zeroes the new tail.
+    yo_memory_set(yo_cast(u8*, values), 512, 0xFF);
+    yo_arena_clear(&arena);
+    u8* small = yo_arena_alloc(&arena, u8, 16);
+    small     = yo_arena_realloc(&arena, u8, small, 16, 1024);
+    for (usize idx = 0; idx < 1024; ++idx) {
+        yo_assert(small[idx] == 0);
+    }
+    yo_assert(arena.high_water_offset == 1024);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void chained_arena_spills_and_restores(void) {
+    yo_Arena  arena = yo_make_chained_arena(yo_kibibytes(4));
+    u8* const base  = arena.buf;
+    yo_assert(base != NULL);
+
+    u32* first = yo_arena_alloc(&arena, u32, 512);
+    first[511] = 42;
+
+    yo_ArenaCheckpoint checkpoint = yo_make_arena_checkpoint(&arena);
+
+    // Doesn't fit the first block, spills into a new one.
+    u8* second = yo_arena_alloc(&arena, u8, yo_kibibytes(3));
+    yo_assert(second != NULL);
+    yo_assert(arena.buf != base);
+    yo_assert(arena.capacity >= yo_kibibytes(8));
+
+    // Blocks from previous links of the chain can still be reallocated.
+    u32* first_grown = yo_arena_realloc(&arena, u32, first, 512, 1024);
+    yo_assert(first_grown[511] == 42);
+    yo_assert(first_grown[1023] == 0);
+
+    // Outliers larger than twice the current block get a block of their own.
+    u8* large                    = yo_arena_alloc(&arena, u8, yo_kibibytes(128));
+    large[yo_kibibytes(128) - 1] = 1;
+    yo_assert(arena.capacity >= yo_kibibytes(128));
+
+    yo_arena_checkpoint_restore(checkpoint);
+    yo_assert(arena.buf == base);
+    yo_assert(arena.offset == 512 * yo_size_of(u32));
+    yo_assert(!(arena.flags & YO_ARENA_FLAG_CHAIN_BLOCK));
+    yo_assert(first[511] == 42);
+
+    yo_discard_value(yo_arena_alloc(&arena, u8, yo_kibibytes(16)));
+    yo_arena_clear(&arena);
+    yo_assert(arena.buf == base);
+    yo_assert(arena.offset == 0);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void huge_page_arenas_report_page_size(void) {
+    usize page_size      = yo_memory_page_size();
+    usize huge_page_size = yo_memory_huge_page_size();
+    yo_assert(yo_is_pow_of_two(huge_page_size) && (huge_page_size >= page_size));
+
+    // The reported page size may fall back to regular pages, but the block is always aligned to it.
+    yo_Arena arena = yo_make_owned_arena_with_flags(yo_mebibytes(3), YO_MEMORY_FLAG_HUGE_PAGES);
+    yo_assert(arena.buf != NULL);
+    yo_assert((arena.page_size == page_size) || (arena.page_size == huge_page_size));
+    yo_assert(yo_align_forward(yo_cast(uptr, arena.buf), huge_page_size) == yo_cast(uptr, arena.buf));
+    yo_assert(arena.capacity == yo_align_forward(yo_mebibytes(3), huge_page_size));
+
+    u8* block                 = yo_arena_alloc(&arena, u8, arena.capacity);
+    block[0]                  = 1;
+    block[arena.capacity - 1] = 1;
+    yo_destroy_owned_arena(&arena);
+
+    yo_Arena reserved = yo_make_reserved_arena_with_flags(yo_gibibytes(1ULL), page_size, YO_MEMORY_FLAG_HUGE_PAGES);
+    yo_assert(reserved.buf != NULL);
+    yo_assert(reserved.commit_chunk_size >= reserved.page_size);
+    u8* reserved_block = yo_arena_alloc(&reserved, u8, 16);
+    reserved_block[15] = 1;
+    yo_assert(reserved.committed == reserved.commit_chunk_size);
+    yo_destroy_owned_arena(&reserved);
+
+    test_passed();
+}
+
+yo_internal void arena_trim_releases_surplus_with_hysteresis(void) {
+    usize page_size = yo_memory_page_size();
+
+    yo_Arena arena = yo_make_owned_arena(256 * page_size);
+    yo_arena_set_trim_policy(
+        &arena,
+        (yo_ArenaTrimPolicy){.retain_bytes = 16 * page_size, .threshold_bytes = 32 * page_size, .delay = 2});
+
+    // Steady usage never releases memory, even across many clears.
+    for (u32 frame = 0; frame < 4; ++frame) {
+        u8* block = yo_arena_alloc(&arena, u8, 200 * page_size);
+        yo_memory_set(block, 200 * page_size, 0xFF);
+        yo_arena_clear(&arena);
+    }
+    yo_assert(arena.high_water_offset == 200 * page_size);
+
+    // After a spike, the surplus is released once it persists for `delay` clears.
+    yo_discard_value(yo_arena_alloc(&arena, u8, 8 * page_size));
+    yo_arena_clear(&arena);
+    yo_assert(arena.high_water_offset == 200 * page_size);
+    yo_discard_value(yo_arena_alloc(&arena, u8, 20 * page_size));
+    yo_arena_clear(&arena);
+    yo_assert(arena.high_water_offset == 20 * page_size);
+
+    // Released pages read back as zero.
+    u8* block = yo_arena_alloc_uninit(&arena, u8, 200 * page_size);
+    yo_assert(block[100 * page_size] == 0);
+    yo_destroy_owned_arena(&arena);
+
+    // Reserved arenas decommit the surplus chunks.
+    yo_Arena reserved = yo_make_reserved_arena(yo_gibibytes(1ULL), 16 * page_size);
+    yo_arena_set_trim_policy(&reserved, (yo_ArenaTrimPolicy){.threshold_bytes = 1, .delay = 1});
+    yo_ArenaCheckpoint checkpoint = yo_make_arena_checkpoint(&reserved);
+    yo_discard_value(yo_arena_alloc(&reserved, u8, 100 * page_size));
+    yo_assert(reserved.committed == 112 * page_size);
+    yo_arena_checkpoint_restore(checkpoint);
+    yo_assert(reserved.committed == 112 * page_size);  // Memory used by the last cycle is kept.
+
+    checkpoint = yo_make_arena_checkpoint(&reserved);
+    yo_discard_value(yo_arena_alloc(&reserved, u8, 4 * page_size));
+    yo_arena_checkpoint_restore(checkpoint);
+    yo_assert(reserved.committed == 16 * page_size);
+    yo_destroy_owned_arena(&reserved);
+
+    // Lazy trims keep reserved memory committed and never release the same range twice.
+    yo_Arena lazy = yo_make_reserved_arena(yo_gibibytes(1ULL), 16 * page_size);
+    yo_arena_set_trim_policy(&lazy, (yo_ArenaTrimPolicy){.threshold_bytes = 1, .delay = 1, .lazy = true});
+    checkpoint = yo_make_arena_checkpoint(&lazy);
+    yo_discard_value(yo_arena_alloc(&lazy, u8, 100 * page_size));
+    yo_arena_checkpoint_restore(checkpoint);
+    yo_arena_clear(&lazy);
+    yo_assert(lazy.committed == 112 * page_size);
+    yo_assert(lazy.trim_resident_offset == 0);
+    yo_arena_clear(&lazy);
+    yo_assert(lazy.trim_streak == 0);
+
+    // Touching the released range makes it eligible for a new release.
+    yo_discard_value(yo_arena_alloc(&lazy, u8, 40 * page_size));
+    yo_arena_clear(&lazy);
+    yo_assert(lazy.trim_resident_offset == 48 * page_size);
+    yo_arena_clear(&lazy);
+    yo_assert(lazy.trim_resident_offset == 0);
+    yo_destroy_owned_arena(&lazy);
+
+    test_passed();
+}
+
+yo_internal void pool_recycles_slots(void) {
+    struct particle {
+        f32 position[3];
+        u8  kind;
+    };
+
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(64));
+    yo_Pool  pool  = yo_make_pool(&arena, struct particle, 4);
+    yo_assert(pool.slot_size == 16);
+
+    struct particle* a = yo_pool_alloc(&pool, struct particle);
+    struct particle* b = yo_pool_alloc(&pool, struct particle);
+    struct particle* c = yo_pool_alloc(&pool, struct particle);
+    struct particle* d = yo_pool_alloc(&pool, struct particle);
+    yo_assert((a != NULL) && (b != NULL) && (c != NULL) && (d != NULL));
+    yo_assert(yo_pool_slot_index(&pool, c) == 2);
+    yo_assert(yo_pool_at(&pool, struct particle, 3) == d);
+    b->kind = 7;
+
+    // Freed slots are recycled in LIFO order and handed out zeroed.
+    yo_pool_free(&pool, b);
+    yo_pool_free(&pool, d);
+    yo_assert(yo_pool_alloc(&pool, struct particle) == d);
+    struct particle* recycled = yo_pool_alloc(&pool, struct particle);
+    yo_assert((recycled == b) && (recycled->kind == 0));
+
+    yo_PoolStats stats = yo_pool_stats(&pool);
+    yo_assert((stats.live_count == 4) && (stats.peak_count == 4) && (stats.free_count == 0));
+
+    yo_pool_clear(&pool);
+    yo_assert(yo_pool_alloc(&pool, struct particle) == a);
+    yo_assert(yo_pool_stats(&pool).live_count == 1);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void stack_pops_in_lifo_order(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+    yo_Stack stack = yo_make_stack(&arena, yo_kibibytes(2));
+
+    u8*  bytes  = yo_stack_push(&stack, u8, 3);
+    f64* values = yo_stack_push(&stack, f64, 4);
+    yo_assert(yo_align_forward(yo_cast(uptr, values), yo_align_of(f64)) == yo_cast(uptr, values));
+    yo_assert(yo_stack_block_size(values) == 4 * yo_size_of(f64));
+
+    // Popping out of order is refused.
+    yo_assert(yo_stack_pop(&stack, bytes) == YO_STATUS_FAILED);
+    yo_assert(yo_stack_top(&stack) == yo_cast(u8*, values));
+
+    // The top block is resized in-place, other blocks are moved to the top.
+    values[3] = 3.0;
+    yo_assert(yo_stack_realloc(&stack, f64, values, 8) == values);
+    yo_assert((values[3] == 3.0) && (values[7] == 0.0));
+    bytes[2]       = 2;
+    u8* moved_byte = yo_stack_realloc(&stack, u8, bytes, 4);
+    yo_assert((moved_byte != bytes) && (moved_byte[2] == 2));
+
+    // A top block that doesn't satisfy a stricter alignment is moved as well.
+    u8* aligned_byte = yo_stack_realloc_align(&stack, moved_byte, 8, 256);
+    yo_assert((yo_cast(uptr, aligned_byte) % 256 == 0) && (aligned_byte[2] == 2));
+    yo_assert(yo_stack_realloc_align(&stack, aligned_byte, 16, 256) == aligned_byte);
+    yo_assert(yo_stack_pop(&stack, aligned_byte) == YO_STATUS_OK);
+
+    yo_assert(yo_stack_pop(&stack, moved_byte) == YO_STATUS_OK);
+    yo_assert(yo_stack_pop(&stack, values) == YO_STATUS_OK);
+    yo_assert(yo_stack_pop(&stack, bytes) == YO_STATUS_OK);
+    yo_assert((stack.offset == 0) && (yo_stack_top(&stack) == NULL));
+
+    // Scopes pop all of their blocks at once.
+    u32* outer = yo_stack_push(&stack, u32, 1);
+    yo_stack_scoped(&stack) {
+        yo_discard_value(yo_stack_push(&stack, u32, 16));
+        yo_discard_value(yo_stack_push(&stack, u64, 16));
+    }
+    yo_assert(yo_stack_top(&stack) == yo_cast(u8*, outer));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void tlsf_frees_and_coalesces_blocks(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_mebibytes(1));
+    yo_Tlsf* tlsf  = yo_make_tlsf(&arena, yo_kibibytes(512));
+    yo_assert(tlsf != NULL);
+
+    yo_TlsfStats initial = yo_tlsf_stats(tlsf);
+    yo_assert((initial.free_block_count == 1) && (initial.fragmentation == 0.0f));
+
+    u8*  a = yo_tlsf_alloc(tlsf, u8, 100);
+    u64* b = yo_tlsf_alloc(tlsf, u64, 300);
+    u8*  c = yo_tlsf_alloc_align(tlsf, 1000, 256);
+    u8*  d = yo_tlsf_alloc(tlsf, u8, 24);
+    yo_assert((a != NULL) && (b != NULL) && (c != NULL) && (d != NULL));
+    yo_assert((yo_cast(uptr, c) % 256 == 0) && (yo_tlsf_block_size(a) >= 100));
+    yo_assert((b[0] == 0) && (b[299] == 0));
+
+    // Freeing a block between used blocks fragments the free memory.
+    yo_tlsf_free(tlsf, b);
+    yo_TlsfStats fragmented = yo_tlsf_stats(tlsf);
+    yo_assert((fragmented.free_block_count >= 2) && (fragmented.fragmentation > 0.0f));
+
+    // Blocks are reused and grown in place when the next block is free.
+    a[99]     = 9;
+    u8* grown = yo_tlsf_realloc(tlsf, u8, a, 2000);
+    yo_assert((grown == a) && (grown[99] == 9) && (grown[1999] == 0));
+    u8* moved = yo_tlsf_realloc(tlsf, u8, d, 4096);
+    yo_assert((moved != d) && (yo_tlsf_block_size(moved) >= 4096));
+
+    // Releasing everything merges all blocks back together.
+    yo_tlsf_free(tlsf, grown);
+    yo_tlsf_free(tlsf, c);
+    yo_tlsf_free(tlsf, moved);
+    yo_TlsfStats final = yo_tlsf_stats(tlsf);
+    yo_assert((final.used_bytes == 0) && (final.free_block_count == 1));
+    yo_assert((final.largest_free_block == initial.largest_free_block) && (final.peak_used_bytes != 0));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void slab_heap_recycles_through_thread_cache(void) {
+    yo_SlabHeap heap = yo_make_slab_heap(yo_mebibytes(64));
+    yo_assert(heap.slabs != NULL);
+    yo_assert((yo_slab_class_size(1) == 16) && (yo_slab_class_size(129) == 160) && (yo_slab_class_size(8192) == 8192));
+
+    u8*  small   = yo_slab_alloc(&heap, u8, 20);
+    u64* medium  = yo_slab_alloc(&heap, u64, 100);
+    u8*  aligned = yo_slab_alloc_align(&heap, 40, 64);
+    yo_assert((small != NULL) && (medium != NULL) && (aligned != NULL));
+    yo_assert((yo_cast(uptr, aligned) % 64 == 0) && (medium[99] == 0));
+    yo_assert(yo_slab_stats(&heap).slab_count == 3);
+
+    // Freed objects are handed out again by the thread cache, zeroed.
+    small[19] = 19;
+    yo_slab_free(&heap, small);
+    u8* recycled = yo_slab_alloc(&heap, u8, 32);
+    yo_assert((recycled == small) && (recycled[19] == 0));
+
+    // Freeing many objects returns batches to the shared size class.
+    u8* objects[512];
+    for (u32 idx = 0; idx < yo_count_of(objects); ++idx) {
+        objects[idx] = yo_slab_alloc(&heap, u8, 48);
+    }
+    for (u32 idx = 0; idx < yo_count_of(objects); ++idx) {
+        yo_slab_free(&heap, objects[idx]);
+    }
+    yo_assert(heap.classes[2].free_count != 0);
+    yo_slab_thread_flush();
+    yo_assert(heap.classes[2].free_count == yo_count_of(objects));
+
+    // Large allocations are mapped directly.
+    u8* large = yo_slab_alloc(&heap, u8, yo_kibibytes(100));
+    yo_assert((large != NULL) && (yo_slab_stats(&heap).large_bytes >= yo_kibibytes(100)));
+    yo_slab_free(&heap, large);
+    yo_assert(yo_slab_stats(&heap).large_bytes == 0);
+
+    yo_slab_free(&heap, recycled);
+    yo_slab_free(&heap, medium);
+    yo_slab_free(&heap, aligned);
+    yo_destroy_slab_heap(&heap);
+    test_passed();
+}
+
+#define YO_TEST_SLAB_THREAD_COUNT 4
+#define YO_TEST_SLAB_OBJECT_COUNT 1024
+
+struct yo_TestSlabTask {
+    yo_SlabHeap* heap;
+    u8*          objects[YO_TEST_SLAB_OBJECT_COUNT];
+    u8           tag;
+};
+
+yo_internal void yo_test_slab_alloc_objects(void* user_data) {
+    struct yo_TestSlabTask* task = yo_cast(struct yo_TestSlabTask*, user_data);
+    for (u32 idx = 0; idx < YO_TEST_SLAB_OBJECT_COUNT; ++idx) {
+        task->objects[idx] = yo_slab_alloc(task->heap, u8, 48);
+        yo_assert((task->objects[idx] != NULL) && (task->objects[idx][47] == 0));
+        yo_memory_set(task->objects[idx], 48, task->tag);
+    }
+    yo_slab_thread_flush();
+}
+
+yo_internal void yo_test_slab_free_objects(void* user_data) {
+    struct yo_TestSlabTask* task = yo_cast(struct yo_TestSlabTask*, user_data);
+    for (u32 idx = 0; idx < YO_TEST_SLAB_OBJECT_COUNT; ++idx) {
+        yo_assert((task->objects[idx][0] == task->tag) && (task->objects[idx][47] == task->tag));
+        yo_slab_free(task->heap, task->objects[idx]);
+    }
+    yo_slab_thread_flush();
+}
+
+yo_internal void slab_heap_frees_across_threads(void) {
+    yo_SlabHeap            heap = yo_make_slab_heap(yo_mebibytes(64));
+    struct yo_TestSlabTask tasks[YO_TEST_SLAB_THREAD_COUNT];
+    yo_Thread              threads[YO_TEST_SLAB_THREAD_COUNT];
+
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        tasks[idx].heap = &heap;
+        tasks[idx].tag  = yo_cast(u8, idx + 1);
+        yo_assert(yo_thread_spawn(&threads[idx], yo_test_slab_alloc_objects, &tasks[idx]));
+    }
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+
+    // Each thread frees the objects allocated by its neighbour, which have to find their way back to
+    // the shared size class.
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        yo_assert(yo_thread_spawn(&threads[idx], yo_test_slab_free_objects, &tasks[(idx + 1) % YO_TEST_SLAB_THREAD_COUNT]));
+    }
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+    yo_assert(heap.classes[2].free_count == YO_TEST_SLAB_THREAD_COUNT * YO_TEST_SLAB_OBJECT_COUNT);
+
+    // The recycled objects are enough for another round, without carving new slabs.
+    usize slab_count = yo_slab_stats(&heap).slab_count;
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        yo_assert(yo_thread_spawn(&threads[idx], yo_test_slab_alloc_objects, &tasks[idx]));
+    }
+    for (u32 idx = 0; idx < YO_TEST_SLAB_THREAD_COUNT; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+    yo_assert(yo_slab_stats(&heap).slab_count == slab_count);
+
+    yo_destroy_slab_heap(&heap);
+    test_passed();
+}
+
+yo_internal void containers_run_on_any_allocator(void) {
+    yo_Arena             arena     = yo_make_owned_arena(yo_kibibytes(256));
+    yo_Tlsf*             tlsf      = yo_make_tlsf(&arena, yo_kibibytes(128));
+    yo_Allocator         heap      = yo_tlsf_allocator(tlsf);
+    yo_TrackingAllocator tracker   = yo_make_tracking_allocator(&heap);
+    yo_Allocator         allocator = yo_tracking_allocator(&tracker);
+
+    yo_Array(u32) array   = yo_make_array_with_allocator(&allocator, u32, 16);
+    yo_Buffer(f64) buffer = yo_make_buffer_with_allocator(&allocator, f64, 8);
+    yo_assert((yo_array_capacity(array) == 16) && (yo_buffer_count(buffer) == 8));
+    yo_array_push(array, 7);
+    yo_assert((yo_array_count(array) == 1) && (array[0] == 7));
+
+    yo_DynString string  = yo_make_dynstring_with_allocator(&allocator, 4);
+    yo_String    parts[] = {yo_make_string("hello"), yo_make_string("world")};
+    yo_assert(yo_join_strings(&string, yo_count_of(parts), parts, yo_make_string(", ")) == YO_STATUS_OK);
+    yo_assert(yo_string_equal(yo_make_string_from_dynstring(&string), yo_make_string("hello, world")));
+    yo_assert((tracker.alloc_count == 3) && (tracker.peak_bytes >= tracker.live_bytes));
+
+    // All memory requested through the tracker is accounted for when released.
+    yo_destroy_array_with_allocator(&allocator, array);
+    yo_destroy_buffer_with_allocator(&allocator, buffer);
+    yo_destroy_dynstring(&string);
+    yo_assert((tracker.live_bytes == 0) && (tracker.free_count == 3));
+    yo_assert(yo_tlsf_stats(tlsf).used_bytes == 0);
+
+    // The arena allocator only releases memory in bulk.
+    yo_Allocator arena_allocator = yo_arena_allocator(&arena);
+    u64*         values          = yo_allocator_alloc(&arena_allocator, u64, 4);
+    values[3]                    = 3;
+    values                       = yo_allocator_resize(&arena_allocator, u64, values, 4, 8);
+    yo_assert((values[3] == 3) && (values[7] == 0));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void concurrent_arena_restores_across_phases(void) {
+    yo_ConcurrentArena arena = yo_make_concurrent_arena(yo_kibibytes(64), yo_kibibytes(4));
+    yo_assert(arena.buf != NULL);
+
+    // Small allocations are served from the chunk reserved by the thread.
+    u32* first  = yo_concurrent_arena_alloc(&arena, u32, 4);
+    f64* second = yo_concurrent_arena_alloc(&arena, f64, 2);
+    yo_assert((first != NULL) && (second != NULL) && (yo_cast(uptr, second) % yo_align_of(f64) == 0));
+    yo_assert(yo_concurrent_arena_reserved_bytes(&arena) == yo_kibibytes(4));
+
+    // Large allocations are reserved directly from the shared offset.
+    u8* large = yo_concurrent_arena_alloc(&arena, u8, yo_kibibytes(8));
+    yo_assert((large != NULL) && (yo_concurrent_arena_reserved_bytes(&arena) == yo_kibibytes(12)));
+
+    // Restoring a checkpoint releases everything allocated during the phase, and reused memory is
+    // zeroed again.
+    yo_ConcurrentArenaCheckpoint checkpoint = yo_make_concurrent_arena_checkpoint(&arena);
+    u32*                         phase      = yo_concurrent_arena_alloc(&arena, u32, 16);
+    yo_assert(yo_cast(u8*, phase) >= large + yo_kibibytes(8));
+    phase[15] = 15;
+    yo_concurrent_arena_checkpoint_restore(checkpoint);
+    yo_assert(yo_concurrent_arena_reserved_bytes(&arena) == yo_kibibytes(12));
+    yo_assert(yo_concurrent_arena_alloc(&arena, u32, 16)[15] == 0);
+
+    yo_concurrent_arena_reset(&arena);
+    yo_assert(yo_concurrent_arena_alloc(&arena, u32, 4) == first);
+
+    yo_destroy_concurrent_arena(&arena);
+    test_passed();
+}
+
+#define YO_TEST_CONCURRENT_ARENA_THREAD_COUNT 4
+#define YO_TEST_CONCURRENT_ARENA_BLOCK_COUNT  256
+
+struct yo_TestConcurrentArenaTask {
+    yo_ConcurrentArena* arena;
+    u8*                 blocks[YO_TEST_CONCURRENT_ARENA_BLOCK_COUNT];
+    u8                  tag;
+};
+
+yo_internal usize yo_test_concurrent_arena_block_size(u32 idx) {
+    // Every 64th block is larger than the chunk fraction, thus reserved from the shared offset.
+    return (idx % 64 == 63) ? yo_kibibytes(3) : 8 + (idx % 7) * 24;
+}
+
+yo_internal void yo_test_concurrent_arena_fill(void* user_data) {
+    struct yo_TestConcurrentArenaTask* task = yo_cast(struct yo_TestConcurrentArenaTask*, user_data);
+    for (u32 idx = 0; idx < YO_TEST_CONCURRENT_ARENA_BLOCK_COUNT; ++idx) {
+        usize size_bytes = yo_test_concurrent_arena_block_size(idx);
+        u8*   block      = yo_concurrent_arena_alloc_align(task->arena, size_bytes, 8);
+        yo_assert((block != NULL) && (block[0] == 0) && (block[size_bytes - 1] == 0));
+        yo_memory_set(block, size_bytes, task->tag);
+        task->blocks[idx] = block;
+    }
+}
+
+yo_internal void concurrent_arena_is_shared_by_threads(void) {
+    yo_ConcurrentArena                arena = yo_make_concurrent_arena(yo_mebibytes(16), yo_kibibytes(16));
+    struct yo_TestConcurrentArenaTask tasks[YO_TEST_CONCURRENT_ARENA_THREAD_COUNT];
+    yo_Thread                         threads[YO_TEST_CONCURRENT_ARENA_THREAD_COUNT];
+
+    // Allocations only write the offset, which doesn't share its cache line with anything.
+    yo_assert(yo_cast(uptr, &arena.offset) % YO_CACHE_LINE_SIZE == 0);
+    yo_assert(yo_cast(uptr, &arena.buf) - yo_cast(uptr, &arena.offset) == YO_CACHE_LINE_SIZE);
+
+    yo_ConcurrentArenaCheckpoint checkpoint = yo_make_concurrent_arena_checkpoint(&arena);
+    for (u32 phase = 0; phase < 2; ++phase) {
+        for (u32 idx = 0; idx < YO_TEST_CONCURRENT_ARENA_THREAD_COUNT; ++idx) {
+            tasks[idx].arena = &arena;
+            tasks[idx].tag   = yo_cast(u8, idx + 1);
+            yo_assert(yo_thread_spawn(&threads[idx], yo_test_concurrent_arena_fill, &tasks[idx]));
+        }
+        for (u32 idx = 0; idx < YO_TEST_CONCURRENT_ARENA_THREAD_COUNT; ++idx) {
+            yo_thread_join(&threads[idx]);
+        }
+
+        // No block was handed out to more than one thread.
+        for (u32 task_idx = 0; task_idx < YO_TEST_CONCURRENT_ARENA_THREAD_COUNT; ++task_idx) {
+            for (u32 idx = 0; idx < YO_TEST_CONCURRENT_ARENA_BLOCK_COUNT; ++idx) {
+                u8 const* block      = tasks[task_idx].blocks[idx];
+                usize     size_bytes = yo_test_concurrent_arena_block_size(idx);
+                yo_assert((block[0] == tasks[task_idx].tag) && (block[size_bytes - 1] == tasks[task_idx].tag));
+            }
+        }
+
+        // The next phase reuses the same memory, zeroed again.
+        yo_concurrent_arena_checkpoint_restore(checkpoint);
+        yo_assert(yo_concurrent_arena_reserved_bytes(&arena) == 0);
+    }
+
+    yo_destroy_concurrent_arena(&arena);
+    test_passed();
+}
+
+yo_internal u32* scratch_sum_prefixes(yo_Arena* output, u32 const* values, u32 count) {
+    yo_Scratch scratch = yo_scratch_begin(&output, 1);
+    yo_assert(scratch.arena != output);
+
+    // Temporaries never land in the output arena, even if it is a scratch arena itself.
+    u32* temporary = yo_arena_alloc(scratch.arena, u32, count);
+    u32* result    = yo_arena_alloc(output, u32, count);
+    for (u32 idx = 0; idx < count; ++idx) {
+        temporary[idx] = values[idx] + ((idx != 0) ? temporary[idx - 1] : 0);
+        result[idx]    = temporary[idx];
+    }
+
+    yo_scratch_end(scratch);
+    return result;
+}
+
+yo_internal void scratch_arenas_avoid_conflicts(void) {
+    u32 values[] = {1, 2, 3, 4};
+
+    yo_Scratch outer  = yo_scratch_begin(NULL, 0);
+    usize      offset = outer.arena->offset;
+    u32*       sums   = scratch_sum_prefixes(outer.arena, values, yo_count_of(values));
+    yo_assert((sums[3] == 10) && (outer.arena->offset > offset));
+
+    // The nested scratch was released without touching the output arena.
+    yo_Scratch inner = yo_scratch_begin(&outer.arena, 1);
+    yo_assert((inner.arena != outer.arena) && (inner.arena->offset == 0));
+    yo_scratch_end(inner);
+
+    yo_scratch_end(outer);
+    yo_assert(outer.arena->offset == offset);
+
+    yo_scratch_thread_release();
+    test_passed();
+}
+
+yo_internal void ring_buffers_wrap_around(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    // Pushing into a full ring overwrites the oldest element.
+    yo_Ring(u32) ring = yo_make_ring(&arena, u32, 3);
+    yo_assert(yo_ring_capacity(ring) == 4);
+    for (u32 idx = 0; idx < 6; ++idx) {
+        yo_ring_push(ring, idx);
+    }
+    yo_assert((yo_ring_count(ring) == 4) && (*yo_ring_at(ring, 0) == 2) && (*yo_ring_at(ring, 3) == 5));
+
+    u32 popped = 0;
+    yo_assert(yo_ring_pop(ring, &popped) && (popped == 2));
+    yo_ring_clear(ring);
+    yo_assert(!yo_ring_pop(ring, &popped) && (yo_ring_count(ring) == 0));
+
+    // The lock-free ring refuses to overwrite and splits bulk copies at the end of its memory.
+    yo_SpscRing spsc = yo_make_spsc_ring(&arena, u32, 8);
+    u32         in[] = {10, 11, 12, 13, 14, 15};
+    u32         out[8];
+    yo_assert(yo_spsc_ring_push_bulk(&spsc, in, yo_count_of(in)) == 6);
+    yo_assert((yo_spsc_ring_pop_bulk(&spsc, out, 5) == 5) && (out[4] == 14));
+    yo_assert(yo_spsc_ring_push_bulk(&spsc, in, yo_count_of(in)) == 6);
+    yo_assert(yo_spsc_ring_try_push(&spsc, &in[0]) && !yo_spsc_ring_try_push(&spsc, &in[1]));
+    yo_assert((yo_spsc_ring_count(&spsc) == 8) && (yo_spsc_ring_pop_bulk(&spsc, out, 8) == 8));
+    yo_assert((out[0] == 15) && (out[1] == 10) && (out[6] == 15) && (out[7] == 10));
+    yo_assert(!yo_spsc_ring_try_pop(&spsc, &popped));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+#define YO_TEST_SPSC_ELEMENT_COUNT 20000
+
+yo_internal void yo_test_spsc_produce(void* user_data) {
+    yo_SpscRing* ring = yo_cast(yo_SpscRing*, user_data);
+
+    // Alternate between single and bulk pushes, so that both cross the wrap point of the ring.
+    u32 next = 0;
+    while (next < YO_TEST_SPSC_ELEMENT_COUNT) {
+        if (next % 3 == 0) {
+            if (yo_spsc_ring_try_push(ring, &next)) {
+                ++next;
+            } else {
+                yo_thread_yield();
+            }
+            continue;
+        }
+
+        u32 batch[5];
+        u32 batch_count = yo_min_value(yo_cast(u32, yo_count_of(batch)), YO_TEST_SPSC_ELEMENT_COUNT - next);
+        for (u32 idx = 0; idx < batch_count; ++idx) {
+            batch[idx] = next + idx;
+        }
+        u32 pushed_count = yo_cast(u32, yo_spsc_ring_push_bulk(ring, batch, batch_count));
+        if (pushed_count == 0) {
+            yo_thread_yield();
+        }
+        next += pushed_count;
+    }
+}
+
+#define yo_test_cache_line(ptr) (yo_cast(uptr, ptr) / YO_CACHE_LINE_SIZE)
+
+yo_internal void spsc_ring_hands_off_between_threads(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    // Place the ring right after a small allocation: each side still gets its own cache line.
+    yo_discard_value(yo_arena_alloc(&arena, u8, 8));
+    yo_SpscRing* placed = yo_arena_alloc(&arena, yo_SpscRing, 1);
+    *placed             = yo_make_spsc_ring(&arena, u32, 16);
+    yo_assert(yo_test_cache_line(&placed->head) == yo_test_cache_line(&placed->cached_tail));
+    yo_assert(yo_test_cache_line(&placed->tail) == yo_test_cache_line(&placed->cached_head));
+    yo_assert(yo_test_cache_line(&placed->buf) == yo_test_cache_line(&placed->capacity));
+    yo_assert(yo_test_cache_line(&placed->head) != yo_test_cache_line(&placed->tail));
+    yo_assert(yo_test_cache_line(&placed->buf) != yo_test_cache_line(&placed->head));
+    yo_assert(yo_test_cache_line(&placed->buf) != yo_test_cache_line(&placed->tail));
+
+    yo_Thread producer;
+    yo_assert(yo_thread_spawn(&producer, yo_test_spsc_produce, placed));
+
+    // Elements arrive in the order they were pushed, none missing nor repeated.
+    u32 expected = 0;
+    while (expected < YO_TEST_SPSC_ELEMENT_COUNT) {
+        u32   out[7];
+        usize count = (expected % 2 == 0) ? yo_spsc_ring_pop_bulk(placed, out, yo_count_of(out))
+                                          : (yo_spsc_ring_try_pop(placed, &out[0]) ? 1 : 0);
+        if (count == 0) {
+            yo_thread_yield();
+        }
+        for (usize idx = 0; idx < count; ++idx) {
+            yo_assert(out[idx] == expected);
+            ++expected;
+        }
+    }
+
+    yo_thread_join(&producer);
+    yo_assert(yo_spsc_ring_count(placed) == 0);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void stream_ring_spans_the_wrap_point(void) {
+    yo_StreamRing ring = yo_make_stream_ring(0);
+    yo_assert((ring.buf != NULL) && (ring.capacity == YO_STREAM_RING_MIN_CAPACITY));
+
+    u8 data[yo_kibibytes(8)];
+    for (usize idx = 0; idx < yo_count_of(data); ++idx) {
+        data[idx] = yo_cast(u8, idx % 251);
+    }
+
+    // Move the cursors close to the end of the ring memory.
+    usize skipped = ring.capacity - yo_kibibytes(4);
+    ring.head     = skipped;
+    ring.tail     = skipped;
+
+    yo_assert(yo_stream_ring_write(&ring, data, yo_count_of(data)) == yo_count_of(data));
+
+    // A mirrored ring views the bytes across the wrap point as a single span.
+    yo_String view = yo_stream_ring_peek(&ring);
+    yo_assert(view.length == (ring.mirrored ? yo_count_of(data) : yo_kibibytes(4)));
+    yo_assert(yo_cast(u8, view.buf[view.length - 1]) == data[view.length - 1]);
+
+    u8 out[yo_kibibytes(8)];
+    yo_stream_ring_consume(&ring, 16);
+    yo_assert(yo_stream_ring_read(&ring, out, yo_count_of(out)) == yo_count_of(data) - 16);
+    yo_assert((out[0] == data[16]) && (out[yo_count_of(data) - 17] == data[yo_count_of(data) - 1]));
+
+    usize span_size = 0;
+    yo_assert((yo_stream_ring_write_span(&ring, &span_size) != NULL) && (span_size != 0));
+
+    yo_destroy_stream_ring(&ring);
+    test_passed();
+}
+
+yo_internal void dynarray_grows_in_place(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    yo_DynArray(u32) array = yo_make_dynarray(&arena, u32, 2);
+    u32* first_element     = array;
+    for (u32 idx = 0; idx < 10; ++idx) {
+        yo_dynarray_push(array, idx);
+    }
+    // The array is the last allocation of the arena, so it never had to move.
+    yo_assert((array == first_element) && (yo_dynarray_count(array) == 10) && (yo_dynarray_capacity(array) == 16));
+
+    u32 tail[] = {10, 11};
+    yo_dynarray_append(array, tail, yo_count_of(tail));
+    yo_dynarray_insert(array, 0, 42);
+    yo_assert((yo_dynarray_count(array) == 13) && (array[0] == 42) && (array[1] == 0) && (array[12] == 11));
+
+    yo_dynarray_remove_swap(array, 0);
+    yo_assert((yo_dynarray_count(array) == 12) && (array[0] == 11));
+
+    // Shrinking gives the unused capacity back to the arena.
+    usize offset = arena.offset;
+    yo_dynarray_shrink_to_fit(array);
+    yo_assert((yo_dynarray_capacity(array) == 12) && (arena.offset == offset - 4 * yo_size_of(u32)));
+
+    // Once another allocation follows the array, growing it copies the elements.
+    yo_discard_value(yo_arena_alloc(&arena, u8, 1));
+    yo_dynarray_push(array, 12);
+    yo_assert((array != first_element) && (yo_dynarray_count(array) == 13) && (array[11] == 10) && (array[12] == 12));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
 yo_internal void test_memory(void) {
     core_type_sizes();
     offset_check();
+    reserved_arena_commits_on_demand();
+    arena_zeroes_only_touched_memory();
+    chained_arena_spills_and_restores();
+    huge_page_arenas_report_page_size();
+    arena_trim_releases_surplus_with_hysteresis();
+    pool_recycles_slots();
+    stack_pops_in_lifo_order();
+    tlsf_frees_and_coalesces_blocks();
+    slab_heap_recycles_through_thread_cache();
+    slab_heap_frees_across_threads();
+    containers_run_on_any_allocator();
+    concurrent_arena_restores_across_phases();
+    concurrent_arena_is_shared_by_threads();
+    scratch_arenas_avoid_conflicts();
+    ring_buffers_wrap_around();
+    spsc_ring_hands_off_between_threads();
+    stream_ring_spans_the_wrap_point();
+    dynarray_grows_in_place();
 }
 
 #if !defined(YO_TEST_NO_MAIN)
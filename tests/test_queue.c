@@ -0,0 +1,162 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the queues shared between threads.
+/// File name: test_queue.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_queue.h>
+#include <yoneda_thread.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void mpmc_queue_reports_full_and_empty(void) {
+    yo_Arena     arena = yo_make_owned_arena(yo_kibibytes(4));
+    yo_MpmcQueue queue = yo_make_mpmc_queue(&arena, u64, 3);
+    yo_assert(queue.capacity == 4);
+
+    // Each counter, the waiters and the read-only fields start their own cache line.
+    uptr lines[] = {
+        yo_cast(uptr, &queue.enqueue_position),
+        yo_cast(uptr, &queue.dequeue_position),
+        yo_cast(uptr, &queue.not_empty),
+        yo_cast(uptr, &queue.cells),
+    };
+    for (usize idx = 0; idx < yo_count_of(lines); ++idx) {
+        yo_assert((lines[idx] % YO_CACHE_LINE_SIZE == 0) && ((idx == 0) || (lines[idx] - lines[idx - 1] == YO_CACHE_LINE_SIZE)));
+    }
+
+    // Go around the cells a few times, filling the queue on each lap.
+    u64 popped = 0;
+    for (u64 lap = 0; lap < 3; ++lap) {
+        for (u64 idx = 0; idx < 4; ++idx) {
+            u64 value = lap * 4 + idx;
+            yo_assert(yo_mpmc_queue_try_push(&queue, &value));
+        }
+        yo_assert(!yo_mpmc_queue_try_push(&queue, &popped) && (yo_mpmc_queue_count(&queue) == 4));
+
+        for (u64 idx = 0; idx < 4; ++idx) {
+            yo_mpmc_queue_pop(&queue, &popped);
+            yo_assert(popped == lap * 4 + idx);
+        }
+        yo_assert(!yo_mpmc_queue_try_pop(&queue, &popped) && (yo_mpmc_queue_count(&queue) == 0));
+    }
+
+    // Blocking calls return right away when they can proceed.
+    u64 value = 42;
+    yo_mpmc_queue_push(&queue, &value);
+    yo_assert(yo_mpmc_queue_try_pop(&queue, &popped) && (popped == 42));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+#define YO_TEST_MPMC_PRODUCER_COUNT 4
+#define YO_TEST_MPMC_CONSUMER_COUNT 4
+#define YO_TEST_MPMC_PUSH_COUNT     4000
+#define YO_TEST_MPMC_ELEMENT_COUNT  (YO_TEST_MPMC_PRODUCER_COUNT * YO_TEST_MPMC_PUSH_COUNT)
+
+struct yo_TestMpmcState {
+    yo_MpmcQueue queue;
+    /// Number of times each element was popped.
+    u32 volatile pop_counts[YO_TEST_MPMC_ELEMENT_COUNT];
+};
+
+struct yo_TestMpmcTask {
+    struct yo_TestMpmcState* state;
+    u32                      thread_index;
+};
+
+yo_internal void yo_test_mpmc_produce(void* user_data) {
+    struct yo_TestMpmcTask* task = yo_cast(struct yo_TestMpmcTask*, user_data);
+    for (u32 idx = 0; idx < YO_TEST_MPMC_PUSH_COUNT; ++idx) {
+        u32 element = task->thread_index * YO_TEST_MPMC_PUSH_COUNT + idx;
+        yo_mpmc_queue_push(&task->state->queue, &element);
+    }
+}
+
+yo_internal void yo_test_mpmc_consume(void* user_data) {
+    struct yo_TestMpmcTask* task = yo_cast(struct yo_TestMpmcTask*, user_data);
+    for (u32 idx = 0; idx < YO_TEST_MPMC_ELEMENT_COUNT / YO_TEST_MPMC_CONSUMER_COUNT; ++idx) {
+        u32 element = 0;
+        yo_mpmc_queue_pop(&task->state->queue, &element);
+        yo_assert(element < YO_TEST_MPMC_ELEMENT_COUNT);
+        yo_discard_value(yo_atomic_fetch_add_u32(&task->state->pop_counts[element], 1, YO_MEMORY_ORDER_RELAXED));
+    }
+}
+
+yo_internal void mpmc_queue_wakes_sleeping_threads(void) {
+    yo_Arena                 arena = yo_make_owned_arena(yo_kibibytes(256));
+    struct yo_TestMpmcState* state = yo_arena_alloc(&arena, struct yo_TestMpmcState, 1);
+    state->queue                   = yo_make_mpmc_queue(&arena, u32, 4);
+
+    yo_Thread              consumers[YO_TEST_MPMC_CONSUMER_COUNT];
+    yo_Thread              producers[YO_TEST_MPMC_PRODUCER_COUNT];
+    struct yo_TestMpmcTask consumer_tasks[YO_TEST_MPMC_CONSUMER_COUNT];
+    struct yo_TestMpmcTask producer_tasks[YO_TEST_MPMC_PRODUCER_COUNT];
+
+    // Consumers start on an empty queue, so all of them end up sleeping before the first push.
+    for (u32 idx = 0; idx < YO_TEST_MPMC_CONSUMER_COUNT; ++idx) {
+        consumer_tasks[idx] = (struct yo_TestMpmcTask){.state = state, .thread_index = idx};
+        yo_assert(yo_thread_spawn(&consumers[idx], yo_test_mpmc_consume, &consumer_tasks[idx]));
+    }
+    while (yo_atomic_load_u32(&state->queue.not_empty.sleeper_count, YO_MEMORY_ORDER_RELAXED) != YO_TEST_MPMC_CONSUMER_COUNT) {
+        yo_thread_yield();
+    }
+
+    // The queue is much smaller than the number of elements, so producers also have to sleep.
+    for (u32 idx = 0; idx < YO_TEST_MPMC_PRODUCER_COUNT; ++idx) {
+        producer_tasks[idx] = (struct yo_TestMpmcTask){.state = state, .thread_index = idx};
+        yo_assert(yo_thread_spawn(&producers[idx], yo_test_mpmc_produce, &producer_tasks[idx]));
+    }
+    for (u32 idx = 0; idx < YO_TEST_MPMC_PRODUCER_COUNT; ++idx) {
+        yo_thread_join(&producers[idx]);
+    }
+    for (u32 idx = 0; idx < YO_TEST_MPMC_CONSUMER_COUNT; ++idx) {
+        yo_thread_join(&consumers[idx]);
+    }
+
+    // Every element was popped exactly once, and nobody was left sleeping.
+    for (u32 idx = 0; idx < YO_TEST_MPMC_ELEMENT_COUNT; ++idx) {
+        yo_assert(state->pop_counts[idx] == 1);
+    }
+    yo_assert(yo_mpmc_queue_count(&state->queue) == 0);
+    yo_assert((state->queue.not_empty.sleeper_count == 0) && (state->queue.not_full.sleeper_count == 0));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_queue(void) {
+    mpmc_queue_reports_full_and_empty();
+    mpmc_queue_wakes_sleeping_threads();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_queue();
+    return 0;
+}
+#endif
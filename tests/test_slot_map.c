@@ -0,0 +1,109 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the slot map.
+/// File name: test_slot_map.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_slot_map.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void slot_map_invalidates_removed_handles(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    yo_SlotMap(u64) map = yo_make_slot_map(&arena, u64, 8);
+    yo_SlotHandle   handles[8];
+    for (u64 idx = 0; idx < 8; ++idx) {
+        u64 value    = idx * 10;
+        handles[idx] = yo_slot_map_insert(map, &value);
+    }
+    u64 extra = 80;
+    yo_assert((yo_slot_map_count(map) == 8) && (yo_slot_map_insert(map, &extra).index == YO_SLOT_MAP_INVALID_INDEX));
+
+    // Removing moves the last element into the hole, and its handle keeps working.
+    yo_assert(yo_slot_map_remove(map, handles[2]) && !yo_slot_map_remove(map, handles[2]));
+    yo_assert((yo_slot_map_count(map) == 7) && (map[2] == 70) && (*yo_cast(u64*, yo_slot_map_get(map, handles[7])) == 70));
+    yo_SlotHandle moved = yo_slot_map_handle_at(map, 2);
+    yo_assert((moved.index == handles[7].index) && (moved.generation == handles[7].generation));
+
+    // A reused slot doesn't revive stale handles.
+    yo_SlotHandle reused = yo_slot_map_insert(map, &extra);
+    yo_assert((reused.index == handles[2].index) && (reused.generation != handles[2].generation));
+    yo_assert(!yo_slot_map_contains(map, handles[2]) && (yo_slot_map_get(map, handles[2]) == NULL));
+    yo_assert(*yo_cast(u64*, yo_slot_map_get(map, reused)) == 80);
+
+    u64 sum = 0;
+    yo_slot_map_for_index(idx, map) {
+        sum += map[idx];
+    }
+    yo_assert(sum == 0 + 10 + 30 + 40 + 50 + 60 + 70 + 80);
+
+    yo_slot_map_clear(map);
+    yo_assert((yo_slot_map_count(map) == 0) && !yo_slot_map_contains(map, reused) && !yo_slot_map_contains(map, yo_slot_handle_invalid()));
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void slot_map_retires_exhausted_slots(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    yo_SlotMap(u64) map   = yo_make_slot_map(&arena, u64, 2);
+    u64             value = 7;
+    yo_SlotHandle   first = yo_slot_map_insert(map, &value);
+    yo_assert(yo_slot_map_remove(map, first));
+
+    // Skip to the last generation of the slot instead of going through billions of insertions.
+    yo_impl_slot_map_header(map)->slots[first.index].generation = 0xFFFFFFFE;
+
+    yo_SlotHandle last = yo_slot_map_insert(map, &value);
+    yo_assert((last.index == first.index) && (last.generation == 0xFFFFFFFF));
+
+    // The wrapped slot isn't reused, so neither handle comes back to life.
+    yo_assert(yo_slot_map_remove(map, last));
+    yo_SlotHandle fresh = yo_slot_map_insert(map, &value);
+    yo_assert((fresh.index != first.index) && yo_slot_map_contains(map, fresh));
+    yo_assert(!yo_slot_map_contains(map, first) && !yo_slot_map_contains(map, last));
+
+    // With the other slot taken, the retired one leaves no room for a second element.
+    yo_assert(yo_slot_map_insert(map, &value).index == YO_SLOT_MAP_INVALID_INDEX);
+    yo_slot_map_clear(map);
+    yo_assert(yo_slot_map_insert(map, &value).index == fresh.index);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_slot_map(void) {
+    slot_map_invalidates_removed_handles();
+    slot_map_retires_exhausted_slots();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_slot_map();
+    return 0;
+}
+#endif
@@ -0,0 +1,71 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding struct-of-arrays containers.
+/// File name: test_soa.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_memory.h>
+#include <yoneda_soa.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+#define yo_test_particle_fields(X) X(f32, mass) X(u8, flags) X(u64, id)
+yo_define_soa(yo_TestParticles, yo_test_particle_fields)
+
+yo_internal void soa_columns_stay_aligned(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(4));
+
+    yo_TestParticles particles = yo_TestParticles_make(&arena, 10);
+    yo_assert((particles.capacity == 10) && (yo_soa_column_capacity(particles, flags) == 64));
+    yo_assert(yo_soa_column_capacity(particles, mass) == 16);
+    yo_assert((yo_cast(uptr, particles.mass) % YO_SOA_COLUMN_ALIGNMENT == 0) && (yo_cast(uptr, particles.id) % YO_SOA_COLUMN_ALIGNMENT == 0));
+
+    for (u32 idx = 0; idx < 10; ++idx) {
+        yo_assert(yo_TestParticles_push(&particles, yo_cast(f32, idx), yo_cast(u8, idx), idx * 100));
+    }
+    yo_assert(!yo_TestParticles_push(&particles, 0.0f, 0, 0));
+
+    // Swap removal moves every column of the last element.
+    yo_TestParticles_remove_swap(&particles, 3);
+    yo_assert((particles.count == 9) && (particles.mass[3] == 9.0f) && (particles.flags[3] == 9) && (particles.id[3] == 900));
+    yo_TestParticles_remove_swap(&particles, 8);
+    yo_assert((particles.count == 8) && (particles.id[7] == 700));
+
+    yo_TestParticles_clear(&particles);
+    yo_assert(particles.count == 0);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_soa(void) {
+    soa_columns_stay_aligned();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_soa();
+    return 0;
+}
+#endif
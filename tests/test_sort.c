@@ -0,0 +1,186 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding the sorting algorithms.
+/// File name: test_sort.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_core.h>
+#include <yoneda_hash.h>
+#include <yoneda_memory.h>
+#include <yoneda_sort.h>
+#include <yoneda_thread.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+yo_internal void radix_sort_orders_keys(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(64));
+
+    usize count = 1000;
+    u32*  u32s  = yo_make_buffer(&arena, u32, count);
+    u64*  u64s  = yo_make_buffer(&arena, u64, count);
+    i32*  i32s  = yo_make_buffer(&arena, i32, count);
+    f32*  f32s  = yo_make_buffer(&arena, f32, count);
+    for (usize idx = 0; idx < count; ++idx) {
+        u32 random = yo_hash_u32(yo_cast(u32, idx));
+        u32s[idx]  = random;
+        u64s[idx]  = (yo_cast(u64, random) << 32) | (random & 0xFF);  // Leaves the middle passes trivial.
+        i32s[idx]  = yo_cast(i32, random);
+        f32s[idx]  = yo_cast(f32, yo_cast(i32, random)) / 1024.0f;
+    }
+    f32s[0] = -0.0f;
+    f32s[1] = 0.0f;
+
+    yo_assert(yo_radix_sort_buffer(u32, u32s) && yo_radix_sort_buffer(u64, u64s));
+    yo_assert(yo_radix_sort_buffer(i32, i32s) && yo_radix_sort_buffer(f32, f32s));
+    for (usize idx = 1; idx < count; ++idx) {
+        yo_assert((u32s[idx - 1] <= u32s[idx]) && (u64s[idx - 1] <= u64s[idx]));
+        yo_assert((i32s[idx - 1] <= i32s[idx]) && (f32s[idx - 1] <= f32s[idx]));
+    }
+    yo_assert((i32s[0] < 0) && (f32s[0] < 0.0f));
+
+    // Pairs with equal keys keep their order, both above and below the insertion sort threshold.
+    usize pair_counts[] = {YO_RADIX_SORT_INSERTION_THRESHOLD / 2, count};
+    for (usize kdx = 0; kdx < yo_count_of(pair_counts); ++kdx) {
+        yo_KeyIndex* pairs = yo_make_buffer(&arena, yo_KeyIndex, pair_counts[kdx]);
+        for (u32 idx = 0; idx < pair_counts[kdx]; ++idx) {
+            pairs[idx] = (yo_KeyIndex){.key = yo_hash_u32(idx) % 16, .index = idx};
+        }
+
+        yo_assert(yo_radix_sort_buffer(key_index, pairs));
+        for (usize idx = 1; idx < pair_counts[kdx]; ++idx) {
+            yo_KeyIndex previous = pairs[idx - 1];
+            yo_assert((previous.key < pairs[idx].key) || ((previous.key == pairs[idx].key) && (previous.index < pairs[idx].index)));
+        }
+    }
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+struct yo_TestRecord {
+    u32 key;
+    u32 order;
+};
+yo_type_alias(yo_TestRecord, struct yo_TestRecord);
+
+#define yo_test_record_is_less(lhs, rhs) ((lhs)->key < (rhs)->key)
+yo_define_sort(yo_test_records, yo_TestRecord, yo_test_record_is_less)
+yo_define_parallel_sort(yo_test_records, yo_TestRecord, yo_test_record_is_less)
+
+// Expands both arguments twice, breaking ties between equal keys by the original order.
+#define yo_test_record_is_before(lhs, rhs) \
+    (((lhs)->key < (rhs)->key) || (((lhs)->key == (rhs)->key) && ((lhs)->order < (rhs)->order)))
+yo_define_sort(yo_test_records_total, yo_TestRecord, yo_test_record_is_before)
+
+yo_internal void comparison_sorts_order_records(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(64));
+
+    // Random keys with many duplicates, sorted, reversed, organ pipe and constant inputs.
+    usize          count   = 2000;
+    yo_TestRecord* records = yo_make_buffer(&arena, yo_TestRecord, count);
+    for (u32 pattern = 0; pattern < 5; ++pattern) {
+        for (u32 idx = 0; idx < count; ++idx) {
+            u32 keys[]   = {yo_hash_u32(idx) % 64, idx, yo_cast(u32, count) - idx, yo_min_value(idx, yo_cast(u32, count) - idx), 7};
+            records[idx] = (yo_TestRecord){.key = keys[pattern], .order = idx};
+        }
+
+        // The unstable sort keeps every record.
+        yo_test_records_sort(records, count);
+        u64 order_sum = 0;
+        for (usize idx = 0; idx < count; ++idx) {
+            yo_assert((idx == 0) || (records[idx - 1].key <= records[idx].key));
+            order_sum += records[idx].order;
+        }
+        yo_assert(order_sum == count * (count - 1) / 2);
+
+        // Shuffle the records again, then check that the stable sort keeps equal keys in their original order.
+        for (u32 idx = 0; idx < count; ++idx) {
+            records[idx] = (yo_TestRecord){.key = yo_hash_u32(idx) % 64 + pattern, .order = idx};
+        }
+        usize offset = arena.offset;
+        yo_assert(yo_stable_sort_buffer(yo_test_records, records, &arena) && (arena.offset == offset));
+        for (usize idx = 1; idx < count; ++idx) {
+            yo_TestRecord previous = records[idx - 1];
+            yo_assert((previous.key < records[idx].key) || ((previous.key == records[idx].key) && (previous.order < records[idx].order)));
+        }
+    }
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void comparison_sorts_expand_arguments_freely(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_kibibytes(64));
+
+    // With a total order even the unstable sort has a single possible outcome.
+    usize          count   = 2000;
+    yo_TestRecord* records = yo_make_buffer(&arena, yo_TestRecord, count);
+    for (u32 idx = 0; idx < count; ++idx) {
+        records[idx] = (yo_TestRecord){.key = yo_hash_u32(idx) % 16, .order = yo_hash_u32(idx + 1) % 1000};
+    }
+    yo_test_records_total_sort(records, count);
+    for (usize idx = 1; idx < count; ++idx) {
+        yo_assert(!yo_test_record_is_before(&records[idx], &records[idx - 1]));
+    }
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void parallel_sort_merges_buckets(void) {
+    yo_Arena arena = yo_make_owned_arena(yo_mebibytes(1));
+
+    // Enough elements for three threads, with duplicated keys spread across all chunks.
+    usize          count   = 3 * YO_PARALLEL_SORT_MIN_THREAD_ELEMENT_COUNT + 5;
+    yo_TestRecord* records = yo_make_buffer(&arena, yo_TestRecord, count);
+    for (u32 idx = 0; idx < count; ++idx) {
+        records[idx] = (yo_TestRecord){.key = yo_hash_u32(idx) % 10000, .order = idx};
+    }
+
+    usize offset = arena.offset;
+    yo_assert(yo_parallel_sort_buffer(yo_test_records, records, 4, &arena) && (arena.offset == offset));
+    u64 order_sum = records[0].order;
+    for (usize idx = 1; idx < count; ++idx) {
+        yo_assert(records[idx - 1].key <= records[idx].key);
+        order_sum += records[idx].order;
+    }
+    yo_assert(order_sum == yo_cast(u64, count) * (count - 1) / 2);
+    yo_assert(yo_thread_hardware_count() >= 1);
+
+    yo_destroy_owned_arena(&arena);
+    test_passed();
+}
+
+yo_internal void test_sort(void) {
+    radix_sort_orders_keys();
+    comparison_sorts_order_records();
+    comparison_sorts_expand_arguments_freely();
+    parallel_sort_merges_buckets();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_sort();
+    return 0;
+}
+#endif
@@ -0,0 +1,146 @@
+///                             Yoneda library
+/// Copyright (C) 2024 - Present, Luiz Gustavo Mugnaini Anselmo
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of
+/// this software and associated documentation files (the “Software”), to deal in
+/// the Software without restriction, including without limitation the rights to
+/// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/// of the Software, and to permit persons to whom the Software is furnished to do
+/// so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// Description: Tests regarding threads and their synchronization primitives.
+/// File name: test_thread.c
+/// Author: Luiz G. Mugnaini A. <luizmuganini@gmail.com>
+
+#include <yoneda_assert.h>
+#include <yoneda_atomic.h>
+#include <yoneda_core.h>
+#include <yoneda_thread.h>
+
+#define test_passed() yo_log_info_fmt("Test %s passed.", yo_source_function_name())
+
+#define YO_TEST_THREAD_COUNT 4
+
+struct yo_TestThreadState {
+    /// Futex word, set to 1 once the threads are allowed to run.
+    u32 volatile gate;
+    u32 volatile ready_count;
+    u32 volatile sum;
+};
+
+yo_internal void yo_test_thread_wait_and_add(void* user_data) {
+    struct yo_TestThreadState* state = yo_cast(struct yo_TestThreadState*, user_data);
+
+    yo_discard_value(yo_atomic_fetch_add_u32(&state->ready_count, 1, YO_MEMORY_ORDER_RELEASE));
+    while (yo_atomic_load_u32(&state->gate, YO_MEMORY_ORDER_ACQUIRE) == 0) {
+        yo_futex_wait(&state->gate, 0);
+    }
+
+    for (u32 idx = 0; idx < 1000; ++idx) {
+        yo_discard_value(yo_atomic_fetch_add_u32(&state->sum, 1, YO_MEMORY_ORDER_RELAXED));
+    }
+}
+
+yo_internal void threads_sleep_until_woken(void) {
+    yo_assert(yo_thread_hardware_count() >= 1);
+
+    struct yo_TestThreadState state = {0};
+    yo_Thread                 threads[YO_TEST_THREAD_COUNT];
+    for (u32 idx = 0; idx < YO_TEST_THREAD_COUNT; ++idx) {
+        yo_assert(yo_thread_spawn(&threads[idx], yo_test_thread_wait_and_add, &state));
+    }
+
+    // Nobody gets past the gate before it is opened.
+    while (yo_atomic_load_u32(&state.ready_count, YO_MEMORY_ORDER_ACQUIRE) != YO_TEST_THREAD_COUNT) {
+        yo_thread_yield();
+    }
+    yo_assert(yo_atomic_load_u32(&state.sum, YO_MEMORY_ORDER_RELAXED) == 0);
+
+    yo_atomic_store_u32(&state.gate, 1, YO_MEMORY_ORDER_RELEASE);
+    yo_futex_wake_all(&state.gate);
+    for (u32 idx = 0; idx < YO_TEST_THREAD_COUNT; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+    yo_assert(state.sum == YO_TEST_THREAD_COUNT * 1000);
+
+    test_passed();
+}
+
+#define YO_TEST_BARRIER_PHASE_COUNT 100
+
+struct yo_TestBarrierState {
+    yo_Barrier   barrier;
+    u32          phases[YO_TEST_THREAD_COUNT];
+    u32 volatile last_arrival_count;
+    u32 volatile stale_phase_count;
+};
+
+struct yo_TestBarrierTask {
+    struct yo_TestBarrierState* state;
+    u32                         thread_index;
+};
+
+yo_internal void yo_test_barrier_run_phases(void* user_data) {
+    struct yo_TestBarrierTask*  task  = yo_cast(struct yo_TestBarrierTask*, user_data);
+    struct yo_TestBarrierState* state = task->state;
+
+    for (u32 phase = 1; phase <= YO_TEST_BARRIER_PHASE_COUNT; ++phase) {
+        state->phases[task->thread_index] = phase;
+        if (yo_barrier_wait(&state->barrier)) {
+            yo_discard_value(yo_atomic_fetch_add_u32(&state->last_arrival_count, 1, YO_MEMORY_ORDER_RELAXED));
+        }
+
+        // Every thread wrote the current phase, and nobody can write the next one before all
+        // threads read it.
+        for (u32 idx = 0; idx < YO_TEST_THREAD_COUNT; ++idx) {
+            if (state->phases[idx] != phase) {
+                yo_discard_value(yo_atomic_fetch_add_u32(&state->stale_phase_count, 1, YO_MEMORY_ORDER_RELAXED));
+            }
+        }
+        yo_discard_value(yo_barrier_wait(&state->barrier));
+    }
+}
+
+yo_internal void barrier_separates_phases(void) {
+    struct yo_TestBarrierState state = {.barrier = yo_make_barrier(YO_TEST_THREAD_COUNT)};
+    struct yo_TestBarrierTask  tasks[YO_TEST_THREAD_COUNT];
+    yo_Thread                  threads[YO_TEST_THREAD_COUNT];
+    for (u32 idx = 0; idx < YO_TEST_THREAD_COUNT; ++idx) {
+        tasks[idx] = (struct yo_TestBarrierTask){.state = &state, .thread_index = idx};
+        if (idx != 0) {
+            yo_assert(yo_thread_spawn(&threads[idx], yo_test_barrier_run_phases, &tasks[idx]));
+        }
+    }
+
+    yo_test_barrier_run_phases(&tasks[0]);
+    for (u32 idx = 1; idx < YO_TEST_THREAD_COUNT; ++idx) {
+        yo_thread_join(&threads[idx]);
+    }
+    yo_assert(state.stale_phase_count == 0);
+    yo_assert(state.last_arrival_count == YO_TEST_BARRIER_PHASE_COUNT);
+
+    test_passed();
+}
+
+yo_internal void test_thread(void) {
+    threads_sleep_until_woken();
+    barrier_separates_phases();
+}
+
+#if !defined(YO_TEST_NO_MAIN)
+int main(void) {
+    test_thread();
+    return 0;
+}
+#endif